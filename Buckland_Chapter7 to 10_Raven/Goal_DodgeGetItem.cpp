@@ -1,5 +1,5 @@
 #include "Goal_DodgeGetItem.h"
-#include "Goals/Goal_SeekToPosition.h"
+#include "goals/Goal_SeekToPosition.h"
 #include "Raven_Bot.h"
 #include "Raven_SteeringBehaviors.h"
 #include "Raven_Game.h"
@@ -7,8 +7,8 @@
 #include "Messaging/Telegram.h"
 #include "Raven_Messages.h"
 
-#include "debug/DebugConsole.h"
-#include "misc/cgdi.H"
+#include "Debug/DebugConsole.h"
+#include "misc/Cgdi.h"
 
 
 //------------------------------- Activate ------------------------------------
@@ -11,7 +11,7 @@
 //
 //-----------------------------------------------------------------------------
 #include "Goals/Goal.h"
-#include "Goals/Raven_Goal_Types.h"
+#include "goals/Raven_Goal_Types.h"
 #include "Raven_Bot.h"
 
 
@@ -1,10 +1,12 @@
 #include "GraveMarkers.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 #include "2D/Transformations.h"
 
 //------------------------------- ctor ----------------------------------------
 //-----------------------------------------------------------------------------
-GraveMarkers::GraveMarkers(double lifetime):m_dLifeTime(lifetime)
+GraveMarkers::GraveMarkers(const SimClock* clock,
+                           double          lifetime):m_pClock(clock),
+                                                     m_dLifeTime(lifetime)
 {
       //create the vertex buffer for the graves
     const int NumripVerts = 9;
@@ -29,7 +31,7 @@ void GraveMarkers::Update()
   GraveList::iterator it = m_GraveList.begin();
   while (it != m_GraveList.end())
   {
-    if (Clock->GetCurrentTime() - it->TimeCreated > m_dLifeTime)
+    if (m_pClock->GetCurrentTime() - it->TimeCreated > m_dLifeTime)
     {
       it = m_GraveList.erase(it);
     }
@@ -63,5 +65,5 @@ void GraveMarkers::Render()
 
 void GraveMarkers::AddGrave(Vector2D pos)
 {
-  m_GraveList.push_back(GraveRecord(pos));
+  m_GraveList.push_back(GraveRecord(pos, m_pClock->GetCurrentTime()));
 }
\ No newline at end of file
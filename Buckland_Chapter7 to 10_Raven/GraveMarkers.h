@@ -12,8 +12,8 @@
 //-----------------------------------------------------------------------------
 #include <list>
 #include <vector>
-#include "2d/vector2d.h"
-#include "time/crudetimer.h"
+#include "2D/Vector2D.h"
+#include "Time/SimClock.h"
 
 class GraveMarkers
 {
@@ -24,8 +24,8 @@ private:
     Vector2D Position;
     double    TimeCreated;
 
-    GraveRecord(Vector2D pos):Position(pos),
-                              TimeCreated(Clock->GetCurrentTime())
+    GraveRecord(Vector2D pos, double time):Position(pos),
+                                           TimeCreated(time)
     {}
   };
 
@@ -35,6 +35,9 @@ private:
 
 private:
 
+  //the game world's clock. Grave lifetimes are measured against it
+  const SimClock*         m_pClock;
+
   //how long a grave remains on screen
   double m_dLifeTime;
 
@@ -46,7 +49,7 @@ private:
 
 public:
 
-  GraveMarkers(double lifetime);
+  GraveMarkers(const SimClock* clock, double lifetime);
 
   void Update();
   void Render();
@@ -6,10 +6,50 @@
 
 NumBots   = 3
 
---this is the maximum number of search cycles allocated to *all* current path
--- planning searches per update
+--this is the maximum number of search cycles (graph nodes expanded) allocated
+-- to *all* current path planning searches per update
 MaxSearchCyclesPerUpdateStep = 1000
 
+--if not zero, the searches are also stopped once they have taken this many
+--microseconds in an update. (the games then no longer play out the same way
+--for a given seed)
+MaxSearchTimePerUpdateStep = 0
+
+--the number of updates a background path request (such as an exploring bot's)
+--may wait before it is served ahead of the other bots' requests
+BackgroundPathDeadline = 30
+
+--the number of worker threads the path manager runs searches to a position
+--on. Their results are passed to the bots at the start of the first update
+--after they finish. Each game starts its own threads, so the headless runner
+--ignores this and runs none. (0 time-slices every search on the game thread)
+PathSearchThreads = 2
+
+--maps with at least this many navgraph nodes are divided into square clusters
+--NavGraphClusterSize units across, and paths between clusters are planned
+--through the cluster entrances first (hierarchical path planning). The paths
+--found this way may be slightly longer than the shortest path
+HierarchicalPathMinNodes = 1000
+NavGraphClusterSize = 100
+
+--the number of recent path search results kept for reuse by all the bots.
+--(0 disables the cache)
+PathCacheSize = 256
+
+--the number of flow fields kept for reuse by all the bots. Bots hunting a
+--target follow the flow field to its last recorded position, which is shared
+--by every bot heading to the same place. A field is built in one go on the
+--game thread the first time its destination is asked for, outside the path
+--search budget and threads above, so it is only worth enabling when many
+--bots hunt the same few targets. (0 disables them and the bots plan a path
+--each)
+FlowFieldCacheSize = 0
+
+--the number of landmark nodes whose costs to every other node are calculated
+--when a map is loaded. A* uses them to estimate the remaining cost of a path
+--far more closely than the straight line distance. (0 disables them)
+NumPathLandmarks = 8
+
 --the name of the default map
 StartMap = "maps/Raven_DM1.map"
 
@@ -17,6 +57,65 @@ StartMap = "maps/Raven_DM1.map"
 NumCellsX = 10
 NumCellsY = 10
 
+--the size of the cells the bots are partitioned into (in pixels). This
+--partition is used for all the bot proximity queries
+BotCellSize = 25
+
+--the size of the cells the walls are partitioned into (in pixels). This
+--partition is used for the line of sight and wall collision tests
+WallCellSize = 40
+
+--the number of threads used to calculate the table of path costs between
+--every pair of graph nodes when a map is loaded (0 uses one per core)
+PathCostThreads = 0
+
+--if true the path cost table is saved alongside the map file and reused
+--on later loads for as long as the navgraph is unchanged
+CachePathCosts = true
+
+--while a door is closed the cost of the navgraph edges through it is
+--multiplied by this (it must be at least 1) so the bots prefer routes through
+--open doors. On maps with doors the bots then plan their paths between
+--positions with an incremental search that is repaired, rather than
+--repeated, as the doors open and close. Those searches always run on the
+--game thread, and the table of path costs between every pair of nodes (used
+--to estimate the cost of reaching items and the like) does not include the
+--extra cost. (1 gives doors no extra cost, as in the original game)
+ClosedDoorCostFactor = 1
+
+--maps with no more than this many navgraph nodes have a compressed table of
+--the next node on the shortest path between every pair of nodes, calculated
+--when the map is loaded. It is not saved with the path costs, so it is
+--rebuilt on every load. Paths between positions are then read from the table
+--rather than searched for. (0 disables the table)
+PathTableMaxNodes = 0
+
+--paths between navgraph nodes at least this far apart are searched for from
+--both ends at once. This only pays on large maps with long winding paths; on
+--the bundled maps it expands more nodes than a plain A* search. (0 disables)
+BidirectionalSearchMinDistance = 0
+
+--when more than one of the path planning options above is enabled, a path
+--to a position is found by the first of these that applies:
+--
+--  1. an incremental search, if ClosedDoorCostFactor is above 1 and the map
+--     has doors (always run on the game thread)
+--  2. an any-angle search, if precise path smoothing is switched on (always
+--     run on the game thread)
+--  3. the path table, if the map has one (see PathTableMaxNodes)
+--  4. the path cache (see PathCacheSize)
+--  5. a hierarchical search, if the map is clustered and the path leaves the
+--     bot's cluster (see HierarchicalPathMinNodes)
+--  6. a bidirectional search (see BidirectionalSearchMinDistance)
+--  7. an A* search, guided by the landmarks if there are any
+--
+--only the last can be run on the path search threads
+
+--how the path cost table is stored: "fixed" (16 bits per cost), "float"
+--(32 bits) or "exact" (64 bits). Only half the table is stored when the
+--navgraph is undirected
+PathCostStorage = "fixed"
+
 --how long the graves remain on screen
 GraveLifetime = 5
 
@@ -47,9 +146,15 @@ Bot_TargetingUpdateFreq = 2
 --the number of times a second the triggers are updated
 Bot_TriggerUpdateFreq = 8
 
---the number of times a second a bot updates its vision
+--the number of times a second a bot updates its vision. Every bot updates
+--its vision at once, so that line of sight need only be found once for each
+--pair of bots
 Bot_VisionUpdateFreq = 4
 
+--the number of threads the line of sight between the bots is found on when
+--they update their vision (0 uses one per core)
+VisionThreads = 1
+
 --note that a frequency of -1 will disable the feature and a frequency of zero
 --will ensure the feature is updated every bot update
 
@@ -119,6 +224,12 @@ Weapon_RespawnDelay  = 15
 -------------------------[[ weapon parameters ]]-------------------------------
 -------------------------------------------------------------------------------
 
+--the weapons' desirability and the bots' aim are interpolated from tables of
+--their fuzzy modules' output with this many samples along each input, rather
+--than inferred. The tables are faster but differ from inference by a few
+--percent. (0 disables the tables)
+FuzzyLookupResolution = 0
+
 Blaster_FiringFreq       = 3
 Blaster_MaxSpeed		 = 5
 Blaster_DefaultRounds    = 0 --not used, a blaster always has ammo
@@ -1,10 +1,10 @@
 #include "Projectile_Knife.h"
 #include "lua/Raven_Scriptor.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 #include "Raven_Bot.h"
 #include "Raven_Game.h"
 #include "constants.h"
-#include "2d/WallIntersectionTests.h"
+#include "2D/WallIntersectionTests.h"
 #include "Raven_Map.h"
 
 #include "Raven_Messages.h"
@@ -76,7 +76,7 @@ void Knife_P::Update()
                                                  m_vPosition,
                                                  dist,
                                                  m_vImpactPoint,
-                                                 m_pWorld->GetMap()->GetWalls()))
+                                                 m_pWorld->GetMap()->GetWallSpace()))
      {
        m_bDead     = true;
        m_bImpacted = true;
@@ -10,7 +10,7 @@
 //  Desc:   class to implement a bolt type projectile
 //
 //-----------------------------------------------------------------------------
-#include "armory\Raven_Projectile.h"
+#include "armory/Raven_Projectile.h"
 
 class Raven_Bot;
 
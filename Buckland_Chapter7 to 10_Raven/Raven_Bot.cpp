@@ -2,13 +2,13 @@
 #include "misc/Cgdi.h"
 #include "misc/utils.h"
 #include "2D/Transformations.h"
-#include "2D/Geometry.h"
+#include "2D/geometry.h"
 #include "lua/Raven_Scriptor.h"
 #include "Raven_Game.h"
 #include "navigation/Raven_PathPlanner.h"
 #include "Raven_SteeringBehaviors.h"
 #include "Raven_UserOptions.h"
-#include "time/Regulator.h"
+#include "Time/Regulator.h"
 #include "Raven_WeaponSystem.h"
 #include "Raven_SensoryMemory.h"
 
@@ -46,6 +46,7 @@ Raven_Bot::Raven_Bot(Raven_Game* world,Vector2D pos):
                  m_iScore(0),
                  m_Status(spawning),
                  m_bPossessed(false),
+                 m_iSlot(-1),
                  m_dFieldOfView(DegsToRads(script->GetDouble("Bot_FOV"))),
 				 m_Equipe(1)
            
@@ -64,11 +65,10 @@ Raven_Bot::Raven_Bot(Raven_Game* world,Vector2D pos):
   m_pSteering = new Raven_Steering(world, this);
 
   //create the regulators
-  m_pWeaponSelectionRegulator = new Regulator(script->GetDouble("Bot_WeaponSelectionFrequency"));
-  m_pGoalArbitrationRegulator =  new Regulator(script->GetDouble("Bot_GoalAppraisalUpdateFreq"));
-  m_pTargetSelectionRegulator = new Regulator(script->GetDouble("Bot_TargetingUpdateFreq"));
-  m_pTriggerTestRegulator = new Regulator(script->GetDouble("Bot_TriggerUpdateFreq"));
-  m_pVisionUpdateRegulator = new Regulator(script->GetDouble("Bot_VisionUpdateFreq"));
+  m_pWeaponSelectionRegulator = new Regulator(world->GetClock(), script->GetDouble("Bot_WeaponSelectionFrequency"));
+  m_pGoalArbitrationRegulator =  new Regulator(world->GetClock(), script->GetDouble("Bot_GoalAppraisalUpdateFreq"));
+  m_pTargetSelectionRegulator = new Regulator(world->GetClock(), script->GetDouble("Bot_TargetingUpdateFreq"));
+  m_pTriggerTestRegulator = new Regulator(world->GetClock(), script->GetDouble("Bot_TriggerUpdateFreq"));
 
   //create the goal queue
   m_pBrain = new Goal_Think(this);
@@ -98,7 +98,6 @@ Raven_Bot::~Raven_Bot()
   delete m_pGoalArbitrationRegulator;
   delete m_pTargetSelectionRegulator;
   delete m_pTriggerTestRegulator;
-  delete m_pVisionUpdateRegulator;
   delete m_pWeaponSys;
   delete m_pSensoryMem;
 }
@@ -112,7 +111,11 @@ void Raven_Bot::Spawn(Vector2D pos)
     SetAlive();
     m_pBrain->RemoveAllSubgoals();
     m_pTargSys->ClearTarget();
+
+    Vector2D OldPos = Pos();
     SetPos(pos);
+    m_pWorld->GetBotSpace()->UpdateEntity(this, OldPos);
+
     m_pWeaponSys->Initialize();
     RestoreHealthToMaximum();
 }
@@ -127,8 +130,13 @@ void Raven_Bot::Update()
   m_pBrain->Process();
   
   //Calculate the steering force and update the bot's velocity and position
+  Vector2D OldPos = Pos();
+
   UpdateMovement();
 
+  //keep the world's partition of the bots up to date
+  m_pWorld->GetBotSpace()->UpdateEntity(this, OldPos);
+
   //if the bot is under AI control but not scripted
   if (!isPossessed())
   {           
@@ -145,12 +153,6 @@ void Raven_Bot::Update()
        m_pBrain->Arbitrate(); 
     }
 
-    //update the sensory memory with any visual stimulus
-    if (m_pVisionUpdateRegulator->isReady())
-    {
-      m_pSensoryMem->UpdateVision();
-    }
-  
     //select the appropriate weapon to use from the weapons currently in
     //the inventory
     if (m_pWeaponSelectionRegulator->isReady())
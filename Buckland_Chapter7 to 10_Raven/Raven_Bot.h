@@ -13,7 +13,7 @@
 #include <iosfwd>
 #include <map>
 
-#include "game/MovingEntity.h"
+#include "Game/MovingEntity.h"
 #include "misc/utils.h"
 #include "Raven_TargetingSystem.h"
 
@@ -72,7 +72,6 @@ private:
   Regulator*                         m_pGoalArbitrationRegulator;
   Regulator*                         m_pTargetSelectionRegulator;
   Regulator*                         m_pTriggerTestRegulator;
-  Regulator*                         m_pVisionUpdateRegulator;
 
   //the bot's health. Every time the bot is shot this value is decreased. If
   //it reaches zero then the bot dies (and respawns)
@@ -105,6 +104,11 @@ private:
   //set to true when a human player takes over control of the bot
   bool                               m_bPossessed;
 
+  //each of the game's bots is given a different slot when it is added. The
+  //slots run from zero, and a removed bot's slot is given to the next bot
+  //added, so they can be used to index flat arrays of per-bot data
+  int                                m_iSlot;
+
   //a vertex buffer containing the bot's geometry
   std::vector<Vector2D>              m_vecBotVB;
   //the buffer for the transformed vertices
@@ -214,6 +218,9 @@ public:
   Raven_WeaponSystem* const          GetWeaponSys()const{return m_pWeaponSys;}
   Raven_SensoryMemory* const         GetSensoryMem()const{return m_pSensoryMem;}
 
+  int           Slot()const{return m_iSlot;}
+  void          SetSlot(int slot){m_iSlot = slot;}
+
   int GetEquipe(){return m_Equipe;}
   void SetEquipe(int equipe){m_Equipe = equipe;}
 
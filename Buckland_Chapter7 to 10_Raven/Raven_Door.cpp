@@ -1,10 +1,10 @@
 #include "Raven_Door.h"
-#include "Messaging/telegram.h"
+#include "Messaging/Telegram.h"
 #include "misc/Stream_Utility_Functions.h"
 #include <algorithm>
 #include "Raven_Messages.h"
 #include "Raven_Map.h"
-#include "2d/wall2d.h"
+#include "2D/Wall2D.h"
 
 //---------------------------- ctor -------------------------------------------
 //-----------------------------------------------------------------------------
@@ -13,6 +13,7 @@ Raven_Door::Raven_Door(Raven_Map* pMap,
 
                                   BaseGameEntity(GetValueFromStream<int>(is)),
                                   m_Status(closed),
+                                  m_pMap(pMap),
                                   m_iNumTicksStayOpen(60)                   //MGC!
 {
   Read(is);
@@ -83,6 +84,8 @@ void Raven_Door::Open()
 
       m_iNumTicksCurrentlyOpen = m_iNumTicksStayOpen;
 
+      m_pMap->DoorStateChanged(ID(), true);
+
       return;
       
     }
@@ -106,6 +109,9 @@ void Raven_Door::Close()
     if (m_dCurrentSize == m_dSize)
     {
       m_Status = closed;
+
+      m_pMap->DoorStateChanged(ID(), false);
+
       return;
       
     }
@@ -13,8 +13,8 @@
 //-----------------------------------------------------------------------------
 #include <vector>
 #include <iosfwd>
-#include "2d/vector2d.h"
-#include "game/BaseGameEntity.h"
+#include "2D/Vector2D.h"
+#include "Game/BaseGameEntity.h"
 
 
 
@@ -33,6 +33,10 @@ protected:
 
   door_status                m_Status;
 
+  //the map the door is part of. It is told whenever the door finishes
+  //opening or closing
+  Raven_Map*                 m_pMap;
+
   //a sliding door is created from two walls, back to back.These walls must
   //be added to a map's geometry in order for an agent to detect them
   Wall2D*                    m_pWall1;
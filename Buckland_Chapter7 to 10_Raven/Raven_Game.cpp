@@ -1,21 +1,25 @@
 #include "Raven_Game.h"
 #include "Raven_ObjectEnumerations.h"
+#include "constants.h"
 #include "misc/WindowUtils.h"
 #include "misc/Cgdi.h"
 #include "Raven_SteeringBehaviors.h"
 #include "lua/Raven_Scriptor.h"
 #include "navigation/Raven_PathPlanner.h"
-#include "game/EntityManager.h"
-#include "2d/WallIntersectionTests.h"
+#include "Game/EntityManager.h"
+#include "2D/WallIntersectionTests.h"
 #include "Raven_Map.h"
 #include "Raven_Door.h"
 #include "Raven_UserOptions.h"
 #include "Time/PrecisionTimer.h"
 #include "Raven_SensoryMemory.h"
 #include "Raven_WeaponSystem.h"
-#include "messaging/MessageDispatcher.h"
+#include "Messaging/MessageDispatcher.h"
 #include "Raven_Messages.h"
 #include "GraveMarkers.h"
+#include "Raven_WorldContext.h"
+#include "Raven_Visibility.h"
+#include "Time/Regulator.h"
 
 #include "armory/Raven_Projectile.h"
 #include "armory/Projectile_Rocket.h"
@@ -32,18 +36,36 @@
 
 //uncomment to write object creation/deletion to debug console
 #define  LOG_CREATIONAL_STUFF
-#include "debug/DebugConsole.h"
+#include "Debug/DebugConsole.h"
 
 
 //----------------------------- ctor ------------------------------------------
 //-----------------------------------------------------------------------------
-Raven_Game::Raven_Game():m_pSelectedBot(NULL),
-                         m_bPaused(false),
-                         m_bRemoveABot(false),
-                         m_pMap(NULL),
-                         m_pPathManager(NULL),
-                         m_pGraveMarkers(NULL)
+Raven_Game::Raven_Game(int NumPathSearchThreads):m_pContext(new Raven_WorldContext()),
+                                                 m_pClock(new SimClock(1.0/FrameRate)),
+                                                 m_pSelectedBot(NULL),
+                                                 m_iNumBotSlots(0),
+                                                 m_bPaused(false),
+                                                 m_bRemoveABot(false),
+                                                 m_pMap(NULL),
+                                                 m_pPathManager(NULL),
+                                                 m_iNumPathSearchThreads(NumPathSearchThreads),
+                                                 m_pBotSpace(NULL),
+                                                 m_pVisibility(NULL),
+                                                 m_pVisionUpdateRegulator(NULL),
+                                                 m_pGraveMarkers(NULL)
 {
+  Raven_WorldContext::Scope context(m_pContext);
+
+  if (m_iNumPathSearchThreads < 0)
+  {
+    m_iNumPathSearchThreads = script->GetInt("PathSearchThreads");
+  }
+
+  m_pVisibility = new Raven_Visibility(this, script->GetInt("VisionThreads"));
+
+  m_pVisionUpdateRegulator = new Regulator(m_pClock, script->GetDouble("Bot_VisionUpdateFreq"));
+
   //load in the default map
   LoadMap(script->GetString("StartMap"));
 }
@@ -53,11 +75,23 @@ Raven_Game::Raven_Game():m_pSelectedBot(NULL),
 //-----------------------------------------------------------------------------
 Raven_Game::~Raven_Game()
 {
-  Clear();
-  delete m_pPathManager;
-  delete m_pMap;
+  {
+    Raven_WorldContext::Scope context(m_pContext);
+
+    Clear();
+    delete m_pPathManager;
+    delete m_pMap;
   
-  delete m_pGraveMarkers;
+    delete m_pGraveMarkers;
+    delete m_pBotSpace;
+
+    delete m_pVisibility;
+    delete m_pVisionUpdateRegulator;
+
+    delete m_pClock;
+  }
+
+  delete m_pContext;
 }
 
 
@@ -98,6 +132,13 @@ void Raven_Game::Clear()
   m_Projectiles.clear();
   m_Bots.clear();
 
+  m_iNumBotSlots = 0;
+  m_FreeBotSlots.clear();
+
+  if (m_pBotSpace) m_pBotSpace->EmptyCells();
+
+  if (m_pVisibility) m_pVisibility->Clear();
+
   m_pSelectedBot = NULL;
 
 
@@ -109,9 +150,14 @@ void Raven_Game::Clear()
 //-----------------------------------------------------------------------------
 void Raven_Game::Update()
 { 
+  Raven_WorldContext::Scope context(m_pContext);
+
   //don't update if the user has paused the game
   if (m_bPaused) return;
 
+  //advance the game clock by one time step
+  m_pClock->Tick();
+
   m_pGraveMarkers->Update();
 
   //get any player keyboard input
@@ -177,8 +223,23 @@ void Raven_Game::Update()
     }  
   } 
 
+  //update the sensory memory of each bot under AI control with any visual
+  //stimulus. The line of sight between each pair of bots is found first
+  if (m_pVisionUpdateRegulator->isReady())
+  {
+    m_pVisibility->Update();
+
+    for (curBot = m_Bots.begin(); curBot != m_Bots.end(); ++curBot)
+    {
+      if ((*curBot)->isAlive() && !(*curBot)->isPossessed())
+      {
+        (*curBot)->GetSensoryMem()->UpdateVision();
+      }
+    }
+  }
+
   //update the triggers
-  m_pMap->UpdateTriggerSystem(m_Bots);
+  m_pMap->UpdateTriggerSystem(m_Bots, *m_pBotSpace);
 
   //if the user has requested that the number of bots be decreased, remove
   //one
@@ -189,6 +250,9 @@ void Raven_Game::Update()
       Raven_Bot* pBot = m_Bots.back();
       if (pBot == m_pSelectedBot)m_pSelectedBot=0;
       NotifyAllBotsOfRemoval(pBot);
+      m_pBotSpace->RemoveEntity(pBot);
+      m_pVisibility->Clear();
+      m_FreeBotSlots.push_back(pBot->Slot());
       delete m_Bots.back();
       m_Bots.remove(pBot);
       pBot = 0;
@@ -206,7 +270,10 @@ bool Raven_Game::AttemptToAddBot(Raven_Bot* pBot)
   //make sure there are some spawn points available
   if (m_pMap->GetSpawnPoints().size() <= 0)
   {
-    ErrorBox("Map has no spawn points!"); return false;
+#ifndef RAVEN_HEADLESS
+    ErrorBox("Map has no spawn points!");
+#endif
+    return false;
   }
 
   //we'll make the same number of attempts to spawn a bot this update as
@@ -219,20 +286,12 @@ bool Raven_Game::AttemptToAddBot(Raven_Bot* pBot)
     Vector2D pos = m_pMap->GetRandomSpawnPoint();
 
     //check to see if it's occupied
-    std::list<Raven_Bot*>::const_iterator curBot = m_Bots.begin();
-
-    bool bAvailable = true;
+    std::vector<Raven_Bot*> occupants;
 
-    for (curBot; curBot != m_Bots.end(); ++curBot)
-    {
-      //if the spawn point is unoccupied spawn a bot
-      if (Vec2DDistance(pos, (*curBot)->Pos()) < (*curBot)->BRadius())
-      {
-        bAvailable = false;
-      }
-    }
+    m_pBotSpace->QueryRadius(pos, 0, occupants);
 
-    if (bAvailable)
+    //if the spawn point is unoccupied spawn a bot
+    if (occupants.empty())
     {  
       pBot->Spawn(pos);
 
@@ -249,6 +308,8 @@ bool Raven_Game::AttemptToAddBot(Raven_Bot* pBot)
 //-----------------------------------------------------------------------------
 void Raven_Game::AddBots(unsigned int NumBotsToAdd, int equipe)
 { 
+  Raven_WorldContext::Scope context(m_pContext);
+
   while (NumBotsToAdd--)
   {
     //create a bot. (its position is irrelevant at this point because it will
@@ -264,8 +325,22 @@ void Raven_Game::AddBots(unsigned int NumBotsToAdd, int equipe)
     rb->GetSteering()->WallAvoidanceOn();
     rb->GetSteering()->SeparationOn();
 
+    //give the bot a slot, reusing that of a removed bot if possible
+    if (m_FreeBotSlots.empty())
+    {
+      rb->SetSlot(m_iNumBotSlots++);
+    }
+    else
+    {
+      rb->SetSlot(m_FreeBotSlots.back());
+
+      m_FreeBotSlots.pop_back();
+    }
+
     m_Bots.push_back(rb);
 
+    m_pBotSpace->AddEntity(rb);
+
     //register the bot with the entity manager
     EntityMgr->RegisterEntity(rb);
 
@@ -375,16 +450,17 @@ void Raven_Game::AddShotGunPellet(Raven_Bot* shooter, Vector2D target)
 //-----------------------------------------------------------------------------
 Raven_Bot* Raven_Game::GetBotAtPosition(Vector2D CursorPos)const
 {
-  std::list<Raven_Bot*>::const_iterator curBot = m_Bots.begin();
+  std::vector<Raven_Bot*> BotsAtPos;
 
-  for (curBot; curBot != m_Bots.end(); ++curBot)
+  m_pBotSpace->QueryRadius(CursorPos, 0, BotsAtPos);
+
+  std::vector<Raven_Bot*>::const_iterator curBot = BotsAtPos.begin();
+
+  for (curBot; curBot != BotsAtPos.end(); ++curBot)
   {
-    if (Vec2DDistance((*curBot)->Pos(), CursorPos) < (*curBot)->BRadius())
+    if ((*curBot)->isAlive())
     {
-      if ((*curBot)->isAlive())
-      {
-        return *curBot;
-      }
+      return *curBot;
     }
   }
 
@@ -397,6 +473,8 @@ Raven_Bot* Raven_Game::GetBotAtPosition(Vector2D CursorPos)const
 //-----------------------------------------------------------------------------
 bool Raven_Game::LoadMap(const std::string& filename)
 {  
+  Raven_WorldContext::Scope context(m_pContext);
+
   //clear any current bots and projectiles
   Clear();
   
@@ -404,25 +482,42 @@ bool Raven_Game::LoadMap(const std::string& filename)
   delete m_pMap;
   delete m_pGraveMarkers;
   delete m_pPathManager;
+  delete m_pBotSpace;
+  m_pBotSpace = NULL;
 
   //in with the new
-  m_pGraveMarkers = new GraveMarkers(script->GetDouble("GraveLifetime"));
-  m_pPathManager = new PathManager<Raven_PathPlanner>(script->GetInt("MaxSearchCyclesPerUpdateStep"));
-  m_pMap = new Raven_Map();
+  m_pGraveMarkers = new GraveMarkers(m_pClock, script->GetDouble("GraveLifetime"));
+  m_pPathManager = new PathManager<Raven_PathPlanner>(script->GetInt("MaxSearchCyclesPerUpdateStep"),
+                                                      script->GetDouble("MaxSearchTimePerUpdateStep"),
+                                                      m_iNumPathSearchThreads);
+  m_pMap = new Raven_Map(m_pClock);
 
   //make sure the entity manager is reset
   EntityMgr->Reset();
 
 
   //load the new map data
-  if (m_pMap->LoadMap(filename))
-  { 
-    AddBots(script->GetInt("NumBots"), 1);
-  
-    return true;
-  }
+  const bool bLoaded = m_pMap->LoadMap(filename);
 
-  return false;
+  //partition the map's area for the bots. (only the Query methods are used
+  //so no neighbor buffer is required). The partition is made even if the
+  //map could not be loaded (a single cell then) so the bot space is never
+  //NULL once the game is constructed
+  const double CellSize = script->GetDouble("BotCellSize");
+  const double SizeX    = MaxOf(1.0, (double)m_pMap->GetSizeX());
+  const double SizeY    = MaxOf(1.0, (double)m_pMap->GetSizeY());
+
+  m_pBotSpace = new BotSpace(SizeX,
+                             SizeY,
+                             MaxOf(1, (int)ceil(SizeX / CellSize)),
+                             MaxOf(1, (int)ceil(SizeY / CellSize)),
+                             0);
+
+  if (!bLoaded) return false;
+
+  AddBots(script->GetInt("NumBots"), 1);
+
+  return true;
 }
 
 
@@ -432,6 +527,8 @@ bool Raven_Game::LoadMap(const std::string& filename)
 //-----------------------------------------------------------------------------
 void Raven_Game::ExorciseAnyPossessedBot()
 {
+  Raven_WorldContext::Scope context(m_pContext);
+
   if (m_pSelectedBot) m_pSelectedBot->Exorcise();
 }
 
@@ -448,6 +545,8 @@ void Raven_Game::ExorciseAnyPossessedBot()
 //-----------------------------------------------------------------------------
 void Raven_Game::ClickRightMouseButton(POINTS p)
 {
+  Raven_WorldContext::Scope context(m_pContext);
+
   Raven_Bot* pBot = GetBotAtPosition(POINTStoVector(p));
 
   //if there is no selected bot just return;
@@ -497,6 +596,8 @@ void Raven_Game::ClickRightMouseButton(POINTS p)
 //-----------------------------------------------------------------------------
 void Raven_Game::ClickLeftMouseButton(POINTS p)
 {
+  Raven_WorldContext::Scope context(m_pContext);
+
   if (m_pSelectedBot && m_pSelectedBot->isPossessed())
   {
     m_pSelectedBot->FireWeapon(POINTStoVector(p));
@@ -510,10 +611,12 @@ void Raven_Game::ClickLeftMouseButton(POINTS p)
 //-----------------------------------------------------------------------------
 void Raven_Game::GetPlayerInput()const
 {
+#ifndef RAVEN_HEADLESS
   if (m_pSelectedBot && m_pSelectedBot->isPossessed())
   {
       m_pSelectedBot->RotateFacingTowardPosition(GetClientCursorPosition());
    }
+#endif
 }
 
 
@@ -523,6 +626,8 @@ void Raven_Game::GetPlayerInput()const
 //-----------------------------------------------------------------------------
 void Raven_Game::ChangeWeaponOfPossessedBot(unsigned int weapon)const
 {
+  Raven_WorldContext::Scope context(m_pContext);
+
   //ensure one of the bots has been possessed
   if (m_pSelectedBot)
   {
@@ -554,37 +659,38 @@ void Raven_Game::ChangeWeaponOfPossessedBot(unsigned int weapon)const
 //------------------------------------------------------------------------------
 bool Raven_Game::isLOSOkay(Vector2D A, Vector2D B)const
 {
-  return !doWallsObstructLineSegment(A, B, m_pMap->GetWalls());
+  return !doWallsObstructLineSegment(A, B, m_pMap->GetWallSpace());
 }
 
 //------------------------- isPathObstructed ----------------------------------
 //
 //  returns true if a bot cannot move from A to B without bumping into 
-//  world geometry. It achieves this by stepping from A to B in steps of
-//  size BoundingRadius and testing for intersection with world geometry at
-//  each point.
+//  world geometry. It achieves this by testing the area swept by a circle
+//  of radius BoundingRadius moving from A to B for intersection with world
+//  geometry. As with the original stepped test, the first half radius of the
+//  way and the last radius before B are left out, so that a bot brushing
+//  against a wall can still move away from it, as can a bot heading for a
+//  position close to one.
 //-----------------------------------------------------------------------------
 bool Raven_Game::isPathObstructed(Vector2D A,
                                   Vector2D B,
                                   double    BoundingRadius)const
 {
-  Vector2D ToB = Vec2DNormalize(B-A);
-
-  Vector2D curPos = A;
+  double dist = Vec2DDistance(A, B);
 
-  while (Vec2DDistanceSq(curPos, B) > BoundingRadius*BoundingRadius)
-  {   
-    //advance curPos one step
-    curPos += ToB * 0.5 * BoundingRadius;
-    
-    //test all walls against the new position
-    if (doWallsIntersectCircle(m_pMap->GetWalls(), curPos, BoundingRadius))
-    {
-      return true;
-    }
+  if (dist <= BoundingRadius)
+  {
+    return false;
   }
 
-  return false;
+  Vector2D ToB = (B-A) / dist;
+
+  //the circle is always tested at least half a radius from A, even if that
+  //is within a radius of B
+  return doWallsIntersectSweptCircle(m_pMap->GetWallSpace(),
+                                     A + ToB * 0.5 * BoundingRadius,
+                                     A + ToB * MaxOf(0.5 * BoundingRadius, dist - BoundingRadius),
+                                     BoundingRadius);
 }
 
 
@@ -597,27 +703,25 @@ Raven_Game::GetAllBotsInFOV(const Raven_Bot* pBot)const
 {
   std::vector<Raven_Bot*> VisibleBots;
 
-  std::list<Raven_Bot*>::const_iterator curBot = m_Bots.begin();
-  for (curBot; curBot != m_Bots.end(); ++curBot)
+  //first of all find the bots within the FOV
+  std::vector<Raven_Bot*> BotsInFOV;
+
+  m_pBotSpace->QueryCone(pBot->Pos(),
+                         pBot->Facing(),
+                         pBot->FieldOfView(),
+                         BotsInFOV);
+
+  std::vector<Raven_Bot*>::const_iterator curBot = BotsInFOV.begin();
+  for (curBot; curBot != BotsInFOV.end(); ++curBot)
   {
     //make sure time is not wasted checking against the same bot or against a
     // bot that is dead or re-spawning
     if (*curBot == pBot ||  !(*curBot)->isAlive()) continue;
 
-    //first of all test to see if this bot is within the FOV
-    if (isSecondInFOVOfFirst(pBot->Pos(),
-                             pBot->Facing(),
-                             (*curBot)->Pos(),
-                             pBot->FieldOfView()))
+    //if there is line of sight between the bots add it to the vector
+    if (m_pVisibility->isLOSOkay(pBot, *curBot))
     {
-      //cast a ray from between the bots to test visibility. If the bot is
-      //visible add it to the vector
-      if (!doWallsObstructLineSegment(pBot->Pos(),
-                              (*curBot)->Pos(),
-                              m_pMap->GetWalls()))
-      {
-        VisibleBots.push_back(*curBot);
-      }
+      VisibleBots.push_back(*curBot);
     }
   }
 
@@ -639,11 +743,8 @@ Raven_Game::isSecondVisibleToFirst(const Raven_Bot* pFirst,
                              pSecond->Pos(),
                              pFirst->FieldOfView()))
     {
-      //test the line segment connecting the bot's positions against the walls.
-      //If the bot is visible add it to the vector
-      if (!doWallsObstructLineSegment(pFirst->Pos(),
-                                      pSecond->Pos(),
-                                      m_pMap->GetWalls()))
+      //then test for line of sight between the bots
+      if (m_pVisibility->isLOSOkay(pFirst, pSecond))
       {
         return true;
       }
@@ -707,6 +808,8 @@ Raven_Game::GetPosOfClosestSwitch(Vector2D botPos, unsigned int doorID)const
 //-----------------------------------------------------------------------------
 void Raven_Game::Render()
 {
+  Raven_WorldContext::Scope context(m_pContext);
+
   m_pGraveMarkers->Render();
   
   //render the map
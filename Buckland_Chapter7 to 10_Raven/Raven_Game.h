@@ -18,32 +18,69 @@
 #include <string>
 #include <list>
 
-#include "graph/SparseGraph.h"
+#include "Graph/SparseGraph.h"
 #include "Raven_ObjectEnumerations.h"
-#include "2d/Wall2D.h"
+#include "2D/Wall2D.h"
 #include "misc/utils.h"
-#include "game/EntityFunctionTemplates.h"
+#include "Game/EntityFunctionTemplates.h"
 #include "Raven_Bot.h"
-#include "navigation/pathmanager.h"
+#include "navigation/PathManager.h"
+#include "misc/CellSpacePartition.h"
+#include "Time/SimClock.h"
 
 
 class BaseGameEntity;
 class Raven_Projectile;
 class Raven_Map;
 class GraveMarkers;
+class Raven_WorldContext;
+class Raven_Visibility;
+class Regulator;
 
 
 
 class Raven_Game
 {
+public:
+
+  typedef CellSpacePartition<Raven_Bot*>  BotSpace;
+
 private:
 
+  //the objects that would otherwise be shared by every game in the process
+  //(entity manager, message dispatcher, scriptor, user options etc). The
+  //public methods below make this context current while they run so that
+  //any number of games can coexist, each on its own thread if required.
+  Raven_WorldContext*              m_pContext;
+
+  //the game world's clock. It is advanced by one fixed time step each
+  //update so everything timed against it (regulators, weapon fire rates,
+  //memory, respawning items) runs in simulated rather than real time
+  SimClock*                        m_pClock;
+
   //the current game map
   Raven_Map*                       m_pMap;
  
   //a list of all the bots that are inhabiting the map
   std::list<Raven_Bot*>            m_Bots;
 
+  //the number of bot slots handed out (see Raven_Bot::Slot) and the slots
+  //of the bots that have been removed, which are handed out again first
+  int                              m_iNumBotSlots;
+  std::vector<int>                 m_FreeBotSlots;
+
+  //the bots (alive or otherwise) are partitioned so that proximity queries
+  //only need to examine the bots in nearby cells. Each bot updates its
+  //entry whenever it moves
+  BotSpace*                        m_pBotSpace;
+
+  //the line of sight between each pair of bots, found once per vision
+  //update for all the bots
+  Raven_Visibility*                m_pVisibility;
+
+  //the bots all update their vision when this is ready
+  Regulator*                       m_pVisionUpdateRegulator;
+
   //the user may select a bot to control manually. This is a pointer to that
   //bot
   Raven_Bot*                       m_pSelectedBot;
@@ -55,6 +92,9 @@ private:
   //this class manages all the path planning requests
   PathManager<Raven_PathPlanner>*  m_pPathManager;
 
+  //the number of worker threads each map's path manager is created with
+  int                              m_iNumPathSearchThreads;
+
 
   //if true the game will be paused
   bool                             m_bPaused;
@@ -83,7 +123,9 @@ private:
   
 public:
   
-  Raven_Game();
+  //if NumPathSearchThreads is not negative it is used in place of
+  //PathSearchThreads from Params.lua
+  Raven_Game(int NumPathSearchThreads = -1);
   ~Raven_Game();
 
   //the usual suspects
@@ -107,11 +149,12 @@ public:
   //without bumping into world geometry
   bool isPathObstructed(Vector2D A, Vector2D B, double BoundingRadius = 0)const;
 
-  //returns a vector of pointers to bots in the FOV of the given bot
+  //returns a vector of pointers to bots in the FOV of the given bot. (the
+  //line of sight is as of the last vision update)
   std::vector<Raven_Bot*> GetAllBotsInFOV(const Raven_Bot* pBot)const;
 
   //returns true if the second bot is unobstructed by walls and in the field
-  //of view of the first.
+  //of view of the first. (the line of sight is as of the last vision update)
   bool        isSecondVisibleToFirst(const Raven_Bot* pFirst,
                                      const Raven_Bot* pSecond)const;
 
@@ -160,10 +203,13 @@ public:
   const std::list<Raven_Bot*>&             GetAllBots()const{return m_Bots;}
   PathManager<Raven_PathPlanner>* const    GetPathManager(){return m_pPathManager;}
   int                                      GetNumBots()const{return m_Bots.size();}
+  int                                      GetNumBotSlots()const{return m_iNumBotSlots;}
+  const Raven_Visibility* const            GetVisibility()const{return m_pVisibility;}
+  BotSpace* const                          GetBotSpace(){return m_pBotSpace;}
+  const BotSpace* const                    GetBotSpace()const{return m_pBotSpace;}
+  const SimClock* const                    GetClock()const{return m_pClock;}
+  Raven_WorldContext* const                GetContext()const{return m_pContext;}
 
-  
-  void  TagRaven_BotsWithinViewRange(BaseGameEntity* pRaven_Bot, double range)
-              {TagNeighbors(pRaven_Bot, m_Bots, range);}  
 };
 
 
@@ -0,0 +1,356 @@
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   Raven_Headless.cpp
+//
+//  Desc:   console entry point for running Raven without a window. The game
+//          is stepped in a tight loop with a fixed time step (one step per
+//          1/FrameRate of game time) and nothing is rendered, so matches run
+//          as fast as the CPU allows. When the run completes the number of
+//          ticks per second achieved is reported.
+//
+//          Several independent matches can be run at once. Each match is a
+//          separate Raven_Game with its own world context so matches can be
+//          updated on as many threads as there are cores. The matches'
+//          path searches are all time-sliced on the thread updating the
+//          match (PathSearchThreads in Params.lua is ignored) so the matches
+//          do not each start threads of their own and a match plays out the
+//          same way for a given seed.
+//
+//          usage: RavenHeadless [map file] [-ticks n] [-bots n] [-seed n]
+//                               [-matches n] [-threads n] [-pathstats]
+//
+//          -pathstats prints how long each match's path requests took to be
+//          answered, by priority, and how often the path cache was used when
+//          the match ends.
+//
+//          if the fuzzy rule bases are baked into lookup tables
+//          (FuzzyLookupResolution in Params.lua) the largest error of each
+//          table is printed when a match ends.
+//
+//          if no map file is given the StartMap from Params.lua is used.
+//          Params.lua is read from the working directory, exactly as in the
+//          windowed build.
+//
+//          The runner is built by RavenHeadless.vcxproj on Windows and by
+//          CMakeLists.txt elsewhere (Lua 5.1 is needed). Off Windows the
+//          Win32 calls the shared sources make are stood in for by
+//          misc/Win32Compat.h: the timers use std::chrono and the GDI
+//          calls of the Render methods do nothing.
+//-----------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+#include <stdexcept>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+#include "constants.h"
+#include "misc/utils.h"
+#include "Time/PrecisionTimer.h"
+#include "Raven_Game.h"
+#include "Raven_WorldContext.h"
+#include "Raven_ObjectEnumerations.h"
+#include "armory/Raven_FuzzyRuleBases.h"
+#include "lua/Raven_Scriptor.h"
+#include "navigation/Raven_PathPlanner.h"
+#include "navigation/PathPriority.h"
+#include "navigation/PathRequestStats.h"
+
+
+//the number of update-steps simulated if none is specified on the command line
+const long DefaultNumTicks = FrameRate * 60 * 10;
+
+
+//the settings shared by every match in a run
+struct MatchSettings
+{
+  std::string  MapName;
+  long         NumTicks;
+  int          ExtraBots;
+  bool         bPathStats;
+};
+
+
+//--------------------------- PrintUsage --------------------------------------
+//-----------------------------------------------------------------------------
+static void PrintUsage()
+{
+  std::cout << "usage: RavenHeadless [map file] [-ticks n] [-bots n] [-seed n]\n"
+            << "                     [-matches n] [-threads n] [-pathstats]\n"
+            << "  -ticks n   number of update-steps to simulate (default "
+            << DefaultNumTicks << ")\n"
+            << "  -bots n    number of bots to add on top of NumBots in Params.lua\n"
+            << "  -seed n    seed for the random number generator\n"
+            << "  -matches n number of independent matches to run (default 1)\n"
+            << "  -threads n number of matches updated at once (default: one\n"
+            << "             per hardware thread)\n"
+            << "  -pathstats print the path request latencies of each match\n";
+}
+
+
+//--------------------------- PrintPathStats ----------------------------------
+//-----------------------------------------------------------------------------
+static void PrintPathStats(Raven_Game* pRaven, unsigned int seed)
+{
+  PathManager<Raven_PathPlanner>* pPathManager = pRaven->GetPathManager();
+
+  static const char* PriorityNames[num_path_priorities] =
+  {
+    "player", "combat", "normal", "background"
+  };
+
+  std::cout << "path requests, seed " << seed << "\n"
+            << "  priority      count  avg upd  max upd   avg us   p95 us   p99 us   max us  missed\n";
+
+  for (int p=0; p<num_path_priorities; ++p)
+  {
+    const PathRequestStats& stats = pPathManager->GetStats(p);
+
+    std::cout << "  " << std::left  << std::setw(10) << PriorityNames[p] << std::right
+              << std::setw(9) << stats.NumRequests()
+              << std::fixed   << std::setprecision(1)
+              << std::setw(9) << stats.AverageUpdates()
+              << std::setw(9) << stats.MaxUpdates()
+              << std::setw(9) << stats.AverageMicroseconds()
+              << std::setw(9) << stats.RecentPercentileMicroseconds(0.95)
+              << std::setw(9) << stats.RecentPercentileMicroseconds(0.99)
+              << std::setw(9) << stats.MaxMicroseconds()
+              << std::setw(8) << stats.NumMissedDeadlines() << "\n";
+  }
+
+  const Raven_Map::SearchPathCache& cache = pRaven->GetMap()->GetPathCache();
+
+  std::cout << "  path cache: " << cache.NumHits() << " hits, "
+            << cache.NumMisses() << " misses\n";
+
+  const Raven_Map::SearchFlowFields& fields = pRaven->GetMap()->GetFlowFields();
+
+  std::cout << "  flow fields: " << fields.NumHits() << " hits, "
+            << fields.NumBuilt() << " built\n";
+
+  std::cout.unsetf(std::ios::fixed);
+  std::cout << std::setprecision(6) << std::flush;
+}
+
+
+//------------------------ PrintFuzzyTableErrors ------------------------------
+//
+//  prints the largest difference between each baked fuzzy lookup table and
+//  the inference it stands in for. Nothing is printed if no table was baked
+//-----------------------------------------------------------------------------
+static void PrintFuzzyTableErrors(Raven_Game* pRaven, unsigned int seed)
+{
+  const Raven_FuzzyRuleBases* pRules = pRaven->GetContext()->GetFuzzyRuleBases();
+
+  static const int WeaponTypes[] =
+  {
+    type_blaster, type_shotgun, type_rail_gun, type_rocket_launcher, type_knife
+  };
+
+  std::ostringstream errors;
+
+  for (unsigned int w=0; w<sizeof(WeaponTypes)/sizeof(WeaponTypes[0]); ++w)
+  {
+    const Raven_FuzzyRuleBases::WeaponRules* rules = pRules->GetWeaponRules(WeaponTypes[w]);
+
+    if (rules && rules->table.isBaked())
+    {
+      errors << "  " << std::left << std::setw(16) << GetNameOfType(WeaponTypes[w])
+             << std::right << rules->table.GetMaxError() << "\n";
+    }
+  }
+
+  const Raven_FuzzyRuleBases::AimRules* aim = pRules->GetAimRules();
+
+  if (aim && aim->table.isBaked())
+  {
+    errors << "  " << std::left << std::setw(16) << "aim deviation"
+           << std::right << aim->table.GetMaxError() << "\n";
+  }
+
+  if (errors.str().empty()) return;
+
+  std::cout << "fuzzy lookup table max error, seed " << seed << "\n"
+            << errors.str() << std::flush;
+}
+
+
+//----------------------------- RunMatch --------------------------------------
+//
+//  creates a game, simulates it for the requested number of ticks and then
+//  deletes it. Returns false if the match could not be set up.
+//
+//  The random number generator is seeded here because each thread has its
+//  own generator state; a match therefore plays out the same way for a
+//  given seed whichever thread runs it.
+//
+//  OutputLock is held while the match's statistics are printed
+//-----------------------------------------------------------------------------
+static bool RunMatch(const MatchSettings& settings,
+                     unsigned int         seed,
+                     std::mutex&          OutputLock)
+{
+  srand(seed);
+
+  //the game loads the default map on construction. It is given no path
+  //search threads (see above)
+  Raven_Game* pRaven = new Raven_Game(0);
+
+  if (!settings.MapName.empty() && !pRaven->LoadMap(settings.MapName))
+  {
+    delete pRaven; return false;
+  }
+
+  pRaven->AddBots(settings.ExtraBots, 1);
+
+  for (long tick=0; tick<settings.NumTicks; ++tick)
+  {
+    pRaven->Update();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(OutputLock);
+
+    if (settings.bPathStats) PrintPathStats(pRaven, seed);
+
+    PrintFuzzyTableErrors(pRaven, seed);
+  }
+
+  delete pRaven;
+
+  return true;
+}
+
+
+//-------------------------------- main ---------------------------------------
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  MatchSettings settings;
+  settings.NumTicks   = DefaultNumTicks;
+  settings.ExtraBots  = 0;
+  settings.bPathStats = false;
+
+  unsigned int Seed       = (unsigned int)time(NULL);
+  int          NumMatches = 1;
+  int          NumThreads = (int)std::thread::hardware_concurrency();
+
+  //parse the command line
+  for (int arg=1; arg<argc; ++arg)
+  {
+    std::string opt = argv[arg];
+
+    if (opt == "-ticks" && arg+1 < argc)
+    {
+      settings.NumTicks = atol(argv[++arg]);
+    }
+    else if (opt == "-bots" && arg+1 < argc)
+    {
+      settings.ExtraBots = atoi(argv[++arg]);
+    }
+    else if (opt == "-seed" && arg+1 < argc)
+    {
+      Seed = (unsigned int)atol(argv[++arg]);
+    }
+    else if (opt == "-matches" && arg+1 < argc)
+    {
+      NumMatches = atoi(argv[++arg]);
+    }
+    else if (opt == "-threads" && arg+1 < argc)
+    {
+      NumThreads = atoi(argv[++arg]);
+    }
+    else if (opt == "-pathstats")
+    {
+      settings.bPathStats = true;
+    }
+    else if (opt == "-h" || opt == "-help")
+    {
+      PrintUsage(); return 0;
+    }
+    else if (opt[0] == '-')
+    {
+      PrintUsage(); return 1;
+    }
+    else
+    {
+      settings.MapName = opt;
+    }
+  }
+
+  if (NumMatches < 1)          NumMatches = 1;
+  if (NumThreads < 1)          NumThreads = 1;
+  if (NumThreads > NumMatches) NumThreads = NumMatches;
+
+  std::cout << "simulating " << NumMatches << " match(es) of " << settings.NumTicks
+            << " ticks (" << (double)settings.NumTicks / FrameRate
+            << "s of game time) on " << NumThreads << " thread(s), seed "
+            << Seed << std::endl;
+
+  //each worker repeatedly takes the next match that has not been started
+  //until all have been run. Match i is seeded with Seed+i.
+  std::atomic<int> NextMatch(0);
+  std::atomic<int> NumFailed(0);
+  std::mutex       ErrorLock;
+
+  PrecisionTimer timer;
+  timer.Start();
+
+  std::vector<std::thread> workers;
+
+  for (int t=0; t<NumThreads; ++t)
+  {
+    workers.push_back(std::thread([&]()
+    {
+      for (int match = NextMatch++; match < NumMatches; match = NextMatch++)
+      {
+        try
+        {
+          if (!RunMatch(settings, Seed + match, ErrorLock))
+          {
+            std::lock_guard<std::mutex> lock(ErrorLock);
+            std::cerr << "unable to load map: " << settings.MapName << std::endl;
+
+            ++NumFailed;
+          }
+        }
+
+        catch (const std::runtime_error& err)
+        {
+          std::lock_guard<std::mutex> lock(ErrorLock);
+          std::cerr << "match " << match << ": " << err.what() << std::endl;
+
+          ++NumFailed;
+        }
+      }
+    }));
+  }
+
+  for (unsigned int t=0; t<workers.size(); ++t)
+  {
+    workers[t].join();
+  }
+
+  double TimeTaken = timer.CurrentTime();
+
+  if (NumFailed > 0) return 1;
+
+  double TotalTicks = (double)settings.NumTicks * NumMatches;
+
+  std::cout << "ticks:          " << TotalTicks << "\n"
+            << "wall time:      " << TimeTaken << "s\n";
+
+  if (TimeTaken > 0)
+  {
+    std::cout << "ticks/second:   " << TotalTicks / TimeTaken << "\n"
+              << "x real time:    " << (TotalTicks / TimeTaken) / FrameRate << "\n";
+  }
+
+  return 0;
+}
@@ -3,7 +3,7 @@
 #include "misc/Cgdi.h"
 #include "Graph/HandyGraphFunctions.h"
 #include "Raven_Door.h"
-#include "game/EntityManager.h"
+#include "Game/EntityManager.h"
 #include "constants.h"
 #include "lua/Raven_Scriptor.h"
 
@@ -14,20 +14,39 @@
 
 #include "Raven_UserOptions.h"
 
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <sstream>
+#include <cstdio>
+
 
 //uncomment to write object creation/deletion to debug console
 #define  LOG_CREATIONAL_STUFF
-#include "debug/DebugConsole.h"
+#include "Debug/DebugConsole.h"
 
 
 //----------------------------- ctor ------------------------------------------
 //-----------------------------------------------------------------------------
-Raven_Map::Raven_Map():m_pNavGraph(NULL),
-                       m_pSpacePartition(NULL),
-                       m_iSizeY(0),
-                       m_iSizeX(0),
-                       m_dCellSpaceNeighborhoodRange(0)
+Raven_Map::Raven_Map(const SimClock* clock):m_pClock(clock),
+                                            m_pWallSpace(NULL),
+                                            m_pNavGraph(NULL),
+                                            m_pSearchGraph(NULL),
+                                            m_pNavHierarchy(NULL),
+                                            m_pLandmarks(NULL),
+                                            m_pPathTable(NULL),
+                                            m_pSpacePartition(NULL),
+                                            m_iSizeY(0),
+                                            m_iSizeX(0),
+                                            m_dCellSpaceNeighborhoodRange(0),
+                                            m_iNavGraphVersion(0),
+                                            m_dClosedDoorCostFactor(1.0),
+                                            m_iItemFieldTriggerVersion(0)
 {
+  //an empty wall partition, so the walls can be queried even if no map is
+  //ever loaded
+  m_pWallSpace = new WallSpacePartition(m_Walls, m_MovingWalls, 1.0);
 }
 //------------------------------ dtor -----------------------------------------
 //-----------------------------------------------------------------------------
@@ -62,10 +81,42 @@ void Raven_Map::Clear()
   }
 
   m_Walls.clear();
+  m_MovingWalls.clear();
   m_SpawnPoints.clear();
+  m_DoorEdges.clear();
+  m_DoorOpen.clear();
+
+  //delete the wall partition
+  delete m_pWallSpace;
+  m_pWallSpace = NULL;
   
-  //delete the navgraph
+  //delete the navgraph and its search copy
   delete m_pNavGraph;   
+  m_pNavGraph = NULL;
+
+  //the cached paths and the distance fields refer to the search graph
+  m_PathCache.Clear();
+  m_FlowFields.Clear();
+
+  std::map<int, ItemDistanceField*>::iterator curField = m_ItemDistanceFields.begin();
+  for (curField; curField != m_ItemDistanceFields.end(); ++curField)
+  {
+    delete curField->second;
+  }
+
+  m_ItemDistanceFields.clear();
+
+  delete m_pNavHierarchy;
+  m_pNavHierarchy = NULL;
+
+  delete m_pLandmarks;
+  m_pLandmarks = NULL;
+
+  delete m_pPathTable;
+  m_pPathTable = NULL;
+
+  delete m_pSearchGraph;
+  m_pSearchGraph = NULL;
 
   //delete the partioning info
   delete m_pSpacePartition;
@@ -84,6 +135,7 @@ Wall2D* Raven_Map::AddWall(Vector2D from, Vector2D to)
   Wall2D* w = new Wall2D(from, to);
 
   m_Walls.push_back(w);
+  m_MovingWalls.push_back(w);
 
   return w;
 }
@@ -130,7 +182,7 @@ void Raven_Map::AddSpawnPoint(std::ifstream& in)
 //-----------------------------------------------------------------------------
 void Raven_Map::AddHealth_Giver(std::ifstream& in)
 {
-  Trigger_HealthGiver* hg = new Trigger_HealthGiver(in);
+  Trigger_HealthGiver* hg = new Trigger_HealthGiver(in, m_pClock);
 
   m_TriggerSystem.Register(hg);
 
@@ -147,7 +199,7 @@ void Raven_Map::AddHealth_Giver(std::ifstream& in)
 //-----------------------------------------------------------------------------
 void Raven_Map::AddWeapon_Giver(int type_of_weapon, std::ifstream& in)
 {
-  Trigger_WeaponGiver* wg = new Trigger_WeaponGiver(in);
+  Trigger_WeaponGiver* wg = new Trigger_WeaponGiver(in, m_pClock);
 
   wg->SetEntityType(type_of_weapon);
 
@@ -173,7 +225,9 @@ bool Raven_Map::LoadMap(const std::string& filename)
   std::ifstream in(filename.c_str());
   if (!in)
   {
+#ifndef RAVEN_HEADLESS
     ErrorBox("Bad Map Filename");
+#endif
     return false;
   }
 
@@ -217,6 +271,7 @@ bool Raven_Map::LoadMap(const std::string& filename)
   PartitionNavGraph();
 
 
+#ifndef RAVEN_HEADLESS
   //get the handle to the game window and resize the client area to accommodate
   //the map
   extern char* g_szApplicationName;
@@ -224,6 +279,7 @@ bool Raven_Map::LoadMap(const std::string& filename)
   HWND hwnd = FindWindow(g_szWindowClassName, g_szApplicationName);
   const int ExtraHeightRqdToDisplayInfo = 50;
   ResizeWindow(hwnd, m_iSizeX, m_iSizeY+ExtraHeightRqdToDisplayInfo);
+#endif
 
 #ifdef LOG_CREATIONAL_STUFF
     debug_con << "Loading map..." << "";
@@ -290,8 +346,108 @@ bool Raven_Map::LoadMap(const std::string& filename)
     debug_con << filename << " loaded okay" << "";
 #endif
 
+  //partition the walls. This must be done after all the entities have been
+  //created because doors add walls. Any wall lying off the map (some map
+  //files hold a stray wall far outside it) is left out of the grid along
+  //with the moving walls, or it would stretch the grid to cover it
+  std::vector<Wall2D*> UnpartitionedWalls(m_MovingWalls);
+
+  for (unsigned int w=0; w<m_Walls.size(); ++w)
+  {
+    //a moving wall is already on the list
+    if (std::find(m_MovingWalls.begin(), m_MovingWalls.end(), m_Walls[w]) != m_MovingWalls.end())
+    {
+      continue;
+    }
+
+    Vector2D from = m_Walls[w]->From();
+    Vector2D to   = m_Walls[w]->To();
+
+    if (MinOf(from.x, to.x) < -m_iSizeX || MaxOf(from.x, to.x) > 2*m_iSizeX ||
+        MinOf(from.y, to.y) < -m_iSizeY || MaxOf(from.y, to.y) > 2*m_iSizeY)
+    {
+      UnpartitionedWalls.push_back(m_Walls[w]);
+    }
+  }
+
+  m_pWallSpace = new WallSpacePartition(m_Walls,
+                                        UnpartitionedWalls,
+                                        script->GetDouble("WallCellSize"));
+
+  //copy the navgraph into the form used for searching. This too must wait
+  //until the entities have been created because the item givers are
+  //recorded in the extra info field of the graph's nodes
+  m_pSearchGraph = new SearchGraph(*m_pNavGraph);
+
+  m_PathCache.SetMaxSize(script->GetInt("PathCacheSize"));
+  m_FlowFields.SetMaxSize(script->GetInt("FlowFieldCacheSize"));
+
+  //note the edges through the doors, which all start closed
+  m_dClosedDoorCostFactor = script->GetDouble("ClosedDoorCostFactor");
+
+  for (unsigned int d=0; d<m_Doors.size(); ++d)
+  {
+    m_DoorOpen[m_Doors[d]->ID()] = false;
+  }
+
+  for (int n=0; n<m_pSearchGraph->NumNodes(); ++n)
+  {
+    if (!m_pSearchGraph->isNodePresent(n)) continue;
+
+    SearchGraph::ConstEdgeIterator EdgeItr(*m_pSearchGraph, n);
+    for (const NavGraphEdge* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+    {
+      if (pE->Flags() & NavGraphEdge::goes_through_door)
+      {
+        m_DoorEdges.push_back(std::make_pair(pE->From(), pE->To()));
+      }
+    }
+  }
+
+  //large maps are also divided into clusters for hierarchical path planning
+  if (m_pSearchGraph->NumActiveNodes() >= script->GetInt("HierarchicalPathMinNodes"))
+  {
+    m_pNavHierarchy = new NavHierarchy(*m_pSearchGraph,
+                                       script->GetDouble("NavGraphClusterSize"));
+  }
+
+  //choose the landmarks for the A* heuristic and calculate their costs
+  if (script->GetInt("NumPathLandmarks") > 0)
+  {
+    m_pLandmarks = new GraphLandmarks(*m_pSearchGraph, script->GetInt("NumPathLandmarks"));
+  }
+
+  //small enough maps have a table of the shortest paths between all nodes,
+  //unless the doors alter the costs of the paths
+  if (!HasDoorEdgeCosts() &&
+      script->GetInt("PathTableMaxNodes") > 0 &&
+      m_pSearchGraph->NumActiveNodes() <= script->GetInt("PathTableMaxNodes"))
+  {
+    int NumThreads = script->GetInt("PathCostThreads");
+
+    if (NumThreads <= 0) NumThreads = (int)std::thread::hardware_concurrency();
+    if (NumThreads <= 0) NumThreads = 1;
+
+    m_pPathTable = new CompressedPathTable();
+
+    CreateCompressedPathTable(*m_pSearchGraph, *m_pPathTable, NumThreads);
+
+#ifdef LOG_CREATIONAL_STUFF
+    debug_con << "Path table uses " << (int)m_pPathTable->GetMemoryUsed() << " bytes" << "";
+#endif
+  }
+
+  //create a distance field for each type of item the bots look for. The
+  //sources are the active givers of the type
+  m_ItemDistanceFields[type_health]          = new ItemDistanceField(*m_pSearchGraph);
+  m_ItemDistanceFields[type_shotgun]         = new ItemDistanceField(*m_pSearchGraph);
+  m_ItemDistanceFields[type_rail_gun]        = new ItemDistanceField(*m_pSearchGraph);
+  m_ItemDistanceFields[type_rocket_launcher] = new ItemDistanceField(*m_pSearchGraph);
+
+  UpdateItemDistanceFields();
+
    //calculate the cost lookup table
-  m_PathCosts = CreateAllPairsCostsTable(*m_pNavGraph);
+  CreatePathCosts(filename);
 
   return true;
 }
@@ -300,10 +456,169 @@ bool Raven_Map::LoadMap(const std::string& filename)
 
 
 
+//------------------------- PathCostStorageType -------------------------------
+//
+//  reads the precision the path cost table is stored with from Params.lua
+//-----------------------------------------------------------------------------
+static PathCostTable::storage_type PathCostStorageType()
+{
+  std::string storage = script->GetString("PathCostStorage");
+
+  if (storage == "exact") return PathCostTable::exact;
+  if (storage == "float") return PathCostTable::single_precision;
+
+  return PathCostTable::fixed_point;
+}
+
+//------------------------- CacheFileLock -------------------------------------
+//
+//  returns the mutex guarding the named path cost cache file. There is one
+//  per file, so games loading different maps do not wait for each other
+//-----------------------------------------------------------------------------
+static std::mutex& CacheFileLock(const std::string& CacheFileName)
+{
+  static std::mutex                        LocksLock;
+  static std::map<std::string, std::mutex> Locks;
+
+  std::lock_guard<std::mutex> lock(LocksLock);
+
+  return Locks[CacheFileName];
+}
+
+//------------------------- CreatePathCosts -----------------------------------
+//
+//  the table is calculated using one thread per core unless PathCostThreads
+//  in Params.lua specifies otherwise
+//-----------------------------------------------------------------------------
+void Raven_Map::CreatePathCosts(const std::string& MapFileName)
+{
+  const bool               bUseCache     = script->GetBool("CachePathCosts");
+  const std::string        CacheFileName = MapFileName + ".costs";
+  const unsigned long long GraphHash     = CalculateGraphHash(*m_pSearchGraph);
+
+  //games in the same process loading the same map wait for whichever got
+  //here first; they then find its results in the cache. Games loading other
+  //maps, or not using the cache, carry straight on
+  std::unique_lock<std::mutex> lock;
+
+  if (bUseCache) lock = std::unique_lock<std::mutex>(CacheFileLock(CacheFileName));
+
+  //the costs between the nodes of an undirected graph are symmetric so only
+  //half the table need be stored
+  m_PathCosts.Reset(m_pSearchGraph->NumNodes(),
+                    !m_pSearchGraph->isDigraph(),
+                    PathCostStorageType());
+
+  if (bUseCache && LoadPathCosts(CacheFileName, GraphHash))
+  {
+#ifdef LOG_CREATIONAL_STUFF
+    debug_con << "Path costs read from " << CacheFileName << "";
+#endif
+    return;
+  }
+
+  int NumThreads = script->GetInt("PathCostThreads");
+
+  if (NumThreads <= 0) NumThreads = (int)std::thread::hardware_concurrency();
+  if (NumThreads <= 0) NumThreads = 1;
+
+  CreateAllPairsCostsTable(*m_pSearchGraph, m_PathCosts, NumThreads);
+
+#ifdef LOG_CREATIONAL_STUFF
+    debug_con << "Path cost table uses " << (int)m_PathCosts.GetMemoryUsed() << " bytes" << "";
+#endif
+
+  if (bUseCache) SavePathCosts(CacheFileName, GraphHash);
+}
+
+//-------------------------- path cost cache ----------------------------------
+//
+//  the file holds a header (an identifier, the format version, the graph
+//  hash, the number of nodes, the storage type and whether the table is
+//  symmetric) followed by the table's raw data. A file is only used if its
+//  header matches the table as sized by CreatePathCosts
+//-----------------------------------------------------------------------------
+static const int PathCostsFileID      = 0x52504354;   //'RPCT'
+static const int PathCostsFileVersion = 2;
+
+bool Raven_Map::LoadPathCosts(const std::string& CacheFileName,
+                              unsigned long long GraphHash)
+{
+  std::ifstream in(CacheFileName.c_str(), std::ios::in | std::ios::binary);
+
+  if (!in) return false;
+
+  int                ID = 0, version = 0, NumNodes = 0, storage = 0, symmetric = 0;
+  unsigned long long hash = 0;
+
+  in.read((char*)&ID,        sizeof(ID));
+  in.read((char*)&version,   sizeof(version));
+  in.read((char*)&hash,      sizeof(hash));
+  in.read((char*)&NumNodes,  sizeof(NumNodes));
+  in.read((char*)&storage,   sizeof(storage));
+  in.read((char*)&symmetric, sizeof(symmetric));
+
+  if (!in                                        ||
+      ID        != PathCostsFileID               ||
+      version   != PathCostsFileVersion          ||
+      hash      != GraphHash                     ||
+      NumNodes  != m_PathCosts.NumNodes()        ||
+      storage   != m_PathCosts.GetStorageType()  ||
+      symmetric != (int)m_PathCosts.isSymmetric())
+  {
+    return false;
+  }
+
+  return m_PathCosts.Read(in);
+}
+
+void Raven_Map::SavePathCosts(const std::string& CacheFileName,
+                              unsigned long long GraphHash)const
+{
+  //the table is written to a temporary file which then replaces the cache
+  //file so that another process can never read a partly written table
+  std::ostringstream TempFileName;
+  TempFileName << CacheFileName << "." << std::this_thread::get_id() << ".tmp";
+
+  {
+    std::ofstream out(TempFileName.str().c_str(), std::ios::out | std::ios::binary);
+
+    if (!out) return;
+
+    int NumNodes  = m_PathCosts.NumNodes();
+    int storage   = m_PathCosts.GetStorageType();
+    int symmetric = m_PathCosts.isSymmetric();
+
+    out.write((const char*)&PathCostsFileID,      sizeof(PathCostsFileID));
+    out.write((const char*)&PathCostsFileVersion, sizeof(PathCostsFileVersion));
+    out.write((const char*)&GraphHash,            sizeof(GraphHash));
+    out.write((const char*)&NumNodes,             sizeof(NumNodes));
+    out.write((const char*)&storage,              sizeof(storage));
+    out.write((const char*)&symmetric,            sizeof(symmetric));
+
+    m_PathCosts.Write(out);
+
+    if (!out)
+    {
+      out.close(); remove(TempFileName.str().c_str()); return;
+    }
+  }
+
+  remove(CacheFileName.c_str());
+
+  if (rename(TempFileName.str().c_str(), CacheFileName.c_str()) != 0)
+  {
+    remove(TempFileName.str().c_str());
+  }
+}
+
+
 //------------- CalculateCostToTravelBetweenNodes -----------------------------
 //
 //  Uses the pre-calculated lookup table to determine the cost of traveling
-//  from nd1 to nd2
+//  from nd1 to nd2. The table takes no account of the doors, so if
+//  ClosedDoorCostFactor is above 1 this may be less than the cost of the path
+//  planned while a door is closed
 //-----------------------------------------------------------------------------
 double 
 Raven_Map::CalculateCostToTravelBetweenNodes(int nd1, int nd2)const
@@ -312,7 +627,7 @@ Raven_Map::CalculateCostToTravelBetweenNodes(int nd1, int nd2)const
           nd2>=0 && nd2<m_pNavGraph->NumNodes() &&
           "<Raven_Map::CostBetweenNodes>: invalid index");
 
-  return m_PathCosts[nd1][nd2];
+  return m_PathCosts.GetCost(nd1, nd2);
 }
 
 
@@ -352,9 +667,107 @@ void Raven_Map::AddSoundTrigger(Raven_Bot* pSoundSource, double range)
 //  givena container of entities in the world this method updates them against
 //  all the triggers
 //-----------------------------------------------------------------------------
-void Raven_Map::UpdateTriggerSystem(std::list<Raven_Bot*>& bots)
+void Raven_Map::UpdateTriggerSystem(std::list<Raven_Bot*>&                 bots,
+                                    const CellSpacePartition<Raven_Bot*>& BotSpace)
+{
+  m_TriggerSystem.Update(bots, BotSpace);
+
+  if (m_TriggerSystem.GetActivationVersion() != m_iItemFieldTriggerVersion)
+  {
+    UpdateItemDistanceFields();
+  }
+}
+
+//------------------------- DoorStateChanged ----------------------------------
+//-----------------------------------------------------------------------------
+void Raven_Map::DoorStateChanged(int DoorID, bool bOpen)
+{
+  m_DoorOpen[DoorID] = bOpen;
+
+  NavGraphChanged();
+}
+
+//---------------------------- GetEdgeCost ------------------------------------
+//-----------------------------------------------------------------------------
+double Raven_Map::GetEdgeCost(const NavGraphEdge& edge)const
+{
+  if (edge.Flags() & NavGraphEdge::goes_through_door)
+  {
+    std::map<int, bool>::const_iterator door = m_DoorOpen.find(edge.IDofIntersectingEntity());
+
+    if (door != m_DoorOpen.end() && !door->second)
+    {
+      return edge.Cost() * m_dClosedDoorCostFactor;
+    }
+  }
+
+  return edge.Cost();
+}
+
+//------------------------- HasDoorEdgeCosts ----------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_Map::HasDoorEdgeCosts()const
+{
+  return !m_DoorEdges.empty() && m_dClosedDoorCostFactor != 1.0;
+}
+
+//--------------------------- UsesFlowFields ----------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_Map::UsesFlowFields()const
+{
+  return m_FlowFields.MaxSize() > 0 && !HasDoorEdgeCosts();
+}
+
+//---------------------------- GetFlowField -----------------------------------
+//-----------------------------------------------------------------------------
+const Raven_Map::SearchFlowFields::FlowField* Raven_Map::GetFlowField(int node)
 {
-  m_TriggerSystem.Update(bots);
+  if (!UsesFlowFields()) return NULL;
+
+  return m_FlowFields.GetField(*m_pSearchGraph, node);
+}
+
+//--------------------- UpdateItemDistanceFields ------------------------------
+//
+//  only the givers whose active state has changed since the last update
+//  alter the fields
+//-----------------------------------------------------------------------------
+void Raven_Map::UpdateItemDistanceFields()
+{
+  TriggerSystem::TriggerList::const_iterator curTrg = GetTriggers().begin();
+  for (curTrg; curTrg != GetTriggers().end(); ++curTrg)
+  {
+    //only the item givers are placed at graph nodes
+    if ((*curTrg)->GraphNodeIndex() == invalid_node_index) continue;
+
+    std::map<int, ItemDistanceField*>::iterator field =
+                               m_ItemDistanceFields.find((*curTrg)->EntityType());
+
+    if (field == m_ItemDistanceFields.end()) continue;
+
+    if ((*curTrg)->isActive())
+    {
+      field->second->AddSource((*curTrg)->GraphNodeIndex());
+    }
+    else
+    {
+      field->second->RemoveSource((*curTrg)->GraphNodeIndex());
+    }
+  }
+
+  m_iItemFieldTriggerVersion = m_TriggerSystem.GetActivationVersion();
+}
+
+//------------------------ GetItemDistanceField -------------------------------
+//-----------------------------------------------------------------------------
+const Raven_Map::ItemDistanceField* Raven_Map::GetItemDistanceField(int ItemType)const
+{
+  std::map<int, ItemDistanceField*>::const_iterator field =
+                                               m_ItemDistanceFields.find(ItemType);
+
+  if (field == m_ItemDistanceFields.end()) return NULL;
+
+  return field->second;
 }
 
 //------------------------- GetRandomNodeLocation -----------------------------
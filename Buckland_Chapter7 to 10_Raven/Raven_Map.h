@@ -16,17 +16,28 @@
 #include <vector>
 #include <string>
 #include <list>
-#include "graph/SparseGraph.h"
-#include "2d/Wall2D.h"
-#include "triggers/Trigger.h"
+#include <map>
+#include "Graph/SparseGraph.h"
+#include "Graph/CSRGraph.h"
+#include "Graph/HierarchicalGraph.h"
+#include "Graph/DistanceField.h"
+#include "Graph/GraphLandmarks.h"
+#include "Graph/CompressedPathTable.h"
+#include "Graph/PathCostTable.h"
+#include "2D/Wall2D.h"
+#include "2D/WallSpacePartition.h"
+#include "Triggers/Trigger.h"
 #include "Raven_Bot.h"
 #include "Graph/GraphEdgeTypes.h"
 #include "Graph/GraphNodeTypes.h"
 #include "misc/CellSpacePartition.h"
-#include "triggers/TriggerSystem.h"
+#include "Triggers/TriggerSystem.h"
+#include "navigation/PathCache.h"
+#include "navigation/FlowFieldCache.h"
 
 class BaseGameEntity;
 class Raven_Door;
+class SimClock;
 
 
 class Raven_Map
@@ -35,16 +46,48 @@ public:
 
   typedef NavGraphNode<Trigger<Raven_Bot>*>         GraphNode;
   typedef SparseGraph<GraphNode, NavGraphEdge>      NavGraph;
+  typedef CSRGraph<GraphNode, NavGraphEdge>         SearchGraph;
+  typedef HierarchicalGraph<SearchGraph>            NavHierarchy;
+  typedef PathCache<NavGraphEdge>                   SearchPathCache;
+  typedef FlowFieldCache<SearchGraph>               SearchFlowFields;
+  typedef DistanceField<SearchGraph>                ItemDistanceField;
   typedef CellSpacePartition<NavGraph::NodeType*>   CellSpace;
 
   typedef Trigger<Raven_Bot>                        TriggerType;
   typedef TriggerSystem<TriggerType>                TriggerSystem;
+
+  //an edge cost policy giving the costs of the search graph's edges as
+  //altered by the doors (see Graph_SearchDStarLite_TS)
+  class DoorEdgeCost
+  {
+  private:
+
+    const Raven_Map* m_pMap;
+
+  public:
+
+    DoorEdgeCost(const Raven_Map* pMap = NULL):m_pMap(pMap){}
+
+    double Cost(const NavGraphEdge& edge)const{return m_pMap->GetEdgeCost(edge);}
+  };
   
 private:
+
+  //the clock owned by the game world. Respawning triggers are timed
+  //against it.
+  const SimClock*                    m_pClock;
  
   //the walls that comprise the current map's architecture. 
   std::vector<Wall2D*>                m_Walls;
 
+  //the walls added by objects such as doors. These may move so they are
+  //kept out of the wall partition's grid
+  std::vector<Wall2D*>                m_MovingWalls;
+
+  //the walls are partitioned once the map has loaded, enabling fast line
+  //of sight and collision tests
+  WallSpacePartition*                m_pWallSpace;
+
   //trigger are objects that define a region of space. When a raven bot
   //enters that area, it 'triggers' an event. That event may be anything
   //from increasing a bot's health to opening a door or requesting a lift.
@@ -60,6 +103,19 @@ private:
   //this map's accompanying navigation graph
   NavGraph*                          m_pNavGraph;  
 
+  //a compact read only copy of the navgraph made once the map has loaded.
+  //The path planners search this rather than the navgraph itself
+  SearchGraph*                       m_pSearchGraph;
+
+  //the clusters and entrances of the search graph used for hierarchical
+  //path planning. This is only built for maps with at least
+  //HierarchicalPathMinNodes nodes (see Params.lua) and is NULL otherwise
+  NavHierarchy*                      m_pNavHierarchy;
+
+  //the costs from a few landmark nodes to every node of the search graph,
+  //used by the A* heuristic. (NULL if NumPathLandmarks is zero)
+  GraphLandmarks*                    m_pLandmarks;
+
   //the graph nodes will be partitioned enabling fast lookup
   CellSpace*                        m_pSpacePartition;
 
@@ -73,8 +129,59 @@ private:
   void  PartitionNavGraph();
 
   //this will hold a pre-calculated lookup table of the cost to travel from
-  //one node to any other.
-  std::vector<std::vector<double> >  m_PathCosts;
+  //one node to any other. (the precision it is stored with is set by
+  //PathCostStorage in Params.lua)
+  PathCostTable                      m_PathCosts;
+
+  //the next node on the shortest path between every pair of nodes of the
+  //search graph. (NULL if the table is disabled or the map has more than
+  //PathTableMaxNodes nodes)
+  CompressedPathTable*               m_pPathTable;
+
+  //calculates m_PathCosts or, if enabled and up to date, reads it from the
+  //cache file kept alongside the map file
+  void  CreatePathCosts(const std::string& MapFileName);
+
+  //the cache file records a hash of the navgraph it was calculated from.
+  //LoadPathCosts returns false if the file is missing, incomplete or was
+  //calculated from a different graph
+  bool  LoadPathCosts(const std::string& CacheFileName, unsigned long long GraphHash);
+  void  SavePathCosts(const std::string& CacheFileName, unsigned long long GraphHash)const;
+
+  //the results of recent searches of the search graph, shared by all the
+  //bots' path planners (the size is set by PathCacheSize in Params.lua)
+  SearchPathCache                    m_PathCache;
+
+  //the flow fields to the destinations the bots have recently headed for,
+  //shared by all the bots (the number kept is set by FlowFieldCacheSize in
+  //Params.lua)
+  SearchFlowFields                   m_FlowFields;
+
+  //incremented each time the navgraph's traversability changes, such as
+  //when a door opens or closes. Cached paths found with an earlier version
+  //are discarded
+  unsigned int                       m_iNavGraphVersion;
+
+  //the edges of the search graph that pass through doors (as from/to node
+  //pairs) and whether each door is open, keyed by the door's ID
+  std::vector<std::pair<int, int> >  m_DoorEdges;
+  std::map<int, bool>                m_DoorOpen;
+
+  //the cost of an edge through a closed door is multiplied by this
+  double                             m_dClosedDoorCostFactor;
+
+  //for each type of item given by the triggers (health and each weapon),
+  //the cost from every node of the search graph to the closest active
+  //item of that type and the next node on the path to it
+  std::map<int, ItemDistanceField*>  m_ItemDistanceFields;
+
+  //the trigger activation version the distance fields were last brought
+  //up to date with
+  unsigned int                       m_iItemFieldTriggerVersion;
+
+  //adds or removes each item giver from the distance field of its type so
+  //that exactly the active givers are sources
+  void  UpdateItemDistanceFields();
 
 
     //stream constructors for loading from a file
@@ -89,7 +196,7 @@ private:
   
 public:
   
-  Raven_Map();  
+  Raven_Map(const SimClock* clock);  
   ~Raven_Map();
 
   void Render();
@@ -109,11 +216,49 @@ public:
   Vector2D GetRandomNodeLocation()const;
   
   
-  void  UpdateTriggerSystem(std::list<Raven_Bot*>& bots);
+  //the bots are tried against each trigger's region using the given
+  //partition of the bots' positions
+  void  UpdateTriggerSystem(std::list<Raven_Bot*>&                 bots,
+                            const CellSpacePartition<Raven_Bot*>& BotSpace);
 
   const Raven_Map::TriggerSystem::TriggerList&  GetTriggers()const{return m_TriggerSystem.GetTriggers();}
   const std::vector<Wall2D*>&        GetWalls()const{return m_Walls;}
+  const WallSpacePartition&          GetWallSpace()const{return *m_pWallSpace;}
   NavGraph&                          GetNavGraph()const{return *m_pNavGraph;}
+  const SearchGraph&                 GetSearchGraph()const{return *m_pSearchGraph;}
+  const NavHierarchy*                GetNavHierarchy()const{return m_pNavHierarchy;}
+  const GraphLandmarks*              GetLandmarks()const{return m_pLandmarks;}
+  const CompressedPathTable*         GetPathTable()const{return m_pPathTable;}
+  SearchPathCache&                   GetPathCache(){return m_PathCache;}
+  SearchFlowFields&                  GetFlowFields(){return m_FlowFields;}
+  unsigned int                       GetNavGraphVersion()const{return m_iNavGraphVersion;}
+  unsigned int                       GetTriggerVersion()const{return m_TriggerSystem.GetActivationVersion();}
+  void                               NavGraphChanged(){++m_iNavGraphVersion;}
+
+  //called by a door once it has fully opened or closed
+  void                               DoorStateChanged(int DoorID, bool bOpen);
+
+  //returns the cost of the edge of the search graph given the current state
+  //of the doors
+  double                             GetEdgeCost(const NavGraphEdge& edge)const;
+
+  //true if the doors alter the costs of the search graph's edges. Paths
+  //must then be planned with the DoorEdgeCost policy
+  bool                               HasDoorEdgeCosts()const;
+  const std::vector<std::pair<int, int> >& GetDoorEdges()const{return m_DoorEdges;}
+
+  //true if bots heading for the same destination should follow a shared
+  //flow field rather than each plan a path. The fields ignore the doors so
+  //they are not used when the doors alter the edge costs
+  bool                               UsesFlowFields()const;
+
+  //returns the flow field to the node, building it if need be. (NULL if
+  //flow fields are not used)
+  const SearchFlowFields::FlowField* GetFlowField(int node);
+
+  //returns NULL if no distance field is kept for the item type
+  const ItemDistanceField*           GetItemDistanceField(int ItemType)const;
+
   std::vector<Raven_Door*>&          GetDoors(){return m_Doors;}
   const std::vector<Vector2D>&       GetSpawnPoints()const{return m_SpawnPoints;}
   CellSpace* const                   GetCellSpace()const{return m_pSpacePartition;}
@@ -1,7 +1,7 @@
 #include "Raven_SensoryMemory.h"
 #include "Raven_Game.h"
-#include "time/crudetimer.h"
-#include "misc/cgdi.h"
+#include "Raven_Visibility.h"
+#include "misc/Cgdi.h"
 #include "misc/Stream_Utility_Functions.h"
 
 //------------------------------- ctor ----------------------------------------
@@ -14,14 +14,41 @@
 
 //--------------------- MakeNewRecordIfNotAlreadyPresent ----------------------
 
-void Raven_SensoryMemory::MakeNewRecordIfNotAlreadyPresent(Raven_Bot* pOpponent)
+MemoryRecord& Raven_SensoryMemory::MakeNewRecordIfNotAlreadyPresent(Raven_Bot* pOpponent)
 {
+  if (pOpponent->Slot() >= (int)m_Records.size())
+  {
+    m_Records.resize(pOpponent->Slot() + 1);
+  }
+
+  MemoryRecord& record = m_Records[pOpponent->Slot()];
+
   //else check to see if this Opponent already exists in the memory. If it doesn't,
   //create a new record
-  if (m_MemoryMap.find(pOpponent) == m_MemoryMap.end())
+  if (record.pOpponent != pOpponent)
+  {
+    record = MemoryRecord();
+
+    record.pOpponent = pOpponent;
+  }
+
+  return record;
+}
+
+//------------------------------- GetRecord -----------------------------------
+//-----------------------------------------------------------------------------
+const MemoryRecord* Raven_SensoryMemory::GetRecord(const Raven_Bot* pOpponent)const
+{
+  //callers may ask about a target that is not set
+  if (!pOpponent) return NULL;
+
+  if (pOpponent->Slot() < (int)m_Records.size() &&
+      m_Records[pOpponent->Slot()].pOpponent == pOpponent)
   {
-    m_MemoryMap[pOpponent] = MemoryRecord();
+    return &m_Records[pOpponent->Slot()];
   }
+
+  return NULL;
 }
 
 //------------------------ RemoveBotFromMemory --------------------------------
@@ -30,11 +57,9 @@ void Raven_SensoryMemory::MakeNewRecordIfNotAlreadyPresent(Raven_Bot* pOpponent)
 //-----------------------------------------------------------------------------
 void Raven_SensoryMemory::RemoveBotFromMemory(Raven_Bot* pBot)
 {
-  MemoryMap::iterator record = m_MemoryMap.find(pBot);
-  
-  if (record != m_MemoryMap.end())
+  if (GetRecord(pBot))
   {
-    m_MemoryMap.erase(record);
+    m_Records[pBot->Slot()] = MemoryRecord();
   }
 }
   
@@ -51,9 +76,7 @@ void Raven_SensoryMemory::UpdateWithSoundSource(Raven_Bot* pNoiseMaker)
   {
     //if the bot is already part of the memory then update its data, else
     //create a new memory record and add it to the memory
-    MakeNewRecordIfNotAlreadyPresent(pNoiseMaker);
-
-    MemoryRecord& info = m_MemoryMap[pNoiseMaker];
+    MemoryRecord& info = MakeNewRecordIfNotAlreadyPresent(pNoiseMaker);
 
     //test if there is LOS between bots 
     if (m_pOwner->GetWorld()->isLOSOkay(m_pOwner->Pos(), pNoiseMaker->Pos()))
@@ -69,7 +92,7 @@ void Raven_SensoryMemory::UpdateWithSoundSource(Raven_Bot* pNoiseMaker)
     }
     
     //record the time it was sensed
-    info.fTimeLastSensed = (double)Clock->GetCurrentTime();
+    info.fTimeLastSensed = m_pOwner->GetWorld()->GetClock()->GetCurrentTime();
   }
 }
 
@@ -77,39 +100,42 @@ void Raven_SensoryMemory::UpdateWithSoundSource(Raven_Bot* pNoiseMaker)
 //
 //  this method iterates through all the bots in the game world to test if
 //  they are in the field of view. Each bot's memory record is updated
-//  accordingly
+//  accordingly. The line of sight between the bots is read from the world's
+//  table so that must be updated first
 //-----------------------------------------------------------------------------
 void Raven_SensoryMemory::UpdateVision()
 {
+  const Raven_Visibility* pVisibility = m_pOwner->GetWorld()->GetVisibility();
+
+  if (!pVisibility->isInTable(m_pOwner)) return;
+
   //for each bot in the world test to see if it is visible to the owner of
   //this class
-  const std::list<Raven_Bot*>& bots = m_pOwner->GetWorld()->GetAllBots();
-  std::list<Raven_Bot*>::const_iterator curBot;
-  for (curBot = bots.begin(); curBot!=bots.end(); ++curBot)
+  for (int slot=0; slot<pVisibility->NumSlots(); ++slot)
   {
+    Raven_Bot* curBot = pVisibility->GetBot(slot);
+
     //make sure the bot being examined is not this bot
-    if (m_pOwner != *curBot)
+    if (curBot && m_pOwner != curBot)
     {
-      //make sure it is part of the memory map
-      MakeNewRecordIfNotAlreadyPresent(*curBot);
-
-      //get a reference to this bot's data
-      MemoryRecord& info = m_MemoryMap[*curBot];
+      //make sure it is part of the memory and get a reference to this
+      //bot's data
+      MemoryRecord& info = MakeNewRecordIfNotAlreadyPresent(curBot);
 
       //test if there is LOS between bots 
-      if (m_pOwner->GetWorld()->isLOSOkay(m_pOwner->Pos(), (*curBot)->Pos()))
+      if (pVisibility->isLOSOkay(m_pOwner->Slot(), slot))
       {
         info.bShootable = true;
 
               //test if the bot is within FOV
         if (isSecondInFOVOfFirst(m_pOwner->Pos(),
                                  m_pOwner->Facing(),
-                                 (*curBot)->Pos(),
+                                 curBot->Pos(),
                                   m_pOwner->FieldOfView()))
         {
-          info.fTimeLastSensed     = Clock->GetCurrentTime();
-          info.vLastSensedPosition = (*curBot)->Pos();
-          info.fTimeLastVisible    = Clock->GetCurrentTime();
+          info.fTimeLastSensed     = m_pOwner->GetWorld()->GetClock()->GetCurrentTime();
+          info.vLastSensedPosition = curBot->Pos();
+          info.fTimeLastVisible    = m_pOwner->GetWorld()->GetClock()->GetCurrentTime();
 
           if (info.bWithinFOV == false)
           {
@@ -135,29 +161,30 @@ void Raven_SensoryMemory::UpdateVision()
 }
 
 
-//------------------------ GetListOfRecentlySensedOpponents -------------------
+//-------------------------- GetRecentlySensedOpponents ----------------------
 //
-//  returns a list of the bots that have been sensed recently
+//  returns the bots that have been sensed recently
 //-----------------------------------------------------------------------------
-std::list<Raven_Bot*> 
-Raven_SensoryMemory::GetListOfRecentlySensedOpponents()const
+const std::vector<Raven_Bot*>&
+Raven_SensoryMemory::GetRecentlySensedOpponents()const
 {
   //this will store all the opponents the bot can remember
-  std::list<Raven_Bot*> opponents;
+  m_RecentlySensed.clear();
 
-  double CurrentTime = Clock->GetCurrentTime();
+  double CurrentTime = m_pOwner->GetWorld()->GetClock()->GetCurrentTime();
 
-  MemoryMap::const_iterator curRecord = m_MemoryMap.begin();
-  for (curRecord; curRecord!=m_MemoryMap.end(); ++curRecord)
+  MemoryRecords::const_iterator curRecord = m_Records.begin();
+  for (curRecord; curRecord!=m_Records.end(); ++curRecord)
   {
     //if this bot has been updated in the memory recently, add to list
-    if ( (CurrentTime - curRecord->second.fTimeLastSensed) <= m_dMemorySpan)
+    if (curRecord->pOpponent &&
+        (CurrentTime - curRecord->fTimeLastSensed) <= m_dMemorySpan)
     {
-      opponents.push_back(curRecord->first);
+      m_RecentlySensed.push_back(curRecord->pOpponent);
     }
   }
 
-  return opponents;
+  return m_RecentlySensed;
 }
 
 //----------------------------- isOpponentShootable --------------------------------
@@ -167,11 +194,11 @@ Raven_SensoryMemory::GetListOfRecentlySensedOpponents()const
 //-----------------------------------------------------------------------------
 bool Raven_SensoryMemory::isOpponentShootable(Raven_Bot* pOpponent)const
 {
-  MemoryMap::const_iterator it = m_MemoryMap.find(pOpponent);
+  const MemoryRecord* pRecord = GetRecord(pOpponent);
 
-  if (it != m_MemoryMap.end())
+  if (pRecord)
   {
-	return it->second.bShootable;
+    return pRecord->bShootable;
   }
 
   return false;
@@ -183,11 +210,11 @@ bool Raven_SensoryMemory::isOpponentShootable(Raven_Bot* pOpponent)const
 //-----------------------------------------------------------------------------
 bool  Raven_SensoryMemory::isOpponentWithinFOV(Raven_Bot* pOpponent)const
 {
-  MemoryMap::const_iterator it = m_MemoryMap.find(pOpponent);
+  const MemoryRecord* pRecord = GetRecord(pOpponent);
  
-  if (it != m_MemoryMap.end())
+  if (pRecord)
   {
-    return it->second.bWithinFOV;
+    return pRecord->bWithinFOV;
   }
 
   return false;
@@ -199,11 +226,11 @@ bool  Raven_SensoryMemory::isOpponentWithinFOV(Raven_Bot* pOpponent)const
 //-----------------------------------------------------------------------------
 Vector2D  Raven_SensoryMemory::GetLastRecordedPositionOfOpponent(Raven_Bot* pOpponent)const
 {
-  MemoryMap::const_iterator it = m_MemoryMap.find(pOpponent);
+  const MemoryRecord* pRecord = GetRecord(pOpponent);
  
-  if (it != m_MemoryMap.end())
+  if (pRecord)
   {
-    return it->second.vLastSensedPosition;
+    return pRecord->vLastSensedPosition;
   }
 
   throw std::runtime_error("< Raven_SensoryMemory::GetLastRecordedPositionOfOpponent>: Attempting to get position of unrecorded bot");
@@ -215,11 +242,11 @@ Vector2D  Raven_SensoryMemory::GetLastRecordedPositionOfOpponent(Raven_Bot* pOpp
 //-----------------------------------------------------------------------------
 double  Raven_SensoryMemory::GetTimeOpponentHasBeenVisible(Raven_Bot* pOpponent)const
 {
-  MemoryMap::const_iterator it = m_MemoryMap.find(pOpponent);
+  const MemoryRecord* pRecord = GetRecord(pOpponent);
  
-  if (it != m_MemoryMap.end() && it->second.bWithinFOV)
+  if (pRecord && pRecord->bWithinFOV)
   {
-    return Clock->GetCurrentTime() - it->second.fTimeBecameVisible;
+    return m_pOwner->GetWorld()->GetClock()->GetCurrentTime() - pRecord->fTimeBecameVisible;
   }
 
   return 0;
@@ -232,11 +259,11 @@ double  Raven_SensoryMemory::GetTimeOpponentHasBeenVisible(Raven_Bot* pOpponent)
 //-----------------------------------------------------------------------------
 double Raven_SensoryMemory::GetTimeOpponentHasBeenOutOfView(Raven_Bot* pOpponent)const
 {
-  MemoryMap::const_iterator it = m_MemoryMap.find(pOpponent);
+  const MemoryRecord* pRecord = GetRecord(pOpponent);
  
-  if (it != m_MemoryMap.end())
+  if (pRecord)
   {
-    return Clock->GetCurrentTime() - it->second.fTimeLastVisible;
+    return m_pOwner->GetWorld()->GetClock()->GetCurrentTime() - pRecord->fTimeLastVisible;
   }
 
   return MaxDouble;
@@ -248,11 +275,11 @@ double Raven_SensoryMemory::GetTimeOpponentHasBeenOutOfView(Raven_Bot* pOpponent
 //-----------------------------------------------------------------------------
 double  Raven_SensoryMemory::GetTimeSinceLastSensed(Raven_Bot* pOpponent)const
 {
-  MemoryMap::const_iterator it = m_MemoryMap.find(pOpponent);
+  const MemoryRecord* pRecord = GetRecord(pOpponent);
  
-  if (it != m_MemoryMap.end() && it->second.bWithinFOV)
+  if (pRecord && pRecord->bWithinFOV)
   {
-    return Clock->GetCurrentTime() - it->second.fTimeLastSensed;
+    return m_pOwner->GetWorld()->GetClock()->GetCurrentTime() - pRecord->fTimeLastSensed;
   }
 
   return 0;
@@ -264,8 +291,8 @@ double  Raven_SensoryMemory::GetTimeSinceLastSensed(Raven_Bot* pOpponent)const
 //-----------------------------------------------------------------------------
 void  Raven_SensoryMemory::RenderBoxesAroundRecentlySensed()const
 {
-  std::list<Raven_Bot*> opponents = GetListOfRecentlySensedOpponents();
-  std::list<Raven_Bot*>::const_iterator it;
+  const std::vector<Raven_Bot*>& opponents = GetRecentlySensedOpponents();
+  std::vector<Raven_Bot*>::const_iterator it;
   for (it = opponents.begin(); it != opponents.end(); ++it)
   {
     gdi->OrangePen();
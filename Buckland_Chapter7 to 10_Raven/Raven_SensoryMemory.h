@@ -10,9 +10,8 @@
 //  Desc:
 //
 //-----------------------------------------------------------------------------
-#include <map>
-#include <list>
-#include "2d/vector2d.h"
+#include <vector>
+#include "2D/Vector2D.h"
 
 class Raven_Bot;
 
@@ -40,6 +39,9 @@ public:
   // be used to help hunt down an opponent if it goes out of view
   Vector2D    vLastSensedPosition;
 
+  //the opponent the record is of. (NULL if the record is not in use)
+  Raven_Bot*  pOpponent;
+
   //set to true if opponent is within the field of view of the owner
   bool        bWithinFOV;
 
@@ -51,6 +53,7 @@ public:
   MemoryRecord():fTimeLastSensed(-999),
             fTimeBecameVisible(-999),
             fTimeLastVisible(0),
+            pOpponent(NULL),
             bWithinFOV(false),
             bShootable(false)
   {}
@@ -62,7 +65,7 @@ class Raven_SensoryMemory
 {
 private:
 
-  typedef std::map<Raven_Bot*, MemoryRecord> MemoryMap;
+  typedef std::vector<MemoryRecord> MemoryRecords;
 
 private:
   
@@ -71,8 +74,13 @@ private:
 
   //this container is used to simulate memory of sensory events. A MemoryRecord
   //is created for each opponent in the environment. Each record is updated 
-  //whenever the opponent is encountered. (when it is seen or heard)
-  MemoryMap  m_MemoryMap;
+  //whenever the opponent is encountered. (when it is seen or heard). The
+  //records are indexed by the opponents' slots (see Raven_Bot::Slot)
+  MemoryRecords  m_Records;
+
+  //the opponents found by the last call to GetRecentlySensedOpponents. It is
+  //kept so that the memory need not be allocated again on each call
+  mutable std::vector<Raven_Bot*> m_RecentlySensed;
 
   //a bot has a memory span equivalent to this value. When a bot requests a 
   //list of all recently sensed opponents this value is used to determine if 
@@ -80,9 +88,12 @@ private:
   double      m_dMemorySpan;
 
   //this methods checks to see if there is an existing record for pBot. If
-  //not a new MemoryRecord record is made and added to the memory map.(called
-  //by UpdateWithSoundSource & UpdateVision)
-  void       MakeNewRecordIfNotAlreadyPresent(Raven_Bot* pBot);
+  //not a new MemoryRecord record is made and added to the memory. Either way
+  //the record is returned. (called by UpdateWithSoundSource & UpdateVision)
+  MemoryRecord&       MakeNewRecordIfNotAlreadyPresent(Raven_Bot* pBot);
+
+  //returns the record of the opponent or NULL if there is none
+  const MemoryRecord* GetRecord(const Raven_Bot* pOpponent)const;
 
 public:
 
@@ -106,9 +117,10 @@ public:
   double    GetTimeSinceLastSensed(Raven_Bot* pOpponent)const;
   double    GetTimeOpponentHasBeenOutOfView(Raven_Bot* pOpponent)const;
 
-  //this method returns a list of all the opponents that have had their
-  //records updated within the last m_dMemorySpan seconds.
-  std::list<Raven_Bot*> GetListOfRecentlySensedOpponents()const;
+  //this method returns all the opponents that have had their records
+  //updated within the last m_dMemorySpan seconds. The vector is only valid
+  //until the method is next called
+  const std::vector<Raven_Bot*>& GetRecentlySensedOpponents()const;
 
   void     RenderBoxesAroundRecentlySensed()const;
 
@@ -1,11 +1,11 @@
 #include "Raven_SteeringBehaviors.h"
 #include "Raven_Bot.h"
-#include "2d/Wall2D.h"
-#include "2d/Transformations.h"
+#include "2D/Wall2D.h"
+#include "2D/Transformations.h"
 #include "misc/utils.h"
 #include "misc/Cgdi.h"
 #include "Raven_Game.h"
-#include "2d/geometry.h"
+#include "2D/geometry.h"
 #include "lua/Raven_Scriptor.h"
 #include "Raven_Map.h"
 
@@ -71,10 +71,12 @@ Vector2D Raven_Steering::Calculate()
   //reset the steering force
   m_vSteeringForce.Zero();
 
-  //tag neighbors if any of the following 3 group behaviors are switched on
+  //find the neighbors if any of the group behaviors are switched on
   if (On(separation))
   {
-    m_pWorld->TagRaven_BotsWithinViewRange(m_pRaven_Bot, m_dViewDistance);
+    m_pWorld->GetBotSpace()->QueryRadius(m_pRaven_Bot->Pos(),
+                                         m_dViewDistance,
+                                         m_Neighbors);
   }
 
   m_vSteeringForce = CalculatePrioritized();
@@ -156,7 +158,7 @@ Vector2D Raven_Steering::CalculatePrioritized()
 
   if (On(wall_avoidance))
   {
-    force = WallAvoidance(m_pWorld->GetMap()->GetWalls()) *
+    force = WallAvoidance(m_pWorld->GetMap()->GetWallSpace()) *
             m_dWeightWallAvoidance;
 
     if (!AccumulateForce(m_vSteeringForce, force)) return m_vSteeringForce;
@@ -168,7 +170,7 @@ Vector2D Raven_Steering::CalculatePrioritized()
 
     if (On(separation))
     {
-      force = Separation(m_pWorld->GetAllBots()) * m_dWeightSeparation;
+      force = Separation(m_Neighbors) * m_dWeightSeparation;
 
       if (!AccumulateForce(m_vSteeringForce, force)) return m_vSteeringForce;
     }
@@ -293,10 +295,27 @@ Vector2D Raven_Steering::Wander()
 //  This returns a steering force that will keep the agent away from any
 //  walls it may encounter
 //------------------------------------------------------------------------
-Vector2D Raven_Steering::WallAvoidance(const vector<Wall2D*> &walls)
+Vector2D Raven_Steering::WallAvoidance(const WallSpacePartition& WallSpace)
 {
   //the feelers are contained in a std::vector, m_Feelers
   CreateFeelers();
+
+  //only the walls passing through the box enclosing the feelers can be
+  //intersected by them
+  Vector2D TopLeft     = m_pRaven_Bot->Pos();
+  Vector2D BottomRight = m_pRaven_Bot->Pos();
+
+  for (unsigned int f=0; f<m_Feelers.size(); ++f)
+  {
+    TopLeft.x     = MinOf(TopLeft.x,     m_Feelers[f].x);
+    TopLeft.y     = MinOf(TopLeft.y,     m_Feelers[f].y);
+    BottomRight.x = MaxOf(BottomRight.x, m_Feelers[f].x);
+    BottomRight.y = MaxOf(BottomRight.y, m_Feelers[f].y);
+  }
+
+  WallSpace.QueryBox(TopLeft, BottomRight, m_NearbyWalls);
+
+  const vector<Wall2D*>& walls = m_NearbyWalls;
   
   double DistToThisIP    = 0.0;
   double DistToClosestIP = MaxDouble;
@@ -378,18 +397,18 @@ void Raven_Steering::CreateFeelers()
 //
 // this calculates a force repelling from the other neighbors
 //------------------------------------------------------------------------
-Vector2D Raven_Steering::Separation(const std::list<Raven_Bot*>& neighbors)
+Vector2D Raven_Steering::Separation(const std::vector<Raven_Bot*>& neighbors)
 {  
   //iterate through all the neighbors and calculate the vector from the
   Vector2D SteeringForce;
 
-  std::list<Raven_Bot*>::const_iterator it = neighbors.begin();
+  std::vector<Raven_Bot*>::const_iterator it = neighbors.begin();
   for (it; it != neighbors.end(); ++it)
   {
-    //make sure this agent isn't included in the calculations and that
-    //the agent being examined is close enough. ***also make sure it doesn't
-    //include the evade target ***
-    if((*it != m_pRaven_Bot) && (*it)->IsTagged() &&
+    //make sure this agent isn't included in the calculations. (the
+    //neighbors are already known to be close enough) ***also make sure it
+    //doesn't include the evade target ***
+    if((*it != m_pRaven_Bot) &&
       (*it != m_pTargetAgent1))
     {
       Vector2D ToAgent = m_pRaven_Bot->Pos() - (*it)->Pos();
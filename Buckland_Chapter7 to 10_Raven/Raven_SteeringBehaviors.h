@@ -11,14 +11,15 @@
 //
 //------------------------------------------------------------------------
 #include <vector>
-#include <windows.h>
+#include "misc/Win32Compat.h"
 #include <string>
 #include <list>
-#include "2d/Vector2D.h"
+#include "2D/Vector2D.h"
 #include "constants.h"
 
 class Raven_Bot;
 class Wall2D;
+class WallSpacePartition;
 class BaseGameEntity;
 class Raven_Game;
 
@@ -82,6 +83,13 @@ private:
 
   //a vertex buffer to contain the feelers rqd for wall avoidance  
   std::vector<Vector2D> m_Feelers;
+
+  //the bots within view distance of the owner. Filled each update by
+  //Calculate when separation is switched on
+  std::vector<Raven_Bot*> m_Neighbors;
+
+  //the walls near enough to the feelers to be tested by WallAvoidance
+  std::vector<Wall2D*>    m_NearbyWalls;
   
   //the length of the 'feeler/s' used in wall detection
   double                 m_dWallDetectionFeelerLength;
@@ -157,10 +165,10 @@ private:
 
   //this returns a steering force which will keep the agent away from any
   //walls it may encounter
-  Vector2D WallAvoidance(const std::vector<Wall2D*> &walls);
+  Vector2D WallAvoidance(const WallSpacePartition& WallSpace);
 
   
-  Vector2D Separation(const std::list<Raven_Bot*> &agents);
+  Vector2D Separation(const std::vector<Raven_Bot*> &agents);
 
 
     /* .......................................................
@@ -20,11 +20,11 @@ void Raven_TargetingSystem::Update()
   double ClosestDistSoFar = MaxDouble;
   m_pCurrentTarget       = 0;
 
-  //grab a list of all the opponents the owner can sense
-  std::list<Raven_Bot*> SensedBots;
-  SensedBots = m_pOwner->GetSensoryMem()->GetListOfRecentlySensedOpponents();
+  //grab all the opponents the owner can sense
+  const std::vector<Raven_Bot*>& SensedBots =
+                             m_pOwner->GetSensoryMem()->GetRecentlySensedOpponents();
   
-  std::list<Raven_Bot*>::const_iterator curBot = SensedBots.begin();
+  std::vector<Raven_Bot*>::const_iterator curBot = SensedBots.begin();
   for (curBot; curBot != SensedBots.end(); ++curBot)
   {
     //make sure the bot is alive and that it is not the owner
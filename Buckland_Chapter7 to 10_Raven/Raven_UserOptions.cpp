@@ -1,10 +1,10 @@
 #include "Raven_UserOptions.h"
+#include "Raven_WorldContext.h"
 
  
 Raven_UserOptions* Raven_UserOptions::Instance()
 {
-  static Raven_UserOptions instance; 
-  return &instance;
+  return Raven_WorldContext::Current()->GetUserOptions();
 }
 
 Raven_UserOptions::Raven_UserOptions():m_bShowGraph(false),
@@ -6,7 +6,9 @@
 //
 //  Author: Mat Buckland (www.ai-junkie.com)
 //
-//  Desc:   singleton class to control a number of menu options
+//  Desc:   class to control a number of menu options. Each world context
+//          owns one; UserOptions refers to the instance belonging to the
+//          context current on the calling thread.
 //-----------------------------------------------------------------------------
 
 
@@ -16,6 +18,8 @@ class Raven_UserOptions
 {
 private:
 
+  friend class Raven_WorldContext;
+
   Raven_UserOptions();
 
   //copy ctor and assignment should be private
@@ -25,6 +29,7 @@ private:
 
 public:
 
+  //returns the options of the current world context
   static Raven_UserOptions* Instance();
   
   bool m_bShowGraph;
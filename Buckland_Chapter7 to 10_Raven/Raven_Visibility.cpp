@@ -0,0 +1,194 @@
+#include "Raven_Visibility.h"
+#include "Raven_Game.h"
+#include "Raven_Map.h"
+#include "Raven_Bot.h"
+
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+Raven_Visibility::Raven_Visibility(const Raven_Game* world,
+                                   int               NumThreads):m_pWorld(world),
+                                                                 m_iNumThreads(NumThreads),
+                                                                 m_pWalls(NULL),
+                                                                 m_iNextSlot(0),
+                                                                 m_iUpdateCount(0),
+                                                                 m_iNumHelping(0),
+                                                                 m_iNumBusy(0),
+                                                                 m_bShuttingDown(false)
+{
+  if (m_iNumThreads <= 0) m_iNumThreads = (int)std::thread::hardware_concurrency();
+  if (m_iNumThreads <= 0) m_iNumThreads = 1;
+}
+
+//------------------------------- dtor ----------------------------------------
+//-----------------------------------------------------------------------------
+Raven_Visibility::~Raven_Visibility()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    m_bShuttingDown = true;
+  }
+
+  m_UpdatePending.notify_all();
+
+  for (unsigned int w=0; w<m_Workers.size(); ++w)
+  {
+    m_Workers[w].join();
+  }
+}
+
+//------------------------------- Clear ---------------------------------------
+//-----------------------------------------------------------------------------
+void Raven_Visibility::Clear()
+{
+  m_Bots.clear();
+  m_Positions.clear();
+  m_LOS.clear();
+}
+
+//------------------------------- CastRays ------------------------------------
+//-----------------------------------------------------------------------------
+void Raven_Visibility::CastRays()
+{
+  const int n = m_Bots.size();
+
+  //each pair is written by the thread that takes the first of its slots so
+  //no two threads ever write the same element
+  for (int i = m_iNextSlot++; i < n; i = m_iNextSlot++)
+  {
+    if (!m_Bots[i]) continue;
+
+    for (int j=i+1; j<n; ++j)
+    {
+      if (!m_Bots[j]) continue;
+
+      char LOS = !doWallsObstructLineSegment(m_Positions[i],
+                                             m_Positions[j],
+                                             *m_pWalls);
+
+      m_LOS[i*n + j] = LOS;
+      m_LOS[j*n + i] = LOS;
+    }
+  }
+}
+
+//------------------------------ RunWorker ------------------------------------
+//
+//  each worker waits for an update it is needed for, helps cast its rays,
+//  then waits for the next
+//-----------------------------------------------------------------------------
+void Raven_Visibility::RunWorker(Raven_Visibility* pTable,
+                                 int               index,
+                                 unsigned int      FirstUpdate)
+{
+  std::unique_lock<std::mutex> lock(pTable->m_Lock);
+
+  unsigned int LastUpdate = FirstUpdate;
+
+  while (true)
+  {
+    while (!pTable->m_bShuttingDown &&
+           (pTable->m_iUpdateCount == LastUpdate || index >= pTable->m_iNumHelping))
+    {
+      LastUpdate = pTable->m_iUpdateCount;
+
+      pTable->m_UpdatePending.wait(lock);
+    }
+
+    if (pTable->m_bShuttingDown) return;
+
+    LastUpdate = pTable->m_iUpdateCount;
+
+    lock.unlock();
+
+    pTable->CastRays();
+
+    lock.lock();
+
+    if (--pTable->m_iNumBusy == 0) pTable->m_UpdateFinished.notify_one();
+  }
+}
+
+//------------------------------- Update --------------------------------------
+//-----------------------------------------------------------------------------
+void Raven_Visibility::Update()
+{
+  const int n = m_pWorld->GetNumBotSlots();
+
+  m_Bots.assign(n, (Raven_Bot*)NULL);
+  m_Positions.assign(n, Vector2D());
+  m_LOS.assign(n*n, 0);
+
+  const std::list<Raven_Bot*>& bots = m_pWorld->GetAllBots();
+
+  std::list<Raven_Bot*>::const_iterator curBot = bots.begin();
+  for (curBot; curBot != bots.end(); ++curBot)
+  {
+    m_Bots[(*curBot)->Slot()]      = *curBot;
+    m_Positions[(*curBot)->Slot()] = (*curBot)->Pos();
+  }
+
+  const int NumBots    = bots.size();
+  const int NumRays    = NumBots * (NumBots-1) / 2;
+  const int NumThreads = MinOf(m_iNumThreads, MaxOf(1, NumRays / min_rays_per_thread));
+
+  m_pWalls    = &m_pWorld->GetMap()->GetWallSpace();
+  m_iNextSlot = 0;
+
+  //too few rays to be worth sharing
+  if (NumThreads == 1)
+  {
+    CastRays();
+
+    return;
+  }
+
+  //the calling thread does its share of the work too, so it is helped by
+  //one worker fewer than the number of threads
+  while ((int)m_Workers.size() < m_iNumThreads-1)
+  {
+    m_Workers.push_back(std::thread(RunWorker,
+                                    this,
+                                    (int)m_Workers.size(),
+                                    m_iUpdateCount));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    ++m_iUpdateCount;
+
+    m_iNumHelping = NumThreads-1;
+    m_iNumBusy    = NumThreads-1;
+  }
+
+  m_UpdatePending.notify_all();
+
+  CastRays();
+
+  std::unique_lock<std::mutex> lock(m_Lock);
+
+  while (m_iNumBusy > 0) m_UpdateFinished.wait(lock);
+}
+
+//------------------------------ isInTable ------------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_Visibility::isInTable(const Raven_Bot* pBot)const
+{
+  return pBot->Slot() < (int)m_Bots.size() && m_Bots[pBot->Slot()] == pBot;
+}
+
+//------------------------------ isLOSOkay ------------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_Visibility::isLOSOkay(const Raven_Bot* pFirst,
+                                 const Raven_Bot* pSecond)const
+{
+  if (!isInTable(pFirst) || !isInTable(pSecond))
+  {
+    return m_pWorld->isLOSOkay(pFirst->Pos(), pSecond->Pos());
+  }
+
+  return isLOSOkay(pFirst->Slot(), pSecond->Slot());
+}
@@ -0,0 +1,127 @@
+#ifndef RAVEN_VISIBILITY_H
+#define RAVEN_VISIBILITY_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   Raven_Visibility.h
+//
+//  Desc:   holds whether there is line of sight between each pair of bots
+//          in the game. Sight is symmetrical so a ray is cast once for each
+//          pair, rather than once by each bot of the pair, and the rays may
+//          be shared between a number of threads. The threads are started
+//          the first time there are enough rays to share and then wait
+//          between updates until the table is destroyed.
+//
+//          The game updates the table once per vision update, just before
+//          the bots update their sensory memories from it. Between updates
+//          the table tells whether there was line of sight when it was last
+//          updated. Bots added since then are not in the table.
+//
+//          The table is indexed by the bots' slots (see Raven_Bot::Slot).
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "2D/Vector2D.h"
+
+class Raven_Bot;
+class Raven_Game;
+class WallSpacePartition;
+
+
+class Raven_Visibility
+{
+private:
+
+  const Raven_Game*                m_pWorld;
+
+  //the bot in each slot when the table was updated (NULL if the slot was
+  //empty)
+  std::vector<Raven_Bot*>          m_Bots;
+
+  //the position of each bot when the table was updated
+  std::vector<Vector2D>            m_Positions;
+
+  //true if there is line of sight between the bots of index i and j. Both
+  //m_LOS[i*n+j] and m_LOS[j*n+i] are set
+  std::vector<char>                m_LOS;
+
+  int                              m_iNumThreads;
+
+  //each thread is given at least this many rays to cast. Waking a thread
+  //costs more than casting a few rays
+  enum {min_rays_per_thread = 256};
+
+  //the threads that help the calling thread cast the rays (empty until an
+  //update has enough rays to share)
+  std::vector<std::thread>         m_Workers;
+
+  //the walls the rays of the current update are cast against
+  const WallSpacePartition*        m_pWalls;
+
+  //the slot whose rays are cast next in the current update
+  std::atomic<int>                 m_iNextSlot;
+
+  //guards the members below
+  std::mutex                       m_Lock;
+
+  std::condition_variable          m_UpdatePending;
+  std::condition_variable          m_UpdateFinished;
+
+  //incremented each time the workers are given an update to help with
+  unsigned int                     m_iUpdateCount;
+
+  //the number of workers helping with the current update, and the number
+  //of those still casting rays
+  int                              m_iNumHelping;
+  int                              m_iNumBusy;
+
+  bool                             m_bShuttingDown;
+
+  //the body of each worker thread. The worker of the given index helps
+  //with each update after the FirstUpdate-th that needs more than that
+  //many workers
+  static void  RunWorker(Raven_Visibility* pTable,
+                         int               index,
+                         unsigned int      FirstUpdate);
+
+  //repeatedly takes the next slot and casts the rays from its bot to the
+  //bots in the slots after it until there are none left
+  void         CastRays();
+
+  Raven_Visibility(const Raven_Visibility&);
+  Raven_Visibility& operator=(const Raven_Visibility&);
+
+public:
+
+  //if NumThreads is zero one thread is used per core
+  Raven_Visibility(const Raven_Game* world, int NumThreads);
+
+  ~Raven_Visibility();
+
+  //casts the rays between every pair of the world's bots
+  void  Update();
+
+  //empties the table. It must be called before a bot is deleted
+  void  Clear();
+
+  int         NumSlots()const{return m_Bots.size();}
+  Raven_Bot*  GetBot(int slot)const{return m_Bots[slot];}
+
+  //returns true if the bot is in the table
+  bool        isInTable(const Raven_Bot* pBot)const;
+
+  bool        isLOSOkay(int slot1, int slot2)const{return m_LOS[slot1*m_Bots.size() + slot2] != 0;}
+
+  //returns true if there was line of sight between the bots when the table
+  //was updated. If either bot is not in the table a ray is cast between
+  //their current positions instead
+  bool        isLOSOkay(const Raven_Bot* pFirst, const Raven_Bot* pSecond)const;
+};
+
+
+
+#endif
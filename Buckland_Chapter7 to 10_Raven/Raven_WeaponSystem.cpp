@@ -7,14 +7,15 @@
 #include "misc/utils.h"
 #include "lua/Raven_Scriptor.h"
 #include "Raven_Game.h"
+#include "Raven_WorldContext.h"
 #include "Raven_UserOptions.h"
-#include "2D/transformations.h"
+#include "2D/Transformations.h"
 #include "fuzzy/FuzzyOperators.h"
 #include "Weapon_Knife.h"
 
 //uncomment to write object creation/deletion to debug console
 #define  LOG_CREATIONAL_STUFF
-#include "debug/DebugConsole.h"
+#include "Debug/DebugConsole.h"
 
 //------------------------- ctor ----------------------------------------------
 //-----------------------------------------------------------------------------
@@ -26,9 +27,57 @@ Raven_WeaponSystem::Raven_WeaponSystem(Raven_Bot* owner,
                                                           m_dAimAccuracy(AimAccuracy),
                                                           m_dAimPersistance(AimPersistance)
 {
+  m_pAimRules = GetAimRules();
+
+  if (!m_pAimRules->table.isBaked())
+  {
+    m_pAimRules->module.InitDOMs(m_AimDOMs);
+  }
+
   Initialize();
 }
 
+//----------------------------- GetAimRules -----------------------------------
+//-----------------------------------------------------------------------------
+const Raven_WeaponSystem::AimRules* Raven_WeaponSystem::GetAimRules()const
+{
+  Raven_FuzzyRuleBases* RuleBases = m_pOwner->GetWorld()->GetContext()->GetFuzzyRuleBases();
+
+  if (RuleBases->GetAimRules()) return RuleBases->GetAimRules();
+
+  AimRules* rules = new AimRules();
+
+  //the module is only needed while it is compiled
+  FuzzyModule fm;
+
+  InitializeFuzzyModule(fm);
+
+  rules->module.Compile(fm);
+
+  rules->DistToTargetFLV = rules->module.GetVariable("DistToTarget");
+  rules->VelocityFLV     = rules->module.GetVariable("Velocity");
+  rules->TimeVisibleFLV  = rules->module.GetVariable("TimeVisible");
+  rules->DeviationFLV    = rules->module.GetVariable("Deviation");
+
+  int resolution = script->GetInt("FuzzyLookupResolution");
+
+  if (resolution > 0)
+  {
+    rules->table.AddInput(rules->DistToTargetFLV);
+    rules->table.AddInput(rules->VelocityFLV);
+    rules->table.AddInput(rules->TimeVisibleFLV);
+
+    rules->table.Bake(rules->module, rules->DeviationFLV, resolution);
+
+    //always reported: the table is only worth using if this is small
+    debug_con << "Aim deviation table max error: " << rules->table.GetMaxError() << "";
+  }
+
+  RuleBases->SetAimRules(rules);
+
+  return rules;
+}
+
 //------------------------- dtor ----------------------------------------------
 //-----------------------------------------------------------------------------
 Raven_WeaponSystem::~Raven_WeaponSystem()
@@ -64,8 +113,6 @@ void Raven_WeaponSystem::Initialize()
   m_WeaponMap[type_knife]			= 0;
 
   AddWeapon(type_knife);
-
-  InitializeFuzzyModule();
 }
 
 //-------------------------------- SelectWeapon -------------------------------
@@ -265,66 +312,66 @@ void Raven_WeaponSystem::TakeAimAndShoot()
   }
 }
 
-void Raven_WeaponSystem::InitializeFuzzyModule(){
-  FuzzyVariable& DistToTarget = m_FuzzyModuleAim.CreateFLV("DistToTarget");
-  FzSet& Target_Close = DistToTarget.AddLeftShoulderSet("Target_Close", 0, 15, 45);
-  FzSet& Target_Medium = DistToTarget.AddTriangularSet("Target_Medium", 15, 75, 150);
-  FzSet& Target_Far = DistToTarget.AddRightShoulderSet("Target_Far", 75, 150, 10000);
+void Raven_WeaponSystem::InitializeFuzzyModule(FuzzyModule& fm){
+  FuzzyVariable& DistToTarget = fm.CreateFLV("DistToTarget");
+  FzSet  Target_Close = DistToTarget.AddLeftShoulderSet("Target_Close", 0, 15, 45);
+  FzSet  Target_Medium = DistToTarget.AddTriangularSet("Target_Medium", 15, 75, 150);
+  FzSet  Target_Far = DistToTarget.AddRightShoulderSet("Target_Far", 75, 150, 10000);
   
-  FuzzyVariable& TimeVisible = m_FuzzyModuleAim.CreateFLV("TimeVisible");
-  FzSet& TimeVisible_fast = TimeVisible.AddRightShoulderSet("TimeVisible_fast", 4, 6, 100);
-  FzSet& TimeVisible_medium = TimeVisible.AddTriangularSet("TimeVisible_medium", 2, 4, 6);
-  FzSet& TimeVisible_slow = TimeVisible.AddLeftShoulderSet("TimeVisible_slow", 0, 2, 4);
+  FuzzyVariable& TimeVisible = fm.CreateFLV("TimeVisible");
+  FzSet  TimeVisible_fast = TimeVisible.AddRightShoulderSet("TimeVisible_fast", 4, 6, 100);
+  FzSet  TimeVisible_medium = TimeVisible.AddTriangularSet("TimeVisible_medium", 2, 4, 6);
+  FzSet  TimeVisible_slow = TimeVisible.AddLeftShoulderSet("TimeVisible_slow", 0, 2, 4);
 
-  FuzzyVariable& Velocity = m_FuzzyModuleAim.CreateFLV("Velocity");
-  FzSet& Velocity_fast = Velocity.AddRightShoulderSet("Velocity_fast", 75, 150, 300);
-  FzSet& Velocity_medium = Velocity.AddTriangularSet("Velocity_medium", 15, 75, 150);
-  FzSet& Velocity_slow = Velocity.AddLeftShoulderSet("Velocity_slow", 0, 15, 45);
+  FuzzyVariable& Velocity = fm.CreateFLV("Velocity");
+  FzSet  Velocity_fast = Velocity.AddRightShoulderSet("Velocity_fast", 75, 150, 300);
+  FzSet  Velocity_medium = Velocity.AddTriangularSet("Velocity_medium", 15, 75, 150);
+  FzSet  Velocity_slow = Velocity.AddLeftShoulderSet("Velocity_slow", 0, 15, 45);
 
-  FuzzyVariable& Deviation = m_FuzzyModuleAim.CreateFLV("Deviation"); 
-  FzSet& BigDeviation = Deviation.AddRightShoulderSet("BigDeviation", 0.15, 0.25, 0.3);
-  FzSet& DeviationMedium = Deviation.AddTriangularSet("DeviationMedium", 0.05, 0.15, 0.2);
-  FzSet& SmallDeviation = Deviation.AddLeftShoulderSet("SmallDeviation", 0, 0.05, 0.1);
+  FuzzyVariable& Deviation = fm.CreateFLV("Deviation"); 
+  FzSet  BigDeviation = Deviation.AddRightShoulderSet("BigDeviation", 0.15, 0.25, 0.3);
+  FzSet  DeviationMedium = Deviation.AddTriangularSet("DeviationMedium", 0.05, 0.15, 0.2);
+  FzSet  SmallDeviation = Deviation.AddLeftShoulderSet("SmallDeviation", 0, 0.05, 0.1);
 
 
   // Target Close //
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_fast, Velocity_fast ), BigDeviation);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_fast, Velocity_medium ), BigDeviation );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_fast, Velocity_slow ), DeviationMedium );
+  fm.AddRule(FzAND(Target_Close, TimeVisible_fast, Velocity_fast ), BigDeviation);
+  fm.AddRule(FzAND(Target_Close, TimeVisible_fast, Velocity_medium ), BigDeviation );
+  fm.AddRule(FzAND(Target_Close, TimeVisible_fast, Velocity_slow ), DeviationMedium );
 
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_medium, Velocity_fast ), BigDeviation);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_medium, Velocity_medium ), DeviationMedium );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_medium, Velocity_slow ), SmallDeviation );
+  fm.AddRule(FzAND(Target_Close, TimeVisible_medium, Velocity_fast ), BigDeviation);
+  fm.AddRule(FzAND(Target_Close, TimeVisible_medium, Velocity_medium ), DeviationMedium );
+  fm.AddRule(FzAND(Target_Close, TimeVisible_medium, Velocity_slow ), SmallDeviation );
 
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_slow, Velocity_fast ), DeviationMedium);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_slow, Velocity_medium ), SmallDeviation );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Close, TimeVisible_slow, Velocity_slow ), SmallDeviation );
+  fm.AddRule(FzAND(Target_Close, TimeVisible_slow, Velocity_fast ), DeviationMedium);
+  fm.AddRule(FzAND(Target_Close, TimeVisible_slow, Velocity_medium ), SmallDeviation );
+  fm.AddRule(FzAND(Target_Close, TimeVisible_slow, Velocity_slow ), SmallDeviation );
 
   // Target Medium
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_fast, Velocity_fast ), BigDeviation);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_fast, Velocity_medium ), BigDeviation );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_fast, Velocity_slow ), DeviationMedium );
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_fast, Velocity_fast ), BigDeviation);
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_fast, Velocity_medium ), BigDeviation );
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_fast, Velocity_slow ), DeviationMedium );
 
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_medium, Velocity_fast ), BigDeviation);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_medium, Velocity_medium ), DeviationMedium );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_medium, Velocity_slow ), SmallDeviation );
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_medium, Velocity_fast ), BigDeviation);
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_medium, Velocity_medium ), DeviationMedium );
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_medium, Velocity_slow ), SmallDeviation );
 
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_slow, Velocity_fast ), DeviationMedium);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_slow, Velocity_medium ), SmallDeviation );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Medium, TimeVisible_slow, Velocity_slow ), SmallDeviation );
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_slow, Velocity_fast ), DeviationMedium);
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_slow, Velocity_medium ), SmallDeviation );
+  fm.AddRule(FzAND(Target_Medium, TimeVisible_slow, Velocity_slow ), SmallDeviation );
 
   //Target Far
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_fast, Velocity_fast ), BigDeviation);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_fast, Velocity_medium ), BigDeviation );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_fast, Velocity_slow ), DeviationMedium );
+  fm.AddRule(FzAND(Target_Far, TimeVisible_fast, Velocity_fast ), BigDeviation);
+  fm.AddRule(FzAND(Target_Far, TimeVisible_fast, Velocity_medium ), BigDeviation );
+  fm.AddRule(FzAND(Target_Far, TimeVisible_fast, Velocity_slow ), DeviationMedium );
 
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_medium, Velocity_fast ), BigDeviation);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_medium, Velocity_medium ), DeviationMedium );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_medium, Velocity_slow ), SmallDeviation );
+  fm.AddRule(FzAND(Target_Far, TimeVisible_medium, Velocity_fast ), BigDeviation);
+  fm.AddRule(FzAND(Target_Far, TimeVisible_medium, Velocity_medium ), DeviationMedium );
+  fm.AddRule(FzAND(Target_Far, TimeVisible_medium, Velocity_slow ), SmallDeviation );
 
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_slow, Velocity_fast ), DeviationMedium);
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_slow, Velocity_medium ), DeviationMedium );
-  m_FuzzyModuleAim.AddRule(FzAND(Target_Far, TimeVisible_slow, Velocity_slow ), DeviationMedium );
+  fm.AddRule(FzAND(Target_Far, TimeVisible_slow, Velocity_fast ), DeviationMedium);
+  fm.AddRule(FzAND(Target_Far, TimeVisible_slow, Velocity_medium ), DeviationMedium );
+  fm.AddRule(FzAND(Target_Far, TimeVisible_slow, Velocity_slow ), DeviationMedium );
   
 }
 
@@ -335,11 +382,22 @@ double Raven_WeaponSystem::GetPrecision(double distToTarget, Vector2D velocity,
 {
 	speed = sqrt(std::pow(velocity.x, 2) + std::pow(velocity.y, 2));
 
-	m_FuzzyModuleAim.Fuzzify("DistToTarget", distToTarget);
-	m_FuzzyModuleAim.Fuzzify("Velocity", speed);
-	m_FuzzyModuleAim.Fuzzify("TimeVisible", timeVisibility);
+	if (m_pAimRules->table.isBaked())
+	{
+		double inputs[3] = {distToTarget, speed, timeVisibility};
+
+		m_dLastDeviationScore = m_pAimRules->table.Lookup(inputs);
+
+		return m_dLastDeviationScore;
+	}
+
+	m_pAimRules->module.Fuzzify(m_AimDOMs, m_pAimRules->DistToTargetFLV, distToTarget);
+	m_pAimRules->module.Fuzzify(m_AimDOMs, m_pAimRules->VelocityFLV, speed);
+	m_pAimRules->module.Fuzzify(m_AimDOMs, m_pAimRules->TimeVisibleFLV, timeVisibility);
 
-	m_dLastDeviationScore = m_FuzzyModuleAim.DeFuzzify("Deviation", FuzzyModule::max_av);
+	m_dLastDeviationScore = m_pAimRules->module.DeFuzzify(m_AimDOMs,
+	                                                     m_pAimRules->DeviationFLV,
+	                                                     FuzzyModule::max_av);
 
 	return m_dLastDeviationScore;
 }
@@ -12,8 +12,9 @@
 //
 //-----------------------------------------------------------------------------
 #include <map>
-#include "2d/vector2d.h"
-#include "fuzzy\FuzzyModule.h";
+#include "2D/Vector2D.h"
+#include "fuzzy/FuzzyModule.h";
+#include "armory/Raven_FuzzyRuleBases.h"
 
 class Raven_Bot;
 class Raven_Weapon;
@@ -62,12 +63,20 @@ private:
   //rads
   void        AddNoiseToAim(Vector2D& AimingPos, double precision)const;
 
-  //fuzzy logic is used to determine the desirability of a weapon. Each weapon
-  //owns its own instance of a fuzzy module because each has a different rule 
-  //set for inferring desirability.
-  FuzzyModule m_FuzzyModuleAim;
+  //fuzzy logic is used to determine the precision of the aim. Every bot
+  //aims by the same rules so they are built and compiled once per world,
+  //the first time they are needed, and shared by all its weapon systems
+  typedef Raven_FuzzyRuleBases::AimRules AimRules;
 
-  void	InitializeFuzzyModule();
+  //returns the world's shared rules, building them on the first call
+  const AimRules*  GetAimRules()const;
+
+  const AimRules*            m_pAimRules;
+
+  //the DOMs of the shared module's sets (left empty if the table is used)
+  CompiledFuzzyModule::DOMs  m_AimDOMs;
+
+  static void	InitializeFuzzyModule(FuzzyModule& fm);
 
   double  GetPrecision(double distToTarget, Vector2D velocity, double timeVisibility);
   double  m_dLastDeviationScore;
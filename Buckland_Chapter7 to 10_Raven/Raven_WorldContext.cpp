@@ -0,0 +1,33 @@
+#include "Raven_WorldContext.h"
+#include "lua/Raven_Scriptor.h"
+#include "Raven_UserOptions.h"
+#include "armory/Raven_FuzzyRuleBases.h"
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+Raven_WorldContext::Raven_WorldContext():m_pScriptor(new Raven_Scriptor()),
+                                         m_pUserOptions(new Raven_UserOptions()),
+                                         m_pFuzzyRuleBases(new Raven_FuzzyRuleBases())
+{}
+
+//------------------------------- dtor ----------------------------------------
+//-----------------------------------------------------------------------------
+Raven_WorldContext::~Raven_WorldContext()
+{
+  delete m_pFuzzyRuleBases;
+  delete m_pUserOptions;
+  delete m_pScriptor;
+}
+
+
+//----------------------- GetDefaultWorldContext ------------------------------
+//
+//  the context used on any thread that has no scope open
+//-----------------------------------------------------------------------------
+WorldContext* GetDefaultWorldContext()
+{
+  static Raven_WorldContext instance;
+
+  return &instance;
+}
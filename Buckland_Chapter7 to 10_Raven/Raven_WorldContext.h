@@ -0,0 +1,53 @@
+#ifndef RAVEN_WORLD_CONTEXT_H
+#define RAVEN_WORLD_CONTEXT_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   Raven_WorldContext.h
+//
+//  Desc:   the world context used by Raven. In addition to the objects held
+//          by WorldContext it owns the scriptor (and therefore the Lua state
+//          Params.lua is loaded into) and the user options, so the script
+//          and UserOptions macros also resolve per world, and the fuzzy rule
+//          bases shared by the world's weapons.
+//
+//          Every Raven_Game owns one of these and makes it current while
+//          its methods run.
+//-----------------------------------------------------------------------------
+#include "Game/WorldContext.h"
+
+class Raven_Scriptor;
+class Raven_UserOptions;
+class Raven_FuzzyRuleBases;
+
+
+class Raven_WorldContext : public WorldContext
+{
+private:
+
+  Raven_Scriptor*    m_pScriptor;
+  Raven_UserOptions* m_pUserOptions;
+
+  Raven_FuzzyRuleBases* m_pFuzzyRuleBases;
+
+public:
+
+  Raven_WorldContext();
+  ~Raven_WorldContext();
+
+  //returns the context current on the calling thread. (every context in
+  //a Raven process is a Raven_WorldContext)
+  static Raven_WorldContext* Current()
+  {
+    return static_cast<Raven_WorldContext*>(WorldContext::Current());
+  }
+
+  Raven_Scriptor*    GetScriptor()const{return m_pScriptor;}
+  Raven_UserOptions* GetUserOptions()const{return m_pUserOptions;}
+
+  Raven_FuzzyRuleBases* GetFuzzyRuleBases()const{return m_pFuzzyRuleBases;}
+};
+
+
+
+#endif
@@ -8,7 +8,7 @@
 #include "fuzzy/FuzzyOperators.h"
 
 #include "Raven_Messages.h"
-#include "Messaging\MessageDispatcher.h"
+#include "Messaging/MessageDispatcher.h"
 
 
 //--------------------------- ctor --------------------------------------------
@@ -40,7 +40,7 @@ Knife::Knife(Raven_Bot*   owner):
   }
 
   //setup the fuzzy module
-  InitializeFuzzyModule();
+  ShareFuzzyRules("DistanceToTarget", "");
 
 }
 
@@ -63,11 +63,7 @@ inline void Knife::ShootAt(Vector2D pos)
 inline double Knife::GetDesirability(double DistToTarget)
 {
 
-    //fuzzify distance and amount of ammo
-    m_FuzzyModule.Fuzzify("DistanceToTarget", DistToTarget);
-    //m_FuzzyModule.Fuzzify("AmmoStatus", (double)m_iNumRoundsLeft);
-
-    m_dLastDesirabilityScore = m_FuzzyModule.DeFuzzify("Desirability", FuzzyModule::max_av);
+    m_dLastDesirabilityScore = InferDesirability(DistToTarget);
 
   return m_dLastDesirabilityScore;
 }
@@ -76,23 +72,23 @@ inline double Knife::GetDesirability(double DistToTarget)
 //
 //  set up some fuzzy variables and rules
 //-----------------------------------------------------------------------------
-void Knife::InitializeFuzzyModule()
+void Knife::InitializeFuzzyModule(FuzzyModule& fm)
 {  
-  FuzzyVariable& DistanceToTarget = m_FuzzyModule.CreateFLV("DistanceToTarget");
+  FuzzyVariable& DistanceToTarget = fm.CreateFLV("DistanceToTarget");
 
-  FzSet& Target_Close = DistanceToTarget.AddLeftShoulderSet("Target_Close", 0, 15, 30);
-  FzSet& Target_Medium = DistanceToTarget.AddTriangularSet("Target_Medium", 15, 150, 300);
-  FzSet& Target_Far = DistanceToTarget.AddRightShoulderSet("Target_Far", 150, 300, 1000);
+  FzSet  Target_Close = DistanceToTarget.AddLeftShoulderSet("Target_Close", 0, 15, 30);
+  FzSet  Target_Medium = DistanceToTarget.AddTriangularSet("Target_Medium", 15, 150, 300);
+  FzSet  Target_Far = DistanceToTarget.AddRightShoulderSet("Target_Far", 150, 300, 1000);
 
-  FuzzyVariable& Desirability = m_FuzzyModule.CreateFLV("Desirability");
+  FuzzyVariable& Desirability = fm.CreateFLV("Desirability");
   
-  FzSet& VeryDesirable = Desirability.AddRightShoulderSet("VeryDesirable", 50, 75, 100);
-  FzSet& Desirable = Desirability.AddTriangularSet("Desirable", 25, 50, 75);
-  FzSet& Undesirable = Desirability.AddLeftShoulderSet("Undesirable", 0, 25, 50);
+  FzSet  VeryDesirable = Desirability.AddRightShoulderSet("VeryDesirable", 50, 75, 100);
+  FzSet  Desirable = Desirability.AddTriangularSet("Desirable", 25, 50, 75);
+  FzSet  Undesirable = Desirability.AddLeftShoulderSet("Undesirable", 0, 25, 50);
 
-  m_FuzzyModule.AddRule(Target_Close, VeryDesirable);
-  m_FuzzyModule.AddRule(Target_Medium, FzVery(Undesirable));
-  m_FuzzyModule.AddRule(Target_Far, FzVery(Undesirable));
+  fm.AddRule(Target_Close, VeryDesirable);
+  fm.AddRule(Target_Medium, FzVery(Undesirable));
+  fm.AddRule(Target_Far, FzVery(Undesirable));
 }
 
 //-------------------------------- Render -------------------------------------
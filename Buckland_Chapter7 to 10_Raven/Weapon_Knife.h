@@ -9,7 +9,7 @@
 //
 //  Desc:   class to implement a shot gun
 //-----------------------------------------------------------------------------
-#include "armory\Raven_Weapon.h"
+#include "armory/Raven_Weapon.h"
 
 
 class  Raven_Bot;
@@ -20,7 +20,7 @@ class Knife : public Raven_Weapon
 {
 private:
 
-  void     InitializeFuzzyModule();
+  void     InitializeFuzzyModule(FuzzyModule& fm);
 
 
 public:
@@ -1,11 +1,11 @@
 #include "Projectile_Pellet.h"
 #include "../lua/Raven_Scriptor.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 #include "../Raven_Bot.h"
 #include "../Raven_Game.h"
-#include "game/EntityFunctionTemplates.h"
+#include "Game/EntityFunctionTemplates.h"
 #include "../constants.h"
-#include "2d/WallIntersectionTests.h"
+#include "2D/WallIntersectionTests.h"
 #include "../Raven_Map.h"
 #include <list>
 
@@ -79,7 +79,7 @@ void Pellet::TestForImpact()
                                           m_vPosition,
                                           DistToClosestImpact,
                                           m_vImpactPoint,
-                                          m_pWorld->GetMap()->GetWalls());
+                                          m_pWorld->GetMap()->GetWallSpace());
 
   //test to see if the ray between the current position of the shell and 
   //the start position intersects with any bots.
@@ -1,10 +1,10 @@
 #include "Projectile_Rocket.h"
 #include "../lua/Raven_Scriptor.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 #include "../Raven_Bot.h"
 #include "../Raven_Game.h"
 #include "../constants.h"
-#include "2d/WallIntersectionTests.h"
+#include "2D/WallIntersectionTests.h"
 #include "../Raven_Map.h"
 
 #include "../Raven_Messages.h"
@@ -98,7 +98,7 @@ void Rocket::TestForImpact()
                                                  m_vPosition,
                                                  dist,
                                                  m_vImpactPoint,
-                                                 m_pWorld->GetMap()->GetWalls()))
+                                                 m_pWorld->GetMap()->GetWallSpace()))
      {
         m_bImpacted = true;
       
@@ -128,21 +128,21 @@ void Rocket::TestForImpact()
 //-----------------------------------------------------------------------------
 void Rocket::InflictDamageOnBotsWithinBlastRadius()
 {
-  std::list<Raven_Bot*>::const_iterator curBot = m_pWorld->GetAllBots().begin();
+  std::vector<Raven_Bot*> BotsInBlast;
 
-  for (curBot; curBot != m_pWorld->GetAllBots().end(); ++curBot)
+  m_pWorld->GetBotSpace()->QueryRadius(Pos(), m_dBlastRadius, BotsInBlast);
+
+  std::vector<Raven_Bot*>::const_iterator curBot = BotsInBlast.begin();
+
+  for (curBot; curBot != BotsInBlast.end(); ++curBot)
   {
-    if (Vec2DDistance(Pos(), (*curBot)->Pos()) < m_dBlastRadius + (*curBot)->BRadius())
-    {
-      //send a message to the bot to let it know it's been hit, and who the
-      //shot came from
-      Dispatcher->DispatchMsg(SEND_MSG_IMMEDIATELY,
-                              m_iShooterID,
-                              (*curBot)->ID(),
-                              Msg_TakeThatMF,
-                              (void*)&m_iDamageInflicted);
-      
-    }
+    //send a message to the bot to let it know it's been hit, and who the
+    //shot came from
+    Dispatcher->DispatchMsg(SEND_MSG_IMMEDIATELY,
+                            m_iShooterID,
+                            (*curBot)->ID(),
+                            Msg_TakeThatMF,
+                            (void*)&m_iDamageInflicted);
   }  
 }
 
@@ -0,0 +1,126 @@
+#ifndef RAVEN_FUZZY_RULE_BASES_H
+#define RAVEN_FUZZY_RULE_BASES_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   Raven_FuzzyRuleBases.h
+//
+//  Desc:   the compiled fuzzy rule bases shared by the weapons and weapon
+//          systems of one world. Every weapon of a type infers its
+//          desirability by the same rules, and every bot aims by the same
+//          rules, so each rule base is built the first time it is needed
+//          (see Raven_Weapon::ShareFuzzyRules and
+//          Raven_WeaponSystem::GetAimRules) and kept here until the world
+//          is destroyed.
+//
+//          One of these is owned by each Raven_WorldContext, so worlds run
+//          on different threads never share a rule base and each is built
+//          with its own world's parameters.
+//-----------------------------------------------------------------------------
+#include <map>
+#include <cassert>
+
+#include "fuzzy/CompiledFuzzyModule.h"
+#include "fuzzy/FuzzyLookupTable.h"
+
+
+class Raven_FuzzyRuleBases
+{
+public:
+
+  //the rules a type of weapon infers its desirability by
+  struct WeaponRules
+  {
+    CompiledFuzzyModule  module;
+
+    //the handles of the variables GetDesirability uses
+    int                  DistanceFLV;
+    int                  AmmoFLV;
+    int                  DesirabilityFLV;
+
+    //the desirability baked into a table over distance and ammo. Only used
+    //if FuzzyLookupResolution is not zero
+    FuzzyLookupTable     table;
+
+    WeaponRules():DistanceFLV(-1), AmmoFLV(-1), DesirabilityFLV(-1){}
+  };
+
+  //the rules the precision of a bot's aim is inferred by
+  struct AimRules
+  {
+    CompiledFuzzyModule  module;
+
+    //the handles of the variables GetPrecision uses
+    int                  DistToTargetFLV;
+    int                  VelocityFLV;
+    int                  TimeVisibleFLV;
+    int                  DeviationFLV;
+
+    //the deviation baked into a table over distance, velocity and time
+    //visible. Only used if FuzzyLookupResolution is not zero
+    FuzzyLookupTable     table;
+
+    AimRules():DistToTargetFLV(-1), VelocityFLV(-1),
+               TimeVisibleFLV(-1), DeviationFLV(-1){}
+  };
+
+private:
+
+  typedef std::map<unsigned int, WeaponRules*> WeaponRulesMap;
+
+  //the rules of each type of weapon, indexed by type
+  WeaponRulesMap  m_WeaponRules;
+
+  AimRules*       m_pAimRules;
+
+  //the rule bases are not copyable
+  Raven_FuzzyRuleBases(const Raven_FuzzyRuleBases&);
+  Raven_FuzzyRuleBases& operator=(const Raven_FuzzyRuleBases&);
+
+public:
+
+  Raven_FuzzyRuleBases():m_pAimRules(NULL){}
+
+  ~Raven_FuzzyRuleBases()
+  {
+    WeaponRulesMap::iterator curRules = m_WeaponRules.begin();
+    for (curRules; curRules != m_WeaponRules.end(); ++curRules)
+    {
+      delete curRules->second;
+    }
+
+    delete m_pAimRules;
+  }
+
+  //returns the rules of the weapon type, or NULL if they have not been
+  //built yet
+  const WeaponRules* GetWeaponRules(unsigned int WeaponType)const
+  {
+    WeaponRulesMap::const_iterator it = m_WeaponRules.find(WeaponType);
+
+    return it == m_WeaponRules.end() ? NULL : it->second;
+  }
+
+  //stores the rules of the weapon type. The rule bases take ownership
+  void               AddWeaponRules(unsigned int WeaponType, WeaponRules* rules)
+  {
+    assert (!GetWeaponRules(WeaponType) && "<Raven_FuzzyRuleBases::AddWeaponRules>: rules already built");
+
+    m_WeaponRules[WeaponType] = rules;
+  }
+
+  //returns the aim rules, or NULL if they have not been built yet
+  const AimRules*    GetAimRules()const{return m_pAimRules;}
+
+  //stores the aim rules. The rule bases take ownership
+  void               SetAimRules(AimRules* rules)
+  {
+    assert (!m_pAimRules && "<Raven_FuzzyRuleBases::SetAimRules>: rules already built");
+
+    m_pAimRules = rules;
+  }
+};
+
+
+
+#endif
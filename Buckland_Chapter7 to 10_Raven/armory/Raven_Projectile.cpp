@@ -1,6 +1,14 @@
 #include "Raven_Projectile.h"
 #include "../Raven_Game.h"
 #include <list>
+#include <vector>
+
+//------------------------- CurrentTime ---------------------------------------
+//-----------------------------------------------------------------------------
+double Raven_Projectile::CurrentTime()const
+{
+  return m_pWorld->GetClock()->GetCurrentTime();
+}
 
 //------------------ GetClosestIntersectingBot --------------------------------
 
@@ -10,30 +18,27 @@ Raven_Bot* Raven_Projectile::GetClosestIntersectingBot(Vector2D    From,
   Raven_Bot* ClosestIntersectingBot = 0;
   double ClosestSoFar = MaxDouble;
 
-  //iterate through all entities checking against the line segment FromTo
-  std::list<Raven_Bot*>::const_iterator curBot;
-  for (curBot =  m_pWorld->GetAllBots().begin();
-       curBot != m_pWorld->GetAllBots().end();
-       ++curBot)
+  //grab the entities whose bounding circles the line segment FromTo
+  //passes through
+  std::vector<Raven_Bot*> intersecting;
+
+  m_pWorld->GetBotSpace()->QuerySegment(From, To, intersecting);
+
+  std::vector<Raven_Bot*>::const_iterator curBot;
+  for (curBot = intersecting.begin(); curBot != intersecting.end(); ++curBot)
   {
     //make sure we don't check against the shooter of the projectile
     if ( ((*curBot)->ID() != m_iShooterID))
     {
-      //if the distance to FromTo is less than the entity's bounding radius then
-      //there is an intersection
-      if (DistToLineSegment(From, To, (*curBot)->Pos()) < (*curBot)->BRadius())
-      {
-        //test to see if this is the closest so far
-        double Dist = Vec2DDistanceSq((*curBot)->Pos(), m_vOrigin);
+      //test to see if this is the closest so far
+      double Dist = Vec2DDistanceSq((*curBot)->Pos(), m_vOrigin);
 
-        if (Dist < ClosestSoFar)
-        {
-          Dist = ClosestSoFar;
-          ClosestIntersectingBot = *curBot;
-        }
+      if (Dist < ClosestSoFar)
+      {
+        ClosestSoFar = Dist;
+        ClosestIntersectingBot = *curBot;
       }
     }
-
   }
 
   return ClosestIntersectingBot;
@@ -47,23 +52,20 @@ std::list<Raven_Bot*> Raven_Projectile::GetListOfIntersectingBots(Vector2D From,
   //this will hold any bots that are intersecting with the line segment
   std::list<Raven_Bot*> hits;
 
-  //iterate through all entities checking against the line segment FromTo
-  std::list<Raven_Bot*>::const_iterator curBot;
-  for (curBot =  m_pWorld->GetAllBots().begin();
-       curBot != m_pWorld->GetAllBots().end();
-       ++curBot)
+  //grab the entities whose bounding circles the line segment FromTo
+  //passes through
+  std::vector<Raven_Bot*> intersecting;
+
+  m_pWorld->GetBotSpace()->QuerySegment(From, To, intersecting);
+
+  std::vector<Raven_Bot*>::const_iterator curBot;
+  for (curBot = intersecting.begin(); curBot != intersecting.end(); ++curBot)
   {
     //make sure we don't check against the shooter of the projectile
     if ( ((*curBot)->ID() != m_iShooterID))
     {
-      //if the distance to FromTo is less than the entities bounding radius then
-      //there is an intersection so add it to hits
-      if (DistToLineSegment(From, To, (*curBot)->Pos()) < (*curBot)->BRadius())
-      {
-        hits.push_back(*curBot);
-      }
+      hits.push_back(*curBot);
     }
-
   }
 
   return hits;
@@ -12,9 +12,8 @@
 //          types of projectile: Slugs (railgun), Pellets (shotgun), Rockets
 //          (rocket launcher ) and Bolts (Blaster) 
 //-----------------------------------------------------------------------------
-#include "game/MovingEntity.h"
-#include "2d/Vector2D.h"
-#include "time/CrudeTimer.h"
+#include "Game/MovingEntity.h"
+#include "2D/Vector2D.h"
 #include <list>
 
 class Raven_Game;
@@ -55,6 +54,9 @@ protected:
   //to enable the shot to be rendered for a specific length of time
   double       m_dTimeOfCreation;
 
+  //returns the current time according to the world's clock
+  double                CurrentTime()const;
+
   Raven_Bot*            GetClosestIntersectingBot(Vector2D From,
                                                   Vector2D To)const;
 
@@ -92,7 +94,7 @@ public:
                                         m_iShooterID(ShooterID)
                 
 
-  {m_dTimeOfCreation = Clock->GetCurrentTime();}
+  {m_dTimeOfCreation = CurrentTime();}
 
   //unimportant for this class unless you want to implement a full state 
   //save/restore (which can be useful for debugging purposes)
@@ -1,5 +1,128 @@
 #include "Raven_Weapon.h"
+#include "../Raven_Game.h"
+#include "../Raven_WorldContext.h"
 
+#include "Debug/DebugConsole.h"
 
 
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+Raven_Weapon::Raven_Weapon(unsigned int TypeOfGun,
+                           unsigned int DefaultNumRounds,
+                           unsigned int MaxRoundsCarried,
+                           double        RateOfFire,
+                           double        IdealRange,
+                           double        ProjectileSpeed,
+                           Raven_Bot*   OwnerOfGun):m_iType(TypeOfGun),
+                                             m_iNumRoundsLeft(DefaultNumRounds),
+                                             m_pOwner(OwnerOfGun),
+                                             m_dRateOfFire(RateOfFire),
+                                             m_iMaxRoundsCarried(MaxRoundsCarried),
+                                             m_dLastDesirabilityScore(0),
+                                             m_dIdealRange(IdealRange),
+                                             m_dMaxProjectileSpeed(ProjectileSpeed),
+                                             m_pFuzzyRules(NULL)
+{  
+  m_dTimeNextAvailable = m_pOwner->GetWorld()->GetClock()->GetCurrentTime();
+}
 
+//-------------------------- ShareFuzzyRules ----------------------------------
+//-----------------------------------------------------------------------------
+void Raven_Weapon::ShareFuzzyRules(const std::string& DistanceFLV,
+                                   const std::string& AmmoFLV)
+{
+  Raven_FuzzyRuleBases* RuleBases = m_pOwner->GetWorld()->GetContext()->GetFuzzyRuleBases();
+
+  m_pFuzzyRules = RuleBases->GetWeaponRules(m_iType);
+
+  if (!m_pFuzzyRules)
+  {
+    FuzzyRules* rules = new FuzzyRules();
+
+    //the module is only needed while it is compiled
+    FuzzyModule fm;
+
+    InitializeFuzzyModule(fm);
+
+    rules->module.Compile(fm);
+
+    rules->DistanceFLV     = rules->module.GetVariable(DistanceFLV);
+    rules->DesirabilityFLV = rules->module.GetVariable("Desirability");
+
+    rules->table.AddInput(rules->DistanceFLV);
+
+    if (!AmmoFLV.empty())
+    {
+      rules->AmmoFLV = rules->module.GetVariable(AmmoFLV);
+
+      rules->table.AddInput(rules->AmmoFLV);
+    }
+
+    int resolution = script->GetInt("FuzzyLookupResolution");
+
+    if (resolution > 0)
+    {
+      rules->table.Bake(rules->module, rules->DesirabilityFLV, resolution);
+
+      //always reported: the table is only worth using if this is small
+      debug_con << "Weapon type " << m_iType << " desirability table max error: "
+                << rules->table.GetMaxError() << "";
+    }
+
+    RuleBases->AddWeaponRules(m_iType, rules);
+
+    m_pFuzzyRules = rules;
+  }
+
+  if (!m_pFuzzyRules->table.isBaked())
+  {
+    m_pFuzzyRules->module.InitDOMs(m_FuzzyDOMs);
+  }
+}
+
+//------------------------- InferDesirability ---------------------------------
+//-----------------------------------------------------------------------------
+double Raven_Weapon::InferDesirability(double DistToTarget)
+{
+  const FuzzyRules& rules = *m_pFuzzyRules;
+
+  if (rules.table.isBaked())
+  {
+    double inputs[2] = {DistToTarget, (double)m_iNumRoundsLeft};
+
+    return rules.table.Lookup(inputs);
+  }
+
+  //fuzzify distance and amount of ammo
+  rules.module.Fuzzify(m_FuzzyDOMs, rules.DistanceFLV, DistToTarget);
+
+  if (rules.AmmoFLV != -1)
+  {
+    rules.module.Fuzzify(m_FuzzyDOMs, rules.AmmoFLV, (double)m_iNumRoundsLeft);
+  }
+
+  return rules.module.DeFuzzify(m_FuzzyDOMs,
+                                rules.DesirabilityFLV,
+                                FuzzyModule::max_av);
+}
+
+
+//------------------------ ReadyForNextShot -----------------------------------
+//
+//  returns true if the weapon is ready to be discharged
+//-----------------------------------------------------------------------------
+bool Raven_Weapon::isReadyForNextShot()
+{
+  if (m_pOwner->GetWorld()->GetClock()->GetCurrentTime() > m_dTimeNextAvailable)
+  {
+    return true;
+  }
+
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+void Raven_Weapon::UpdateTimeWeaponIsNextAvailable()
+{
+  m_dTimeNextAvailable = m_pOwner->GetWorld()->GetClock()->GetCurrentTime() + 1.0/m_dRateOfFire;
+}
@@ -11,12 +11,12 @@
 //-----------------------------------------------------------------------------
 #include <vector>
 
-#include "2d/Vector2D.h"
-#include "time/CrudeTimer.h"
+#include "2D/Vector2D.h"
 #include "misc/utils.h"
 #include "../lua/Raven_Scriptor.h"
 #include "../Raven_Bot.h"
-#include "Fuzzy/FuzzyModule.h"
+#include "fuzzy/FuzzyModule.h"
+#include "Raven_FuzzyRuleBases.h"
 
 
 
@@ -32,10 +32,18 @@ protected:
   //an enumeration indicating the type of weapon
   unsigned int  m_iType;
 
-  //fuzzy logic is used to determine the desirability of a weapon. Each weapon
-  //owns its own instance of a fuzzy module because each has a different rule 
-  //set for inferring desirability.
-  FuzzyModule   m_FuzzyModule;
+  //fuzzy logic is used to determine the desirability of a weapon. Each type
+  //of weapon has a different rule set for inferring desirability, but every
+  //weapon of a type has the same one. It is built and compiled the first time
+  //a weapon of the type is created in the world (see ShareFuzzyRules) and
+  //kept by the world's context from then on
+  typedef Raven_FuzzyRuleBases::WeaponRules FuzzyRules;
+
+  const FuzzyRules*          m_pFuzzyRules;
+
+  //the DOMs of the shared module's sets. This is the only fuzzy logic state
+  //each weapon has of its own (it is left empty if the table is used)
+  CompiledFuzzyModule::DOMs  m_FuzzyDOMs;
 
   //amount of ammo carried for this weapon
   unsigned int  m_iNumRoundsLeft;
@@ -69,7 +77,18 @@ protected:
 
   //this method initializes the fuzzy module with the appropriate fuzzy 
   //variables and rule base.
-  virtual void  InitializeFuzzyModule() = 0;
+  virtual void  InitializeFuzzyModule(FuzzyModule& fm) = 0;
+
+  //points the weapon at the fuzzy rules of its type, building them first if
+  //this is the first weapon of the type in its world. The names are those of the
+  //variables GetDesirability uses (AmmoFLV may be empty if the desirability
+  //does not depend on the ammo). Called by the derived class constructors
+  void          ShareFuzzyRules(const std::string& DistanceFLV,
+                                const std::string& AmmoFLV);
+
+  //infers the desirability of the weapon at the given distance to the target
+  //with the ammo currently carried
+  double        InferDesirability(double DistToTarget);
 
   //vertex buffers containing the weapon's geometry
   std::vector<Vector2D>   m_vecWeaponVB;
@@ -85,17 +104,7 @@ public:
                double        RateOfFire,
                double        IdealRange,
                double        ProjectileSpeed,
-               Raven_Bot*   OwnerOfGun):m_iType(TypeOfGun),
-                                 m_iNumRoundsLeft(DefaultNumRounds),
-                                 m_pOwner(OwnerOfGun),
-                                 m_dRateOfFire(RateOfFire),
-                                 m_iMaxRoundsCarried(MaxRoundsCarried),
-                                 m_dLastDesirabilityScore(0),
-                                 m_dIdealRange(IdealRange),
-                                 m_dMaxProjectileSpeed(ProjectileSpeed)
-  {  
-    m_dTimeNextAvailable = Clock->GetCurrentTime();
-  }
+               Raven_Bot*   OwnerOfGun);
 
   virtual ~Raven_Weapon(){}
 
@@ -134,27 +143,6 @@ public:
 
 
 ///////////////////////////////////////////////////////////////////////////////
-//------------------------ ReadyForNextShot -----------------------------------
-//
-//  returns true if the weapon is ready to be discharged
-//-----------------------------------------------------------------------------
-inline bool Raven_Weapon::isReadyForNextShot()
-{
-  if (Clock->GetCurrentTime() > m_dTimeNextAvailable)
-  {
-    return true;
-  }
-
-  return false;
-}
-
-//-----------------------------------------------------------------------------
-inline void Raven_Weapon::UpdateTimeWeaponIsNextAvailable()
-{
-  m_dTimeNextAvailable = Clock->GetCurrentTime() + 1.0/m_dRateOfFire;
-}
-
-
 //-----------------------------------------------------------------------------
 inline bool Raven_Weapon::AimAt(Vector2D target)const
 {
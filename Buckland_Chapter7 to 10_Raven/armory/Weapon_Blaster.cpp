@@ -34,7 +34,7 @@ Blaster::Blaster(Raven_Bot*   owner):
   }
 
   //setup the fuzzy module
-  InitializeFuzzyModule();
+  ShareFuzzyRules("DistToTarget", "");
 }
 
 
@@ -62,10 +62,7 @@ inline void Blaster::ShootAt(Vector2D pos)
 //-----------------------------------------------------------------------------
 double Blaster::GetDesirability(double DistToTarget)
 {
-  //fuzzify distance and amount of ammo
-  m_FuzzyModule.Fuzzify("DistToTarget", DistToTarget);
-
-  m_dLastDesirabilityScore = m_FuzzyModule.DeFuzzify("Desirability", FuzzyModule::max_av);
+  m_dLastDesirabilityScore = InferDesirability(DistToTarget);
 
   return m_dLastDesirabilityScore;
 }
@@ -74,22 +71,22 @@ double Blaster::GetDesirability(double DistToTarget)
 //
 //  set up some fuzzy variables and rules
 //-----------------------------------------------------------------------------
-void Blaster::InitializeFuzzyModule()
+void Blaster::InitializeFuzzyModule(FuzzyModule& fm)
 {
-  FuzzyVariable& DistToTarget = m_FuzzyModule.CreateFLV("DistToTarget");
+  FuzzyVariable& DistToTarget = fm.CreateFLV("DistToTarget");
 
-  FzSet& Target_Close = DistToTarget.AddLeftShoulderSet("Target_Close",0,25,150);
-  FzSet& Target_Medium = DistToTarget.AddTriangularSet("Target_Medium",25,150,300);
-  FzSet& Target_Far = DistToTarget.AddRightShoulderSet("Target_Far",150,300,1000);
+  FzSet  Target_Close = DistToTarget.AddLeftShoulderSet("Target_Close",0,25,150);
+  FzSet  Target_Medium = DistToTarget.AddTriangularSet("Target_Medium",25,150,300);
+  FzSet  Target_Far = DistToTarget.AddRightShoulderSet("Target_Far",150,300,1000);
 
-  FuzzyVariable& Desirability = m_FuzzyModule.CreateFLV("Desirability"); 
-  FzSet& VeryDesirable = Desirability.AddRightShoulderSet("VeryDesirable", 50, 75, 100);
-  FzSet& Desirable = Desirability.AddTriangularSet("Desirable", 25, 50, 75);
-  FzSet& Undesirable = Desirability.AddLeftShoulderSet("Undesirable", 0, 25, 50);
+  FuzzyVariable& Desirability = fm.CreateFLV("Desirability"); 
+  FzSet  VeryDesirable = Desirability.AddRightShoulderSet("VeryDesirable", 50, 75, 100);
+  FzSet  Desirable = Desirability.AddTriangularSet("Desirable", 25, 50, 75);
+  FzSet  Undesirable = Desirability.AddLeftShoulderSet("Undesirable", 0, 25, 50);
 
-  m_FuzzyModule.AddRule(Target_Close, Desirable);
-  m_FuzzyModule.AddRule(Target_Medium, FzVery(Undesirable));
-  m_FuzzyModule.AddRule(Target_Far, FzVery(Undesirable));
+  fm.AddRule(Target_Close, Desirable);
+  fm.AddRule(Target_Medium, FzVery(Undesirable));
+  fm.AddRule(Target_Far, FzVery(Undesirable));
 }
 
 
@@ -20,7 +20,7 @@ class Blaster : public Raven_Weapon
 {
 private:
 
-  void  InitializeFuzzyModule();
+  void  InitializeFuzzyModule(FuzzyModule& fm);
   
 public:
 
@@ -20,7 +20,7 @@ class RailGun : public Raven_Weapon
 {
 private:
 
-  void  InitializeFuzzyModule();
+  void  InitializeFuzzyModule(FuzzyModule& fm);
 
 public:
 
@@ -36,7 +36,7 @@ RocketLauncher::RocketLauncher(Raven_Bot*   owner):
   }
 
   //setup the fuzzy module
-  InitializeFuzzyModule();
+  ShareFuzzyRules("DistToTarget", "AmmoStatus");
 
 }
 
@@ -71,11 +71,7 @@ double RocketLauncher::GetDesirability(double DistToTarget)
   }
   else
   {
-    //fuzzify distance and amount of ammo
-    m_FuzzyModule.Fuzzify("DistToTarget", DistToTarget);
-    m_FuzzyModule.Fuzzify("AmmoStatus", (double)m_iNumRoundsLeft);
-
-    m_dLastDesirabilityScore = m_FuzzyModule.DeFuzzify("Desirability", FuzzyModule::max_av);
+    m_dLastDesirabilityScore = InferDesirability(DistToTarget);
   }
 
   return m_dLastDesirabilityScore;
@@ -85,61 +81,61 @@ double RocketLauncher::GetDesirability(double DistToTarget)
 //
 //  set up some fuzzy variables and rules
 //-----------------------------------------------------------------------------
-void RocketLauncher::InitializeFuzzyModule()
+void RocketLauncher::InitializeFuzzyModule(FuzzyModule& fm)
 {
-  FuzzyVariable& DistToTarget = m_FuzzyModule.CreateFLV("DistToTarget");
-  FzSet& Target_Close = DistToTarget.AddLeftShoulderSet("Target_Close",0,15,75);
-  FzSet& Target_Medium = DistToTarget.AddTriangularSet("Target_Medium",15,75,150);
-  FzSet& Target_Far = DistToTarget.AddTriangularSet("Target_Far",75,150,300);
-  FzSet& Target_VeryFar = DistToTarget.AddTriangularSet("Target_VeryFar",150, 300, 600);
-  FzSet& Target_InUniverse = DistToTarget.AddRightShoulderSet("Target_InUniverse",300, 600, 1000);
-
-
-  FuzzyVariable& Desirability = m_FuzzyModule.CreateFLV("Desirability"); 
-  FzSet& IChooseYou = Desirability.AddRightShoulderSet("IChooseYou", 70, 90, 100);
-  FzSet& VeryDesirable = Desirability.AddTriangularSet("VeryDesirable", 50, 70, 90);
-  FzSet& Desirable = Desirability.AddTriangularSet("Desirable", 30, 50, 70);
-  FzSet& Undesirable = Desirability.AddTriangularSet("Undesirable", 0, 10, 30);
-  FzSet& ForgetIt = Desirability.AddTriangularSet("ForgetIt", 0, 0, 10);
-
-
-  FuzzyVariable& AmmoStatus = m_FuzzyModule.CreateFLV("AmmoStatus");
-  FzSet& Ammo_Loads = AmmoStatus.AddRightShoulderSet("Ammo_Loads", 50, 80, 100);
-  FzSet& Ammo_AlmostFull = AmmoStatus.AddTriangularSet("Ammo_AlmostFull", 30, 50, 70);
-  FzSet& Ammo_Okay = AmmoStatus.AddTriangularSet("Ammo_Okay", 10, 30, 60);
-  FzSet& Ammo_Low = AmmoStatus.AddTriangularSet("Ammo_Low", 0, 10, 30);
-  FzSet& Ammo_AlmostOut = AmmoStatus.AddTriangularSet("Ammo_AlmostOut", 0, 0, 10);
-
-
-  m_FuzzyModule.AddRule(FzAND(Target_Close, Ammo_Loads), ForgetIt);
-  m_FuzzyModule.AddRule(FzAND(Target_Close, Ammo_AlmostFull), ForgetIt);
-  m_FuzzyModule.AddRule(FzAND(Target_Close, Ammo_Okay), ForgetIt);
-  m_FuzzyModule.AddRule(FzAND(Target_Close, Ammo_Low), ForgetIt);
-  m_FuzzyModule.AddRule(FzAND(Target_Close, Ammo_AlmostOut), ForgetIt);
-
-  m_FuzzyModule.AddRule(FzAND(Target_Medium, Ammo_Loads), Desirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Medium, Ammo_AlmostFull), Desirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Medium, Ammo_Okay), Undesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Medium, Ammo_Low), ForgetIt);
-  m_FuzzyModule.AddRule(FzAND(Target_Medium, Ammo_AlmostOut), ForgetIt);
-
-  m_FuzzyModule.AddRule(FzAND(Target_Far, Ammo_Loads), IChooseYou);
-  m_FuzzyModule.AddRule(FzAND(Target_Far, Ammo_AlmostFull), VeryDesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Far, Ammo_Okay), Desirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Far, Ammo_Low), Desirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Far, Ammo_AlmostOut), Undesirable);
-
-  m_FuzzyModule.AddRule(FzAND(Target_VeryFar, Ammo_Loads), IChooseYou);
-  m_FuzzyModule.AddRule(FzAND(Target_VeryFar, Ammo_AlmostFull), IChooseYou);
-  m_FuzzyModule.AddRule(FzAND(Target_VeryFar, Ammo_Okay), VeryDesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_VeryFar, Ammo_Low), Desirable);
-  m_FuzzyModule.AddRule(FzAND(Target_VeryFar, Ammo_AlmostOut), Undesirable);
-
-  m_FuzzyModule.AddRule(FzAND(Target_InUniverse, Ammo_Loads), Desirable);
-  m_FuzzyModule.AddRule(FzAND(Target_InUniverse, Ammo_AlmostFull), Undesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_InUniverse, Ammo_Okay), Undesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_InUniverse, Ammo_Low), ForgetIt);
-  m_FuzzyModule.AddRule(FzAND(Target_InUniverse, Ammo_AlmostOut), ForgetIt);
+  FuzzyVariable& DistToTarget = fm.CreateFLV("DistToTarget");
+  FzSet  Target_Close = DistToTarget.AddLeftShoulderSet("Target_Close",0,15,75);
+  FzSet  Target_Medium = DistToTarget.AddTriangularSet("Target_Medium",15,75,150);
+  FzSet  Target_Far = DistToTarget.AddTriangularSet("Target_Far",75,150,300);
+  FzSet  Target_VeryFar = DistToTarget.AddTriangularSet("Target_VeryFar",150, 300, 600);
+  FzSet  Target_InUniverse = DistToTarget.AddRightShoulderSet("Target_InUniverse",300, 600, 1000);
+
+
+  FuzzyVariable& Desirability = fm.CreateFLV("Desirability"); 
+  FzSet  IChooseYou = Desirability.AddRightShoulderSet("IChooseYou", 70, 90, 100);
+  FzSet  VeryDesirable = Desirability.AddTriangularSet("VeryDesirable", 50, 70, 90);
+  FzSet  Desirable = Desirability.AddTriangularSet("Desirable", 30, 50, 70);
+  FzSet  Undesirable = Desirability.AddTriangularSet("Undesirable", 0, 10, 30);
+  FzSet  ForgetIt = Desirability.AddTriangularSet("ForgetIt", 0, 0, 10);
+
+
+  FuzzyVariable& AmmoStatus = fm.CreateFLV("AmmoStatus");
+  FzSet  Ammo_Loads = AmmoStatus.AddRightShoulderSet("Ammo_Loads", 50, 80, 100);
+  FzSet  Ammo_AlmostFull = AmmoStatus.AddTriangularSet("Ammo_AlmostFull", 30, 50, 70);
+  FzSet  Ammo_Okay = AmmoStatus.AddTriangularSet("Ammo_Okay", 10, 30, 60);
+  FzSet  Ammo_Low = AmmoStatus.AddTriangularSet("Ammo_Low", 0, 10, 30);
+  FzSet  Ammo_AlmostOut = AmmoStatus.AddTriangularSet("Ammo_AlmostOut", 0, 0, 10);
+
+
+  fm.AddRule(FzAND(Target_Close, Ammo_Loads), ForgetIt);
+  fm.AddRule(FzAND(Target_Close, Ammo_AlmostFull), ForgetIt);
+  fm.AddRule(FzAND(Target_Close, Ammo_Okay), ForgetIt);
+  fm.AddRule(FzAND(Target_Close, Ammo_Low), ForgetIt);
+  fm.AddRule(FzAND(Target_Close, Ammo_AlmostOut), ForgetIt);
+
+  fm.AddRule(FzAND(Target_Medium, Ammo_Loads), Desirable);
+  fm.AddRule(FzAND(Target_Medium, Ammo_AlmostFull), Desirable);
+  fm.AddRule(FzAND(Target_Medium, Ammo_Okay), Undesirable);
+  fm.AddRule(FzAND(Target_Medium, Ammo_Low), ForgetIt);
+  fm.AddRule(FzAND(Target_Medium, Ammo_AlmostOut), ForgetIt);
+
+  fm.AddRule(FzAND(Target_Far, Ammo_Loads), IChooseYou);
+  fm.AddRule(FzAND(Target_Far, Ammo_AlmostFull), VeryDesirable);
+  fm.AddRule(FzAND(Target_Far, Ammo_Okay), Desirable);
+  fm.AddRule(FzAND(Target_Far, Ammo_Low), Desirable);
+  fm.AddRule(FzAND(Target_Far, Ammo_AlmostOut), Undesirable);
+
+  fm.AddRule(FzAND(Target_VeryFar, Ammo_Loads), IChooseYou);
+  fm.AddRule(FzAND(Target_VeryFar, Ammo_AlmostFull), IChooseYou);
+  fm.AddRule(FzAND(Target_VeryFar, Ammo_Okay), VeryDesirable);
+  fm.AddRule(FzAND(Target_VeryFar, Ammo_Low), Desirable);
+  fm.AddRule(FzAND(Target_VeryFar, Ammo_AlmostOut), Undesirable);
+
+  fm.AddRule(FzAND(Target_InUniverse, Ammo_Loads), Desirable);
+  fm.AddRule(FzAND(Target_InUniverse, Ammo_AlmostFull), Undesirable);
+  fm.AddRule(FzAND(Target_InUniverse, Ammo_Okay), Undesirable);
+  fm.AddRule(FzAND(Target_InUniverse, Ammo_Low), ForgetIt);
+  fm.AddRule(FzAND(Target_InUniverse, Ammo_AlmostOut), ForgetIt);
 
 }
 
@@ -19,7 +19,7 @@ class RocketLauncher : public Raven_Weapon
 {
 private:
 
-  void     InitializeFuzzyModule();
+  void     InitializeFuzzyModule(FuzzyModule& fm);
 
 public:
 
@@ -43,7 +43,7 @@ ShotGun::ShotGun(Raven_Bot*   owner):
   }
 
   //setup the fuzzy module
-  InitializeFuzzyModule();
+  ShareFuzzyRules("DistanceToTarget", "AmmoStatus");
 
 }
 
@@ -92,11 +92,7 @@ inline double ShotGun::GetDesirability(double DistToTarget)
   }
   else
   {
-    //fuzzify distance and amount of ammo
-    m_FuzzyModule.Fuzzify("DistanceToTarget", DistToTarget);
-    m_FuzzyModule.Fuzzify("AmmoStatus", (double)m_iNumRoundsLeft);
-
-    m_dLastDesirabilityScore = m_FuzzyModule.DeFuzzify("Desirability", FuzzyModule::max_av);
+    m_dLastDesirabilityScore = InferDesirability(DistToTarget);
   }
 
   return m_dLastDesirabilityScore;
@@ -106,37 +102,37 @@ inline double ShotGun::GetDesirability(double DistToTarget)
 //
 //  set up some fuzzy variables and rules
 //-----------------------------------------------------------------------------
-void ShotGun::InitializeFuzzyModule()
+void ShotGun::InitializeFuzzyModule(FuzzyModule& fm)
 {  
-  FuzzyVariable& DistanceToTarget = m_FuzzyModule.CreateFLV("DistanceToTarget");
+  FuzzyVariable& DistanceToTarget = fm.CreateFLV("DistanceToTarget");
 
-  FzSet& Target_Close = DistanceToTarget.AddLeftShoulderSet("Target_Close", 0, 25, 150);
-  FzSet& Target_Medium = DistanceToTarget.AddTriangularSet("Target_Medium", 25, 150, 300);
-  FzSet& Target_Far = DistanceToTarget.AddRightShoulderSet("Target_Far", 150, 300, 1000);
+  FzSet  Target_Close = DistanceToTarget.AddLeftShoulderSet("Target_Close", 0, 25, 150);
+  FzSet  Target_Medium = DistanceToTarget.AddTriangularSet("Target_Medium", 25, 150, 300);
+  FzSet  Target_Far = DistanceToTarget.AddRightShoulderSet("Target_Far", 150, 300, 1000);
 
-  FuzzyVariable& Desirability = m_FuzzyModule.CreateFLV("Desirability");
+  FuzzyVariable& Desirability = fm.CreateFLV("Desirability");
   
-  FzSet& VeryDesirable = Desirability.AddRightShoulderSet("VeryDesirable", 50, 75, 100);
-  FzSet& Desirable = Desirability.AddTriangularSet("Desirable", 25, 50, 75);
-  FzSet& Undesirable = Desirability.AddLeftShoulderSet("Undesirable", 0, 25, 50);
+  FzSet  VeryDesirable = Desirability.AddRightShoulderSet("VeryDesirable", 50, 75, 100);
+  FzSet  Desirable = Desirability.AddTriangularSet("Desirable", 25, 50, 75);
+  FzSet  Undesirable = Desirability.AddLeftShoulderSet("Undesirable", 0, 25, 50);
 
-  FuzzyVariable& AmmoStatus = m_FuzzyModule.CreateFLV("AmmoStatus");
-  FzSet& Ammo_Loads = AmmoStatus.AddRightShoulderSet("Ammo_Loads", 30, 60, 100);
-  FzSet& Ammo_Okay = AmmoStatus.AddTriangularSet("Ammo_Okay", 0, 30, 60);
-  FzSet& Ammo_Low = AmmoStatus.AddTriangularSet("Ammo_Low", 0, 0, 30);
+  FuzzyVariable& AmmoStatus = fm.CreateFLV("AmmoStatus");
+  FzSet  Ammo_Loads = AmmoStatus.AddRightShoulderSet("Ammo_Loads", 30, 60, 100);
+  FzSet  Ammo_Okay = AmmoStatus.AddTriangularSet("Ammo_Okay", 0, 30, 60);
+  FzSet  Ammo_Low = AmmoStatus.AddTriangularSet("Ammo_Low", 0, 0, 30);
 
 
-  m_FuzzyModule.AddRule(FzAND(Target_Close, Ammo_Loads), VeryDesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Close, Ammo_Okay), VeryDesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Close, Ammo_Low), VeryDesirable);
+  fm.AddRule(FzAND(Target_Close, Ammo_Loads), VeryDesirable);
+  fm.AddRule(FzAND(Target_Close, Ammo_Okay), VeryDesirable);
+  fm.AddRule(FzAND(Target_Close, Ammo_Low), VeryDesirable);
 
-  m_FuzzyModule.AddRule(FzAND(Target_Medium, Ammo_Loads), VeryDesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Medium, Ammo_Okay), Desirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Medium, Ammo_Low), Undesirable);
+  fm.AddRule(FzAND(Target_Medium, Ammo_Loads), VeryDesirable);
+  fm.AddRule(FzAND(Target_Medium, Ammo_Okay), Desirable);
+  fm.AddRule(FzAND(Target_Medium, Ammo_Low), Undesirable);
 
-  m_FuzzyModule.AddRule(FzAND(Target_Far, Ammo_Loads), Desirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Far, Ammo_Okay), Undesirable);
-  m_FuzzyModule.AddRule(FzAND(Target_Far, Ammo_Low), Undesirable);
+  fm.AddRule(FzAND(Target_Far, Ammo_Loads), Desirable);
+  fm.AddRule(FzAND(Target_Far, Ammo_Okay), Undesirable);
+  fm.AddRule(FzAND(Target_Far, Ammo_Low), Undesirable);
 }
 
 //-------------------------------- Render -------------------------------------
@@ -20,7 +20,7 @@ class ShotGun : public Raven_Weapon
 {
 private:
 
-  void     InitializeFuzzyModule();
+  void     InitializeFuzzyModule(FuzzyModule& fm);
 
   //how much shot the each shell contains
   int      m_iNumBallsInShell;
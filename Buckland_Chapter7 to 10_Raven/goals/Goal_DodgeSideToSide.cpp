@@ -7,8 +7,8 @@
 #include "Messaging/Telegram.h"
 #include "../Raven_Messages.h"
 
-#include "debug/DebugConsole.h"
-#include "misc/cgdi.H"
+#include "Debug/DebugConsole.h"
+#include "misc/Cgdi.h"
 
 
 //------------------------------- Activate ------------------------------------
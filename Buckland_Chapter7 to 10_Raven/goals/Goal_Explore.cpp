@@ -4,7 +4,7 @@
 #include "../Raven_Game.h"
 #include "../Raven_Map.h"
 #include "Messaging/Telegram.h"
-#include "..\Raven_Messages.h"
+#include "../Raven_Messages.h"
 
 #include "Goal_SeekToPosition.h"
 #include "Goal_FollowPath.h"
@@ -30,7 +30,8 @@ void Goal_Explore::Activate()
   }
 
   //and request a path to that position
-  m_pOwner->GetPathPlanner()->RequestPathToPosition(m_CurrentDestination);
+  m_pOwner->GetPathPlanner()->RequestPathToPosition(m_CurrentDestination,
+                                                     path_priority_background);
 
   //the bot may have to wait a few update cycles before a path is calculated
   //so for appearances sake it simple ARRIVES at the destination until a path
@@ -0,0 +1,142 @@
+#include "Goal_FollowFlowField.h"
+#include "../Raven_Bot.h"
+#include "../Raven_Game.h"
+#include "../Raven_Map.h"
+#include "../navigation/Raven_PathPlanner.h"
+#include "Graph/NodeTypeEnumerations.h"
+
+#include "Goal_TraverseEdge.h"
+#include "Goal_NegotiateDoor.h"
+#include "misc/Cgdi.h"
+
+
+
+//------------------------------ ctor -----------------------------------------
+//-----------------------------------------------------------------------------
+Goal_FollowFlowField::
+Goal_FollowFlowField(Raven_Bot* pBot,
+                     Vector2D   pos):Goal_Composite<Raven_Bot>(pBot, goal_follow_flow_field),
+                                     m_vDestination(pos),
+                                     m_iDestinationNode(invalid_node_index),
+                                     m_iNode(invalid_node_index),
+                                     m_bLastEdge(false)
+{
+}
+
+//---------------------------- TraverseEdge -----------------------------------
+//-----------------------------------------------------------------------------
+void Goal_FollowFlowField::TraverseEdge(const PathEdge& edge)
+{
+  if (edge.Behavior() == NavGraphEdge::goes_through_door)
+  {
+    AddSubgoal(new Goal_NegotiateDoor(m_pOwner, edge, m_bLastEdge));
+  }
+  else
+  {
+    AddSubgoal(new Goal_TraverseEdge(m_pOwner, edge, m_bLastEdge));
+  }
+}
+
+//------------------------------ Activate -------------------------------------
+//
+//  called at the start and then as the bot reaches each node
+//-----------------------------------------------------------------------------
+void Goal_FollowFlowField::Activate()
+{
+  m_iStatus = active;
+
+  //head straight for the destination if nothing is in the way
+  if (m_pOwner->canWalkTo(m_vDestination))
+  {
+    m_bLastEdge = true;
+
+    TraverseEdge(PathEdge(m_pOwner->Pos(), m_vDestination, NavGraphEdge::normal));
+
+    return;
+  }
+
+  Raven_Map* pMap = m_pOwner->GetWorld()->GetMap();
+
+  //to begin with the bot makes for its closest node
+  if (m_iNode == invalid_node_index)
+  {
+    m_iNode            = m_pOwner->GetPathPlanner()->GetClosestNodeToPosition(m_pOwner->Pos());
+    m_iDestinationNode = m_pOwner->GetPathPlanner()->GetClosestNodeToPosition(m_vDestination);
+
+    if (m_iNode == invalid_node_index || m_iDestinationNode == invalid_node_index)
+    {
+      m_iStatus = failed; return;
+    }
+
+    TraverseEdge(PathEdge(m_pOwner->Pos(),
+                          pMap->GetSearchGraph().GetNode(m_iNode).Pos(),
+                          NavGraphEdge::normal));
+
+    return;
+  }
+
+  const Raven_Map::SearchGraph& graph = pMap->GetSearchGraph();
+
+  //from the destination node the bot makes for the destination itself
+  if (m_iNode == m_iDestinationNode)
+  {
+    m_bLastEdge = true;
+
+    TraverseEdge(PathEdge(graph.GetNode(m_iNode).Pos(),
+                          m_vDestination,
+                          NavGraphEdge::normal));
+
+    return;
+  }
+
+  //otherwise it takes the edge to the next node the flow field gives. The
+  //field is fetched afresh each time because it may have been discarded
+  //from the cache since the last node
+  const Raven_Map::SearchFlowFields::FlowField* pField = pMap->GetFlowField(m_iDestinationNode);
+
+  if (!pField || pField->NextNode(m_iNode) == invalid_node_index)
+  {
+    m_iStatus = failed; return;
+  }
+
+  const NavGraphEdge& edge = graph.GetEdge(m_iNode, pField->NextNode(m_iNode));
+
+  m_iNode = edge.To();
+
+  TraverseEdge(PathEdge(graph.GetNode(edge.From()).Pos(),
+                        graph.GetNode(edge.To()).Pos(),
+                        edge.Flags(),
+                        edge.IDofIntersectingEntity()));
+}
+
+//------------------------------ Process --------------------------------------
+//-----------------------------------------------------------------------------
+int Goal_FollowFlowField::Process()
+{
+  //if status is inactive, call Activate()
+  ActivateIfInactive();
+
+  if (hasFailed()) return m_iStatus;
+
+  m_iStatus = ProcessSubgoals();
+
+  //take the next edge once the bot has reached the end of this one
+  if (m_iStatus == completed && !m_bLastEdge)
+  {
+    Activate();
+  }
+
+  return m_iStatus;
+}
+
+//------------------------------- Render --------------------------------------
+//-----------------------------------------------------------------------------
+void Goal_FollowFlowField::Render()
+{
+  //forward the request to the subgoals
+  Goal_Composite<Raven_Bot>::Render();
+
+  gdi->BlackPen();
+  gdi->GreenBrush();
+  gdi->Circle(m_vDestination, 4);
+}
@@ -0,0 +1,56 @@
+#ifndef GOAL_FOLLOW_FLOW_FIELD_H
+#define GOAL_FOLLOW_FLOW_FIELD_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   Goal_FollowFlowField.h
+//
+//  Desc:   moves a bot to a position by following the map's shared flow
+//          field to the graph node closest to it (see FlowFieldCache.h).
+//          No path is requested; at each node the bot simply takes the edge
+//          to the next node the field gives. Once it reaches the node, or
+//          can walk straight to the position, it heads to the position.
+//
+//          Fails if there is no route to the position.
+//-----------------------------------------------------------------------------
+#include "Goals/Goal_Composite.h"
+#include "Raven_Goal_Types.h"
+#include "../Raven_Bot.h"
+#include "../navigation/PathEdge.h"
+
+
+
+class Goal_FollowFlowField : public Goal_Composite<Raven_Bot>
+{
+private:
+
+  //the position the bot wants to reach and the graph node closest to it
+  Vector2D  m_vDestination;
+  int       m_iDestinationNode;
+
+  //the node the edge being traversed leads to (invalid_node_index before
+  //the bot has set off)
+  int       m_iNode;
+
+  //true once the bot is on the edge that leads to m_vDestination
+  bool      m_bLastEdge;
+
+  //adds the subgoal that takes the bot along the edge
+  void      TraverseEdge(const PathEdge& edge);
+
+public:
+
+  Goal_FollowFlowField(Raven_Bot* pBot, Vector2D pos);
+
+  //the usual suspects
+  void Activate();
+  int  Process();
+  void Terminate(){}
+
+  void Render();
+};
+
+
+
+
+#endif
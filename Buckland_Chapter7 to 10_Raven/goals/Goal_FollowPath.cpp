@@ -4,7 +4,7 @@
 
 #include "Goal_TraverseEdge.h"
 #include "Goal_NegotiateDoor.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 
 
 
@@ -13,7 +13,9 @@
 Goal_FollowPath::
 Goal_FollowPath(Raven_Bot*          pBot,
                 std::list<PathEdge> path):Goal_Composite<Raven_Bot>(pBot, goal_follow_path),
-                                                  m_Path(path)
+                                                  m_Path(path),
+                                                  m_bPathPartial(pBot->GetPathPlanner()->isPathPartial()),
+                                                  m_iSearchID(pBot->GetPathPlanner()->GetSearchID())
 {
 }
 
@@ -23,6 +25,24 @@ Goal_FollowPath(Raven_Bot*          pBot,
 void Goal_FollowPath::Activate()
 {
   m_iStatus = active;
+
+  //if the path is being handed out a leg at a time fetch the next leg before
+  //the last edge is taken, so that edge is not mistaken for the end of the
+  //path. If the search has been replaced since, this goal fails and the
+  //bot replans
+  if (m_bPathPartial && m_Path.size() <= 1)
+  {
+    std::list<PathEdge> NextLeg;
+
+    if (!m_pOwner->GetPathPlanner()->GetNextLeg(m_iSearchID, NextLeg))
+    {
+      m_iStatus = failed; return;
+    }
+
+    m_Path.splice(m_Path.end(), NextLeg);
+
+    m_bPathPartial = m_pOwner->GetPathPlanner()->isPathPartial();
+  }
   
   //get a reference to the next edge
   PathEdge edge = m_Path.front();
@@ -79,6 +99,8 @@ int Goal_FollowPath::Process()
   //if status is inactive, call Activate()
   ActivateIfInactive();
 
+  if (hasFailed()) return m_iStatus;
+
   m_iStatus = ProcessSubgoals();
 
   //if there are no subgoals present check to see if the path still has edges.
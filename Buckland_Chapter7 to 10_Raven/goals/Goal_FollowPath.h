@@ -24,6 +24,11 @@ private:
   //a local copy of the path returned by the path planner
   std::list<PathEdge>  m_Path;
 
+  //true if the path planner has more of the path to come (see
+  //Raven_PathPlanner::GetNextLeg) and the search it is to come from
+  bool                 m_bPathPartial;
+  unsigned int         m_iSearchID;
+
 public:
 
   Goal_FollowPath(Raven_Bot* pBot, std::list<PathEdge> path);
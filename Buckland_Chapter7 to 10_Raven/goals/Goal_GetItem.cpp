@@ -4,7 +4,7 @@
 #include "../navigation/Raven_PathPlanner.h"
 
 #include "Messaging/Telegram.h"
-#include "..\Raven_Messages.h"
+#include "../Raven_Messages.h"
 
 #include "Goal_Wander.h"
 #include "Goal_FollowPath.h"
@@ -1,13 +1,16 @@
 #include "Goal_HuntTarget.h"
 #include "Goal_Explore.h"
 #include "Goal_MoveToPosition.h"
-#include "..\Raven_Bot.h"
-#include "..\Raven_SteeringBehaviors.h"
+#include "Goal_FollowFlowField.h"
+#include "../Raven_Bot.h"
+#include "../Raven_SteeringBehaviors.h"
+#include "../Raven_Game.h"
+#include "../Raven_Map.h"
 
 
 
-#include "debug/DebugConsole.h"
-#include "misc/cgdi.h"
+#include "Debug/DebugConsole.h"
+#include "misc/Cgdi.h"
 
 //---------------------------- Initialize -------------------------------------
 //-----------------------------------------------------------------------------  
@@ -34,10 +37,16 @@ void Goal_HuntTarget::Activate()
       AddSubgoal(new Goal_Explore(m_pOwner));
     }
 
-    //else move to the LRP
+    //else move to the LRP. Where flow fields are used, any other bots
+    //making for the same spot share the one field
+    else if (m_pOwner->GetWorld()->GetMap()->UsesFlowFields())
+    {
+      AddSubgoal(new Goal_FollowFlowField(m_pOwner, lrp));
+    }
+
     else
     {
-      AddSubgoal(new Goal_MoveToPosition(m_pOwner, lrp));
+      AddSubgoal(new Goal_MoveToPosition(m_pOwner, lrp, path_priority_combat));
     }
   }
 
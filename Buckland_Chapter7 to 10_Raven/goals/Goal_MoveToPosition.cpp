@@ -4,7 +4,7 @@
 #include "../navigation/Raven_PathPlanner.h"
 #include "Messaging/Telegram.h"
 #include "../Raven_Messages.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 
 #include "Goal_SeekToPosition.h"
 #include "Goal_FollowPath.h"
@@ -26,7 +26,8 @@ void Goal_MoveToPosition::Activate()
   //before a path is calculated. Consequently, for appearances sake, it just
   //seeks directly to the target position whilst it's awaiting notification
   //that the path planning request has succeeded/failed
-  if (m_pOwner->GetPathPlanner()->RequestPathToPosition(m_vDestination))
+  if (m_pOwner->GetPathPlanner()->RequestPathToPosition(m_vDestination,
+                                                        m_iPathPriority))
   {
     AddSubgoal(new Goal_SeekToPosition(m_pOwner, m_vDestination));
   }
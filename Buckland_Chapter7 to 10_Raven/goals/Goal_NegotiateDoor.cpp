@@ -1,6 +1,6 @@
 #include "Goal_NegotiateDoor.h"
-#include "..\Raven_Bot.h"
-#include "..\Raven_Game.h"
+#include "../Raven_Bot.h"
+#include "../Raven_Game.h"
 #include "../navigation/Raven_PathPlanner.h"
 
 
@@ -8,7 +8,7 @@
 #include "Goal_TraverseEdge.h"
 
 
-#include "debug/DebugConsole.h"
+#include "Debug/DebugConsole.h"
 
 
 
@@ -1,13 +1,13 @@
 #include "Goal_SeekToPosition.h"
-#include "..\Raven_Bot.h"
-#include "..\Raven_SteeringBehaviors.h"
-#include "time/CrudeTimer.h"
+#include "../Raven_Bot.h"
+#include "../Raven_SteeringBehaviors.h"
+#include "../Raven_Game.h"
 #include "../navigation/Raven_PathPlanner.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 
 
 
-#include "debug/DebugConsole.h"
+#include "Debug/DebugConsole.h"
 
 
 
@@ -30,7 +30,7 @@ void Goal_SeekToPosition::Activate()
   m_iStatus = active;
   
   //record the time the bot starts this goal
-  m_dStartTime = Clock->GetCurrentTime();    
+  m_dStartTime = m_pOwner->GetWorld()->GetClock()->GetCurrentTime();    
   
   //This value is used to determine if the bot becomes stuck 
   m_dTimeToReachPos = m_pOwner->CalculateTimeToReachPosition(m_vPosition);
@@ -79,7 +79,7 @@ int Goal_SeekToPosition::Process()
 //-----------------------------------------------------------------------------
 bool Goal_SeekToPosition::isStuck()const
 {  
-  double TimeTaken = Clock->GetCurrentTime() - m_dStartTime;
+  double TimeTaken = m_pOwner->GetWorld()->GetClock()->GetCurrentTime() - m_dStartTime;
 
   if (TimeTaken > m_dTimeToReachPos)
   {
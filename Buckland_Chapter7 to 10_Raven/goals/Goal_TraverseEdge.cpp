@@ -1,15 +1,15 @@
 #include "Goal_TraverseEdge.h"
-#include "..\Raven_Bot.h"
+#include "../Raven_Bot.h"
 #include "Raven_Goal_Types.h"
-#include "..\Raven_SteeringBehaviors.h"
-#include "time/CrudeTimer.h"
-#include "..\constants.h"
+#include "../Raven_SteeringBehaviors.h"
+#include "../Raven_Game.h"
+#include "../constants.h"
 #include "../navigation/Raven_PathPlanner.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 #include "../lua/Raven_Scriptor.h"
 
 
-#include "debug/DebugConsole.h"
+#include "Debug/DebugConsole.h"
 
 
 
@@ -55,7 +55,7 @@ void Goal_TraverseEdge::Activate()
   
 
   //record the time the bot starts this goal
-  m_dStartTime = Clock->GetCurrentTime();   
+  m_dStartTime = m_pOwner->GetWorld()->GetClock()->GetCurrentTime();   
   
   //calculate the expected time required to reach the this waypoint. This value
   //is used to determine if the bot becomes stuck 
@@ -117,7 +117,7 @@ int Goal_TraverseEdge::Process()
 //-----------------------------------------------------------------------------
 bool Goal_TraverseEdge::isStuck()const
 {  
-  double TimeTaken = Clock->GetCurrentTime() - m_dStartTime;
+  double TimeTaken = m_pOwner->GetWorld()->GetClock()->GetCurrentTime() - m_dStartTime;
 
   if (TimeTaken > m_dTimeExpected)
   {
@@ -83,6 +83,10 @@ std::string GoalTypeToString::Convert(int gt)
 
     return "say_phrase";
 
+  case goal_follow_flow_field:
+
+    return "follow_flow_field";
+
   default:
 
     return "UNKNOWN GOAL TYPE!";
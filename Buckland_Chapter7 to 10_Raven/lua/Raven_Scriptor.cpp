@@ -1,10 +1,9 @@
 #include "Raven_Scriptor.h"
+#include "../Raven_WorldContext.h"
 
 Raven_Scriptor* Raven_Scriptor::Instance()
 {
-  static Raven_Scriptor instance;
-
-  return &instance;
+  return Raven_WorldContext::Current()->GetScriptor();
 }
 
 
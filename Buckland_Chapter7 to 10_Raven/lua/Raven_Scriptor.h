@@ -7,9 +7,11 @@
 //
 //  Author: Mat Buckland (www.ai-junkie.com)
 //
-//  Desc:   A Singleton Scriptor class for use with the Raven project
+//  Desc:   A Scriptor class for use with the Raven project. Each world
+//          context owns one; script refers to the instance belonging to
+//          the context current on the calling thread.
 //-----------------------------------------------------------------------------
-#include "Script/scriptor.h"
+#include "script/Scriptor.h"
 
 
 
@@ -18,6 +20,8 @@
 class Raven_Scriptor : public Scriptor
 {
 private:
+
+  friend class Raven_WorldContext;
   
   Raven_Scriptor();
 
@@ -27,6 +31,7 @@ private:
 
 public:
 
+  //returns the scriptor of the current world context
   static Raven_Scriptor* Instance();
 
 };
@@ -10,6 +10,7 @@
 #include "debug/DebugConsole.h"
 #include "Raven_UserOptions.h"
 #include "Raven_Game.h"
+#include "Raven_WorldContext.h"
 #include "lua/Raven_Scriptor.h"
 
 
@@ -52,6 +53,10 @@ LRESULT CALLBACK WindowProc (HWND   hwnd,
    static TCHAR   szFileName[MAX_PATH],
                   szTitleName[MAX_PATH];
 
+   //the menu options are held by the game's world context so make it
+   //current while the message is handled
+   Raven_WorldContext::Scope context(g_pRaven ? g_pRaven->GetContext() : NULL);
+
 
     switch (msg)
     {
@@ -97,6 +102,8 @@ LRESULT CALLBACK WindowProc (HWND   hwnd,
          //create the game
          g_pRaven = new Raven_Game();
 
+         Raven_WorldContext::Scope GameContext(g_pRaven->GetContext());
+
         //make sure the menu items are ticked/unticked accordingly
         CheckMenuItemAppropriately(hwnd, IDM_NAVIGATION_SHOW_NAVGRAPH, UserOptions->m_bShowGraph);
         CheckMenuItemAppropriately(hwnd, IDM_NAVIGATION_SHOW_PATH, UserOptions->m_bShowPathOfSelectedBot);
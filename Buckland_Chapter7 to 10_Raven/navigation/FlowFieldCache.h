@@ -0,0 +1,149 @@
+#ifndef FLOW_FIELD_CACHE_H
+#define FLOW_FIELD_CACHE_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   FlowFieldCache.h
+//
+//  Desc:   a bounded cache of flow fields, shared by all the bots. A flow
+//          field holds the cost from every node of the graph to one
+//          destination node and the next node on the way there (it is a
+//          DistanceField with a single source). Any number of bots heading
+//          for the same node can then follow the one field, each taking the
+//          next node from wherever it is, rather than each searching for its
+//          own path.
+//
+//          A field is built the first time its destination is asked for,
+//          by a Dijkstra search of the whole graph made there and then. (it
+//          is not time-sliced by the path manager) When the cache is full
+//          the least recently used field is discarded.
+//
+//          The fields are calculated with the graph's own edge costs so the
+//          graph must not change while the cache holds them.
+//-----------------------------------------------------------------------------
+#include <list>
+#include <map>
+
+#include "Graph/DistanceField.h"
+
+
+template <class graph_type>
+class FlowFieldCache
+{
+public:
+
+  typedef DistanceField<graph_type> FlowField;
+
+private:
+
+  struct Record
+  {
+    FlowField*                pField;
+
+    //the record's position in m_LRU
+    std::list<int>::iterator  LRUPos;
+  };
+
+  //keyed by destination node
+  std::map<int, Record>  m_Records;
+
+  //the destinations of the fields, most recently used first
+  std::list<int>         m_LRU;
+
+  unsigned int           m_iMaxSize;
+
+  int                    m_iNumHits;
+  int                    m_iNumBuilt;
+
+  FlowFieldCache(const FlowFieldCache&);
+  FlowFieldCache& operator=(const FlowFieldCache&);
+
+public:
+
+  FlowFieldCache(unsigned int MaxSize = 0):m_iMaxSize(MaxSize),
+                                           m_iNumHits(0),
+                                           m_iNumBuilt(0)
+  {}
+
+  ~FlowFieldCache(){Clear();}
+
+  //a cache with a maximum size of zero holds nothing
+  void          SetMaxSize(unsigned int MaxSize){m_iMaxSize = MaxSize; Clear();}
+  unsigned int  MaxSize()const{return m_iMaxSize;}
+
+  //returns the flow field leading to the destination node of the graph,
+  //building it if need be. The pointer remains valid until the next field
+  //is built. Returns NULL if the cache's maximum size is zero
+  const FlowField* GetField(const graph_type& G, int destination);
+
+  inline void   Clear();
+
+  int           Size()const{return m_Records.size();}
+  int           NumHits()const{return m_iNumHits;}
+  int           NumBuilt()const{return m_iNumBuilt;}
+};
+
+
+//------------------------------- GetField ------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+const typename FlowFieldCache<graph_type>::FlowField*
+FlowFieldCache<graph_type>::GetField(const graph_type& G, int destination)
+{
+  if (m_iMaxSize == 0) return NULL;
+
+  typename std::map<int, Record>::iterator it = m_Records.find(destination);
+
+  if (it != m_Records.end())
+  {
+    //move the record to the front of the LRU list
+    m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUPos);
+
+    ++m_iNumHits;
+
+    return it->second.pField;
+  }
+
+  //make room if need be
+  if (m_Records.size() >= m_iMaxSize)
+  {
+    typename std::map<int, Record>::iterator oldest = m_Records.find(m_LRU.back());
+
+    delete oldest->second.pField;
+
+    m_Records.erase(oldest);
+    m_LRU.pop_back();
+  }
+
+  m_LRU.push_front(destination);
+
+  Record& record = m_Records[destination];
+
+  record.LRUPos = m_LRU.begin();
+  record.pField = new FlowField(G);
+
+  record.pField->AddSource(destination);
+
+  ++m_iNumBuilt;
+
+  return record.pField;
+}
+
+//--------------------------------- Clear -------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+inline void FlowFieldCache<graph_type>::Clear()
+{
+  typename std::map<int, Record>::iterator it = m_Records.begin();
+  for (it; it != m_Records.end(); ++it)
+  {
+    delete it->second.pField;
+  }
+
+  m_Records.clear();
+  m_LRU.clear();
+}
+
+
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   PathCache.h
+//
+//  Desc:   a bounded cache of the results of recent path searches, shared
+//          by all the bots. When full the least recently used result is
+//          discarded.
+//
+//          A search is identified by its source node and its target, which
+//          is either a node or (for a search for the closest item of a type)
+//          an item type. Each result is stamped with the version of the
+//          navgraph it was found with and, for item searches, the version
+//          of the triggers' active states. A result is only returned while
+//          those versions are unchanged.
+//
+//          The paths are kept as pointers to the edges of the graph searched,
+//          so the cache must be cleared if that graph is destroyed.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <list>
+#include <map>
+
+
+template <class edge_type>
+class PathCache
+{
+public:
+
+  typedef std::vector<const edge_type*> EdgeList;
+
+  //a cached search result
+  struct Entry
+  {
+    bool      bFound;
+
+    //the edges of the path from the source to the target
+    EdgeList  Path;
+  };
+
+private:
+
+  struct Key
+  {
+    int   iSource;
+    int   iTarget;
+    bool  bItemType;
+
+    bool operator<(const Key& rhs)const
+    {
+      if (iSource != rhs.iSource) return iSource < rhs.iSource;
+      if (iTarget != rhs.iTarget) return iTarget < rhs.iTarget;
+
+      return bItemType < rhs.bItemType;
+    }
+  };
+
+  struct Record
+  {
+    Entry                     entry;
+
+    unsigned int              iGraphVersion;
+    unsigned int              iTriggerVersion;
+
+    //the record's position in m_LRU
+    typename std::list<Key>::iterator  LRUPos;
+  };
+
+  std::map<Key, Record>  m_Records;
+
+  //the keys of the records, most recently used first
+  std::list<Key>         m_LRU;
+
+  unsigned int           m_iMaxSize;
+
+  int                    m_iNumHits;
+  int                    m_iNumMisses;
+
+  static Key MakeKey(int source, int target, bool bItemType)
+  {
+    Key key; key.iSource = source; key.iTarget = target; key.bItemType = bItemType;
+
+    return key;
+  }
+
+  const Entry* Find(const Key& key, unsigned int GraphVersion, unsigned int TriggerVersion);
+
+  void         Add(const Key&      key,
+                   bool            bFound,
+                   const EdgeList& path,
+                   unsigned int    GraphVersion,
+                   unsigned int    TriggerVersion);
+
+public:
+
+  PathCache(unsigned int MaxSize = 0):m_iMaxSize(MaxSize),
+                                      m_iNumHits(0),
+                                      m_iNumMisses(0)
+  {}
+
+  //a cache with a maximum size of zero holds nothing
+  void          SetMaxSize(unsigned int MaxSize){m_iMaxSize = MaxSize; Clear();}
+
+  //these return NULL if there is no result for the search that is still
+  //valid. The pointer remains valid until the next result is added
+  const Entry*  FindPathToNode(int source, int target, unsigned int GraphVersion)
+  {
+    return Find(MakeKey(source, target, false), GraphVersion, 0);
+  }
+
+  const Entry*  FindPathToItem(int          source,
+                               int          ItemType,
+                               unsigned int GraphVersion,
+                               unsigned int TriggerVersion)
+  {
+    return Find(MakeKey(source, ItemType, true), GraphVersion, TriggerVersion);
+  }
+
+  void          AddPathToNode(int             source,
+                              int             target,
+                              bool            bFound,
+                              const EdgeList& path,
+                              unsigned int    GraphVersion)
+  {
+    Add(MakeKey(source, target, false), bFound, path, GraphVersion, 0);
+  }
+
+  void          AddPathToItem(int             source,
+                              int             ItemType,
+                              bool            bFound,
+                              const EdgeList& path,
+                              unsigned int    GraphVersion,
+                              unsigned int    TriggerVersion)
+  {
+    Add(MakeKey(source, ItemType, true), bFound, path, GraphVersion, TriggerVersion);
+  }
+
+  void          Clear(){m_Records.clear(); m_LRU.clear();}
+
+  int           Size()const{return m_Records.size();}
+  int           NumHits()const{return m_iNumHits;}
+  int           NumMisses()const{return m_iNumMisses;}
+};
+
+
+//-------------------------------- Find ---------------------------------------
+//
+//  a stale result is removed when it is found
+//-----------------------------------------------------------------------------
+template <class edge_type>
+const typename PathCache<edge_type>::Entry*
+PathCache<edge_type>::Find(const Key& key, unsigned int GraphVersion, unsigned int TriggerVersion)
+{
+  typename std::map<Key, Record>::iterator it = m_Records.find(key);
+
+  if (it == m_Records.end())
+  {
+    ++m_iNumMisses; return NULL;
+  }
+
+  if (it->second.iGraphVersion != GraphVersion ||
+      it->second.iTriggerVersion != TriggerVersion)
+  {
+    m_LRU.erase(it->second.LRUPos);
+    m_Records.erase(it);
+
+    ++m_iNumMisses; return NULL;
+  }
+
+  //move the record to the front of the LRU list
+  m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUPos);
+
+  ++m_iNumHits;
+
+  return &it->second.entry;
+}
+
+//--------------------------------- Add ---------------------------------------
+//-----------------------------------------------------------------------------
+template <class edge_type>
+void PathCache<edge_type>::Add(const Key&      key,
+                               bool            bFound,
+                               const EdgeList& path,
+                               unsigned int    GraphVersion,
+                               unsigned int    TriggerVersion)
+{
+  if (m_iMaxSize == 0) return;
+
+  typename std::map<Key, Record>::iterator it = m_Records.find(key);
+
+  if (it == m_Records.end())
+  {
+    //make room if need be
+    if (m_Records.size() >= m_iMaxSize)
+    {
+      m_Records.erase(m_LRU.back());
+      m_LRU.pop_back();
+    }
+
+    m_LRU.push_front(key);
+
+    it = m_Records.insert(std::make_pair(key, Record())).first;
+
+    it->second.LRUPos = m_LRU.begin();
+  }
+  else
+  {
+    m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUPos);
+  }
+
+  it->second.entry.bFound    = bFound;
+  it->second.entry.Path      = path;
+  it->second.iGraphVersion   = GraphVersion;
+  it->second.iTriggerVersion = TriggerVersion;
+}
+
+
+
+#endif
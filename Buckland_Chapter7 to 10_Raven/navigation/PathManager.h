@@ -7,53 +7,394 @@
 //
 //  Author: Mat Buckland (www.ai-junkie.com)
 //
-//  Desc:   a template class to manage a number of graph searches, and to 
+//  Desc:   a template class to manage a number of graph searches, and to
 //          distribute the calculation of each search over several update-steps
+//
+//          Each request is registered with a priority (see PathPriority.h)
+//          and, optionally, a deadline given as a number of update-steps.
+//          The requests are served in order of urgency: player requests
+//          first, then any request whose deadline has passed, then the
+//          rest by priority. Requests of equal urgency are served earliest
+//          deadline first and then first come first served. Each request
+//          is cycled until it completes or the update-step's budget is
+//          spent; the budget is a number of graph nodes expanded and,
+//          optionally, a time in microseconds.
+//
+//          The manager also keeps the pool of workspaces the searches
+//          borrow their per-node data from (see SearchWorkspace.h) and
+//          statistics of how long the requests of each priority take to be
+//          answered (see PathRequestStats.h)
+//
+//          If the manager is created with worker threads, any search that
+//          only reads the (immutable) navgraph is run to completion on a
+//          worker instead. The workers take the most urgent pending search
+//          first. UpdateSearches never waits for a worker: each call
+//          delivers the searches that have finished, in the order they were
+//          registered, up to the first that has not. That one and any
+//          registered after it are kept for a later call, so a slow search
+//          delays its successors but never the game. Searches that read the
+//          state of the game (such as those for active item triggers) are
+//          always time-sliced on the game thread.
+//
+//          (The order requests are served in depends only on update-steps so
+//          is repeatable, unless a time budget is set or there are worker
+//          threads. The update-step a worker's search is delivered in
+//          depends on how quickly the worker finished it)
+//
+//          The path planner must provide:
+//
+//            int  CycleSearch()const             one search cycle
+//            void NotifyOwner(int result)const   message the owner
+//            bool CanSearchOnWorker()const
 //-----------------------------------------------------------------------------
 #include <list>
+#include <map>
+#include <vector>
+#include <algorithm>
 #include <cassert>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+#include "TimeSlicedGraphAlgorithms.h"
+#include "SearchWorkspace.h"
+#include "PathPriority.h"
+#include "PathRequestStats.h"
 
 
 
 template <class path_planner>
 class PathManager
 {
+public:
+
+  typedef SearchWorkspacePool<typename path_planner::EdgeType> WorkspacePool;
+
 private:
 
-  //a container of all the active search requests
-  std::list<path_planner*>  m_SearchRequests;
+  typedef std::chrono::steady_clock Clock;
+
+  //a registered path request
+  struct Request
+  {
+    path_planner*      pPlanner;
+
+    int                iPriority;
+
+    //requests are numbered in the order they are registered
+    unsigned int       iSequence;
+
+    //the update-step the request was registered in and the one it should be
+    //answered by (if bHasDeadline)
+    unsigned int       iRegistered;
+    unsigned int       iDeadline;
+    bool               bHasDeadline;
+
+    Clock::time_point  TimeRegistered;
+  };
+
+  //orders requests most urgent first
+  class MoreUrgent
+  {
+  private:
+
+    unsigned int m_iUpdateStep;
+
+    int Rank(const Request& r)const
+    {
+      if (r.iPriority == path_priority_player) return 0;
+
+      if (r.bHasDeadline && (int)(m_iUpdateStep - r.iDeadline) >= 0) return 1;
+
+      return 2 + r.iPriority;
+    }
+
+  public:
 
-  //this is the total number of search cycles allocated to the manager. 
-  //Each update-step these are divided equally amongst all registered path
-  //requests
+    MoreUrgent(unsigned int UpdateStep):m_iUpdateStep(UpdateStep){}
+
+    bool operator()(const Request& a, const Request& b)const
+    {
+      int ra = Rank(a), rb = Rank(b);
+
+      if (ra != rb) return ra < rb;
+
+      if (a.bHasDeadline != b.bHasDeadline) return a.bHasDeadline;
+
+      if (a.bHasDeadline && a.iDeadline != b.iDeadline)
+      {
+        return (int)(a.iDeadline - b.iDeadline) < 0;
+      }
+
+      return (int)(a.iSequence - b.iSequence) < 0;
+    }
+  };
+
+  //a search handed to the workers
+  struct AsyncSearch
+  {
+    enum {pending, running, finished};
+
+    Request            request;
+
+    int                iState;
+
+    //the result the search terminated with, once finished
+    int                iResult;
+
+    //set by UnRegister if the search is no longer wanted. The worker
+    //running the search checks this between cycles
+    std::atomic<bool>  bCancelled;
+
+    AsyncSearch(const Request& r):request(r),
+                                  iState(pending),
+                                  iResult(search_incomplete),
+                                  bCancelled(false)
+    {}
+  };
+
+private:
+
+  //the workspaces of finished searches are kept here for reuse. (Declared
+  //first so it is destroyed last)
+  WorkspacePool             m_Workspaces;
+
+  //the requests being time-sliced on the game thread
+  std::map<path_planner*, Request>  m_SearchRequests;
+
+  //this is the total number of graph nodes the searches may expand each
+  //update-step
   unsigned int              m_iNumSearchCyclesPerUpdate;
 
+  //if not zero the searches are also stopped once they have taken this
+  //long in an update-step
+  double                    m_dMaxMicrosecondsPerUpdate;
+
+  //the number of times UpdateSearches has been called
+  unsigned int              m_iUpdateStep;
+
+  //the sequence number of the next request registered
+  unsigned int              m_iNextSequence;
+
+  PathRequestStats          m_Stats[num_path_priorities];
+
+  //the worker threads (empty if all the searches are time-sliced)
+  std::vector<std::thread>  m_Workers;
+
+  //the searches handed to the workers that have yet to be delivered, in
+  //the order they were registered
+  std::list<AsyncSearch*>   m_AsyncSearches;
+
+  //guards m_AsyncSearches, the state of the searches in it and (for the
+  //workers' benefit) m_iUpdateStep
+  mutable std::mutex        m_Lock;
+
+  std::condition_variable   m_SearchPending;
+  std::condition_variable   m_SearchFinished;
+
+  bool                      m_bShuttingDown;
+
+  //the body of each worker thread
+  static void RunWorker(PathManager* pManager);
+
+  //returns the planner's search if it has been handed to the workers and
+  //not yet delivered. The lock must be held by the caller
+  typename std::list<AsyncSearch*>::iterator FindAsyncSearch(const path_planner* pPathPlanner);
+
+  //records the latency of a request and notifies its bot of the result
+  void Deliver(const Request& request, int result);
+
+  PathManager(const PathManager&);
+  PathManager& operator=(const PathManager&);
+
 public:
-    
-  PathManager(unsigned int NumCyclesPerUpdate):m_iNumSearchCyclesPerUpdate(NumCyclesPerUpdate){}
 
-  //every time this is called the total amount of search cycles available will
-  //be shared out equally between all the active path requests. If a search
+  //if MaxMicrosecondsPerUpdate is zero only the number of nodes expanded is
+  //limited. If NumWorkerThreads is zero every search is time-sliced on the
+  //game thread
+  PathManager(unsigned int NumCyclesPerUpdate,
+              double       MaxMicrosecondsPerUpdate = 0,
+              unsigned int NumWorkerThreads = 0);
+
+  ~PathManager();
+
+  //each time this is called the searches the workers have finished are
+  //delivered, in the order they were registered, up to the first that is
+  //still pending or running. Then the time-sliced requests are cycled, most
+  //urgent first, until the update-step's budget is spent. If a search
   //completes successfully or fails the method will notify the relevant bot
   void UpdateSearches();
 
-  //a path planner should call this method to register a search with the 
-  //manager. (The method checks to ensure the path planner is only registered
-  //once)
-  void Register(path_planner* pPathPlanner);
+  //a path planner should call this method to register a search with the
+  //manager. If MaxUpdates is greater than zero the request should be
+  //answered within that many update-steps; once it has waited that long it
+  //is served ahead of all but the player's requests. (The method checks to
+  //ensure the path planner is only registered once)
+  void Register(path_planner* pPathPlanner,
+                int           priority = path_priority_normal,
+                int           MaxUpdates = 0);
 
+  //if a worker is running the planner's search this will wait for the
+  //worker to abandon it. Any undelivered result is discarded
   void UnRegister(path_planner* pPathPlanner);
 
   //returns the amount of path requests currently active.
-  int  GetNumActiveSearches()const{return m_SearchRequests.size();}
+  int  GetNumActiveSearches()const;
+
+  bool isAsynchronous()const{return !m_Workers.empty();}
+
+  //returns the latency statistics of the requests of the given priority
+  const PathRequestStats& GetStats(int priority)const{return m_Stats[priority];}
+
+  //searches should borrow their workspaces from here. Every search must be
+  //destroyed before the manager is
+  WorkspacePool&  GetWorkspaces(){return m_Workspaces;}
 };
 
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+template <class path_planner>
+PathManager<path_planner>::PathManager(unsigned int NumCyclesPerUpdate,
+                                       double       MaxMicrosecondsPerUpdate,
+                                       unsigned int NumWorkerThreads):m_iNumSearchCyclesPerUpdate(NumCyclesPerUpdate),
+                                                                      m_dMaxMicrosecondsPerUpdate(MaxMicrosecondsPerUpdate),
+                                                                      m_iUpdateStep(0),
+                                                                      m_iNextSequence(0),
+                                                                      m_bShuttingDown(false)
+{
+  for (unsigned int w=0; w<NumWorkerThreads; ++w)
+  {
+    m_Workers.push_back(std::thread(RunWorker, this));
+  }
+}
+
+//------------------------------- dtor ----------------------------------------
+//
+//  any undelivered searches are abandoned
+//-----------------------------------------------------------------------------
+template <class path_planner>
+PathManager<path_planner>::~PathManager()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    m_bShuttingDown = true;
+
+    typename std::list<AsyncSearch*>::iterator it;
+    for (it = m_AsyncSearches.begin(); it != m_AsyncSearches.end(); ++it)
+    {
+      (*it)->bCancelled = true;
+    }
+  }
+
+  m_SearchPending.notify_all();
+
+  for (unsigned int w=0; w<m_Workers.size(); ++w)
+  {
+    m_Workers[w].join();
+  }
+
+  typename std::list<AsyncSearch*>::iterator it;
+  for (it = m_AsyncSearches.begin(); it != m_AsyncSearches.end(); ++it)
+  {
+    delete *it;
+  }
+}
+
+//----------------------------- RunWorker -------------------------------------
+//
+//  each worker repeatedly takes the most urgent pending search and cycles it
+//  until it terminates or is cancelled
+//-----------------------------------------------------------------------------
+template <class path_planner>
+void PathManager<path_planner>::RunWorker(PathManager* pManager)
+{
+  std::unique_lock<std::mutex> lock(pManager->m_Lock);
+
+  while (true)
+  {
+    AsyncSearch* pSearch = NULL;
+
+    while (!pManager->m_bShuttingDown)
+    {
+      MoreUrgent urgency(pManager->m_iUpdateStep);
+
+      typename std::list<AsyncSearch*>::iterator it;
+      for (it = pManager->m_AsyncSearches.begin(); it != pManager->m_AsyncSearches.end(); ++it)
+      {
+        if ((*it)->iState != AsyncSearch::pending) continue;
+
+        if (!pSearch || urgency((*it)->request, pSearch->request)) pSearch = *it;
+      }
+
+      if (pSearch) break;
+
+      pManager->m_SearchPending.wait(lock);
+    }
+
+    if (pManager->m_bShuttingDown) return;
+
+    pSearch->iState = AsyncSearch::running;
+
+    lock.unlock();
+
+    int result = search_incomplete;
+
+    while (result == search_incomplete && !pSearch->bCancelled)
+    {
+      result = pSearch->request.pPlanner->CycleSearch();
+    }
+
+    lock.lock();
+
+    pSearch->iState  = AsyncSearch::finished;
+    pSearch->iResult = result;
+
+    pManager->m_SearchFinished.notify_all();
+  }
+}
+
+//--------------------------- FindAsyncSearch ---------------------------------
+//-----------------------------------------------------------------------------
+template <class path_planner>
+typename std::list<typename PathManager<path_planner>::AsyncSearch*>::iterator
+PathManager<path_planner>::FindAsyncSearch(const path_planner* pPathPlanner)
+{
+  typename std::list<AsyncSearch*>::iterator it;
+  for (it = m_AsyncSearches.begin(); it != m_AsyncSearches.end(); ++it)
+  {
+    if ((*it)->request.pPlanner == pPathPlanner) break;
+  }
+
+  return it;
+}
+
+//------------------------------ Deliver --------------------------------------
+//-----------------------------------------------------------------------------
+template <class path_planner>
+inline void PathManager<path_planner>::Deliver(const Request& request, int result)
+{
+  double Microseconds = std::chrono::duration<double, std::micro>(Clock::now() -
+                                                                 request.TimeRegistered).count();
+
+  bool bMissedDeadline = request.bHasDeadline &&
+                         (int)(m_iUpdateStep - request.iDeadline) > 0;
+
+  m_Stats[request.iPriority].Record(m_iUpdateStep - request.iRegistered,
+                                    Microseconds,
+                                    bMissedDeadline);
+
+  request.pPlanner->NotifyOwner(result);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //------------------------- UpdateSearches ------------------------------------
 //
-//  This method iterates through all the active path planning requests 
-//  updating their searches until the user specified total number of search
-//  cycles has been satisfied.
+//  This method iterates through all the active path planning requests
+//  updating their searches until the budget for this update-step has been
+//  spent.
 //
 //  If a path is found or the search is unsuccessful the relevant agent is
 //  notified accordingly by Telegram
@@ -61,36 +402,90 @@ public:
 template <class path_planner>
 inline void PathManager<path_planner>::UpdateSearches()
 {
-  int NumCyclesRemaining = m_iNumSearchCyclesPerUpdate;
+  const Clock::time_point StartTime = Clock::now();
 
-  //iterate through the search requests until either all requests have been
-  //fulfilled or there are no search cycles remaining for this update-step.
-  std::list<path_planner*>::iterator curPath = m_SearchRequests.begin();
-  while (NumCyclesRemaining-- && !m_SearchRequests.empty())
   {
-    //make one search cycle of this path request
-    int result = (*curPath)->CycleOnce();
+    std::lock_guard<std::mutex> lock(m_Lock);
 
-    //if the search has terminated remove from the list
-    if ( (result == target_found) || (result == target_not_found) )
+    ++m_iUpdateStep;
+  }
+
+  //deliver the finished searches handed to the workers before this call,
+  //oldest first, stopping at the first that has not finished. The lock is
+  //released while each bot is notified because the bot may well make a new
+  //request (or UnRegister another search) in response. Any search registered
+  //during delivery waits for the next call
+  if (isAsynchronous())
+  {
+    std::unique_lock<std::mutex> lock(m_Lock);
+
+    const unsigned int NextUndelivered = m_iNextSequence;
+
+    while (!m_AsyncSearches.empty() &&
+           (int)(m_AsyncSearches.front()->request.iSequence - NextUndelivered) < 0 &&
+           m_AsyncSearches.front()->iState == AsyncSearch::finished)
     {
-      //remove this path from the path list
-      curPath = m_SearchRequests.erase(curPath);       
+      AsyncSearch* pSearch = m_AsyncSearches.front();
+
+      m_AsyncSearches.pop_front();
+
+      lock.unlock();
+
+      Deliver(pSearch->request, pSearch->iResult);
+
+      delete pSearch;
+
+      lock.lock();
     }
-    //move on to the next
-    else
+  }
+
+  //make a schedule of the time-sliced requests, most urgent first
+  std::vector<Request> schedule;
+
+  typename std::map<path_planner*, Request>::const_iterator curReq;
+  for (curReq = m_SearchRequests.begin(); curReq != m_SearchRequests.end(); ++curReq)
+  {
+    schedule.push_back(curReq->second);
+  }
+
+  std::sort(schedule.begin(), schedule.end(), MoreUrgent(m_iUpdateStep));
+
+  int  NumCyclesRemaining = m_iNumSearchCyclesPerUpdate;
+  bool bOutOfTime         = false;
+
+  for (unsigned int r=0; r<schedule.size() && NumCyclesRemaining > 0 && !bOutOfTime; ++r)
+  {
+    //a bot notified earlier in this loop may have withdrawn or replaced
+    //this request
+    typename std::map<path_planner*, Request>::iterator it = m_SearchRequests.find(schedule[r].pPlanner);
+
+    if (it == m_SearchRequests.end() || it->second.iSequence != schedule[r].iSequence) continue;
+
+    int result = search_incomplete;
+
+    while (result == search_incomplete && NumCyclesRemaining > 0)
     {
-      ++curPath;
+      result = schedule[r].pPlanner->CycleSearch();
+
+      --NumCyclesRemaining;
+
+      //the clock is only read every few cycles
+      if (m_dMaxMicrosecondsPerUpdate > 0 && (NumCyclesRemaining & 15) == 0 &&
+          std::chrono::duration<double, std::micro>(Clock::now() - StartTime).count() >
+          m_dMaxMicrosecondsPerUpdate)
+      {
+        bOutOfTime = true; break;
+      }
     }
 
-    //the iterator may now be pointing to the end of the list. If this is so,
-    // it must be reset to the beginning.
-    if (curPath == m_SearchRequests.end())
+    //if the search has terminated remove it and notify the bot
+    if ( (result == target_found) || (result == target_not_found) )
     {
-      curPath = m_SearchRequests.begin();
-    }
+      m_SearchRequests.erase(it);
 
-  }//end while
+      Deliver(schedule[r], result);
+    }
+  }
 }
 
 //--------------------------- Register ----------------------------------------
@@ -98,15 +493,45 @@ inline void PathManager<path_planner>::UpdateSearches()
 //  this is called to register a search with the manager.
 //-----------------------------------------------------------------------------
 template <class path_planner>
-inline void PathManager<path_planner>::Register(path_planner* pPathPlanner)
+inline void PathManager<path_planner>::Register(path_planner* pPathPlanner,
+                                                int           priority,
+                                                int           MaxUpdates)
 {
+  assert (priority >= 0 && priority < num_path_priorities &&
+          "<PathManager::Register>: invalid priority");
+
+  Request request;
+
+  request.pPlanner       = pPathPlanner;
+  request.iPriority      = priority;
+  request.iRegistered    = m_iUpdateStep;
+  request.iDeadline      = m_iUpdateStep + MaxUpdates;
+  request.bHasDeadline   = MaxUpdates > 0;
+  request.TimeRegistered = Clock::now();
+
+  if (isAsynchronous() && pPathPlanner->CanSearchOnWorker())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Lock);
+
+      if (FindAsyncSearch(pPathPlanner) != m_AsyncSearches.end()) return;
+
+      request.iSequence = m_iNextSequence++;
+
+      m_AsyncSearches.push_back(new AsyncSearch(request));
+    }
+
+    m_SearchPending.notify_one();
+
+    return;
+  }
+
   //make sure the bot does not already have a current search in the queue
-  if(std::find(m_SearchRequests.begin(),
-               m_SearchRequests.end(),
-               pPathPlanner) == m_SearchRequests.end())
-  { 
-    //add to the list
-    m_SearchRequests.push_back(pPathPlanner);
+  if (m_SearchRequests.find(pPathPlanner) == m_SearchRequests.end())
+  {
+    request.iSequence = m_iNextSequence++;
+
+    m_SearchRequests[pPathPlanner] = request;
   }
 }
 
@@ -115,12 +540,53 @@ inline void PathManager<path_planner>::Register(path_planner* pPathPlanner)
 template <class path_planner>
 inline void PathManager<path_planner>::UnRegister(path_planner* pPathPlanner)
 {
-  m_SearchRequests.remove(pPathPlanner);
+  m_SearchRequests.erase(pPathPlanner);
+
+  if (!isAsynchronous()) return;
+
+  std::unique_lock<std::mutex> lock(m_Lock);
+
+  typename std::list<AsyncSearch*>::iterator it = FindAsyncSearch(pPathPlanner);
+
+  if (it == m_AsyncSearches.end()) return;
+
+  AsyncSearch* pSearch = *it;
+
+  //ask the worker running the search (if any) to abandon it and wait until
+  //it has. (it checks between cycles so the wait is short)
+  pSearch->bCancelled = true;
+
+  while (pSearch->iState == AsyncSearch::running)
+  {
+    m_SearchFinished.wait(lock);
+  }
+
+  m_AsyncSearches.remove(pSearch);
+
+  delete pSearch;
+}
+
+//------------------------- GetNumActiveSearches ------------------------------
+//
+//  includes the searches handed to the workers that are yet to be delivered
+//-----------------------------------------------------------------------------
+template <class path_planner>
+inline int PathManager<path_planner>::GetNumActiveSearches()const
+{
+  int count = m_SearchRequests.size();
+
+  if (isAsynchronous())
+  {
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    count += m_AsyncSearches.size();
+  }
 
+  return count;
 }
 
 
 
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,28 @@
+#ifndef PATH_PRIORITY_H
+#define PATH_PRIORITY_H
+//-----------------------------------------------------------------------------
+//
+//  Name:   PathPriority.h
+//
+//  Desc:   the urgency of a path request. The path manager serves the most
+//          urgent requests first (see PathManager.h)
+//-----------------------------------------------------------------------------
+
+enum
+{
+  //requested by a bot under the player's control
+  path_priority_player,
+
+  //requested by a bot engaging or chasing an opponent
+  path_priority_combat,
+
+  path_priority_normal,
+
+  //requested by a bot with nothing better to do, such as exploring
+  path_priority_background,
+
+  num_path_priorities
+};
+
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef PATH_REQUEST_STATS_H
+#define PATH_REQUEST_STATS_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   PathRequestStats.h
+//
+//  Desc:   records how long path requests take to be answered. The latency
+//          of a request is measured both in update-steps and in real time
+//          from the moment it is registered with the path manager to the
+//          moment its bot is notified.
+//
+//          The percentiles are calculated from the most recent requests
+//          only so they follow changes in the load on the path manager.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <algorithm>
+
+
+class PathRequestStats
+{
+private:
+
+  //the number of recent latencies the percentiles are calculated from
+  enum {NumRecent = 256};
+
+  int                  m_iNumRequests;
+
+  //requests answered after their deadline had passed
+  int                  m_iNumMissedDeadlines;
+
+  double               m_dTotalUpdates;
+  int                  m_iMaxUpdates;
+
+  double               m_dTotalMicroseconds;
+  double               m_dMaxMicroseconds;
+
+  //a ring buffer of the most recent latencies in microseconds
+  std::vector<double>  m_Recent;
+  int                  m_iNextRecent;
+
+public:
+
+  PathRequestStats():m_iNumRequests(0),
+                     m_iNumMissedDeadlines(0),
+                     m_dTotalUpdates(0),
+                     m_iMaxUpdates(0),
+                     m_dTotalMicroseconds(0),
+                     m_dMaxMicroseconds(0),
+                     m_iNextRecent(0)
+  {}
+
+  void Record(int Updates, double Microseconds, bool bMissedDeadline)
+  {
+    ++m_iNumRequests;
+
+    if (bMissedDeadline) ++m_iNumMissedDeadlines;
+
+    m_dTotalUpdates      += Updates;
+    m_dTotalMicroseconds += Microseconds;
+
+    if (Updates      > m_iMaxUpdates)      m_iMaxUpdates      = Updates;
+    if (Microseconds > m_dMaxMicroseconds) m_dMaxMicroseconds = Microseconds;
+
+    if ((int)m_Recent.size() < NumRecent)
+    {
+      m_Recent.push_back(Microseconds);
+    }
+    else
+    {
+      m_Recent[m_iNextRecent] = Microseconds;
+
+      m_iNextRecent = (m_iNextRecent + 1) % NumRecent;
+    }
+  }
+
+  int    NumRequests()const{return m_iNumRequests;}
+  int    NumMissedDeadlines()const{return m_iNumMissedDeadlines;}
+
+  double AverageUpdates()const{return m_iNumRequests ? m_dTotalUpdates / m_iNumRequests : 0;}
+  int    MaxUpdates()const{return m_iMaxUpdates;}
+
+  double AverageMicroseconds()const{return m_iNumRequests ? m_dTotalMicroseconds / m_iNumRequests : 0;}
+  double MaxMicroseconds()const{return m_dMaxMicroseconds;}
+
+  //returns the latency (in microseconds) that the given fraction (0 to 1)
+  //of the recent requests were answered within
+  double RecentPercentileMicroseconds(double fraction)const
+  {
+    if (m_Recent.empty()) return 0;
+
+    std::vector<double> sorted(m_Recent);
+
+    int idx = (int)(fraction * (sorted.size()-1) + 0.5);
+
+    std::nth_element(sorted.begin(), sorted.begin() + idx, sorted.end());
+
+    return sorted[idx];
+  }
+};
+
+
+#endif
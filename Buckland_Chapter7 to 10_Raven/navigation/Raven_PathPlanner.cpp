@@ -1,18 +1,18 @@
 #include "Raven_PathPlanner.h"
 #include "../Raven_Game.h"
 #include "misc/utils.h"
-#include "graph/GraphAlgorithms.h"
+#include "Graph/GraphAlgorithms.h"
 #include "misc/Cgdi.h"
 #include "../Raven_Bot.h"
 #include "../constants.h"
 #include "../Raven_UserOptions.h"
-#include "pathmanager.h"
+#include "PathManager.h"
 #include "SearchTerminationPolicies.h"
 #include "../lua/Raven_Scriptor.h"
 #include "misc/CellSpacePartition.h"
 #include "../Raven_Messages.h"
 #include "Messaging/MessageDispatcher.h"
-#include "graph/NodeTypeEnumerations.h"
+#include "Graph/NodeTypeEnumerations.h"
 
 
 #include "Debug/DebugConsole.h"
@@ -22,16 +22,31 @@
 //---------------------------- ctor -------------------------------------------
 //-----------------------------------------------------------------------------
 Raven_PathPlanner::Raven_PathPlanner(Raven_Bot* owner):m_pOwner(owner),
-               m_NavGraph(m_pOwner->GetWorld()->GetMap()->GetNavGraph()),
-               m_pCurrentSearch(NULL)
+               m_NavGraph(m_pOwner->GetWorld()->GetMap()->GetSearchGraph()),
+               m_pCurrentSearch(NULL),
+               m_pHierarchicalSearch(NULL),
+               m_pAnyAngleSearch(NULL),
+               m_pIncrementalSearch(NULL),
+               m_iIncrementalGraphVersion(0),
+               m_iSearchID(0),
+               m_bCacheResult(false)
 {
 }
 
+//------------------------- WalkTest::isWalkable ------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_PathPlanner::WalkTest::isWalkable(Vector2D from, Vector2D to)const
+{
+  return m_pBot->canWalkBetween(from, to);
+}
+
 //-------------------------- dtor ---------------------------------------------
 //-----------------------------------------------------------------------------
 Raven_PathPlanner::~Raven_PathPlanner()
 {
   GetReadyForNewSearch();
+
+  delete m_pIncrementalSearch;
 }
 
 //------------------------------ GetReadyForNewSearch -----------------------------------
@@ -44,9 +59,15 @@ void Raven_PathPlanner::GetReadyForNewSearch()
   //unregister any existing search with the path manager
   m_pOwner->GetWorld()->GetPathManager()->UnRegister(this);
 
-  //clean up memory used by any existing search
-  delete m_pCurrentSearch;    
+  //clean up memory used by any existing search. (the incremental search is
+  //kept for reuse)
+  if (m_pCurrentSearch != m_pIncrementalSearch) delete m_pCurrentSearch;    
   m_pCurrentSearch = 0;
+  m_pHierarchicalSearch = 0;
+  m_pAnyAngleSearch = 0;
+  m_bCacheResult = false;
+
+  ++m_iSearchID;
 }
 
 //---------------------------- GetCostToNode ----------------------------------
@@ -70,8 +91,8 @@ double Raven_PathPlanner::GetCostToNode(unsigned int NodeIdx)const
 //------------------------ GetCostToClosestItem ---------------------------
 //
 //  returns the cost to the closest instance of the giver type. This method
-//  makes use of the pre-calculated lookup table. Returns -1 if no active
-//  trigger found
+//  makes use of the map's distance field for the type. Returns -1 if no
+//  active trigger found
 //-----------------------------------------------------------------------------
 double Raven_PathPlanner::GetCostToClosestItem(unsigned int GiverType)const
 {
@@ -81,35 +102,16 @@ double Raven_PathPlanner::GetCostToClosestItem(unsigned int GiverType)const
   //if no closest node found return failure
   if (nd == invalid_node_index) return -1;
 
-  double ClosestSoFar = MaxDouble;
-
-  //iterate through all the triggers to find the closest *active* trigger of 
-  //type GiverType
-  const Raven_Map::TriggerSystem::TriggerList& triggers = m_pOwner->GetWorld()->GetMap()->GetTriggers();
-
-  Raven_Map::TriggerSystem::TriggerList::const_iterator it;
-  for (it = triggers.begin(); it != triggers.end(); ++it)
-  {
-    if ( ((*it)->EntityType() == GiverType) && (*it)->isActive())
-    {
-      double cost = 
-      m_pOwner->GetWorld()->GetMap()->CalculateCostToTravelBetweenNodes(nd,
-                                                      (*it)->GraphNodeIndex());
-
-      if (cost < ClosestSoFar)
-      {
-        ClosestSoFar = cost;
-      }
-    }
-  }
+  const Raven_Map::ItemDistanceField* pField =
+                  m_pOwner->GetWorld()->GetMap()->GetItemDistanceField(GiverType);
 
   //return a negative value if no active trigger of the type found
-  if (isEqual(ClosestSoFar, MaxDouble))
+  if (!pField || pField->ClosestSource(nd) == invalid_node_index)
   {
     return -1;
   }
 
-  return ClosestSoFar;
+  return pField->Cost(nd);
 }
 
 
@@ -133,28 +135,107 @@ Raven_PathPlanner::Path Raven_PathPlanner::GetPath()
                             GetNodePosition(closest),
                             NavGraphEdge::normal));
 
-  
+  FinishPath(path);
+
+  return path;
+}
+
+//------------------------------ FinishPath -----------------------------------
+//-----------------------------------------------------------------------------
+void Raven_PathPlanner::FinishPath(Path& path)
+{
   //if the bot requested a path to a location then an edge leading to the
   //destination must be added
-  if (m_pCurrentSearch->GetType() == Graph_SearchTimeSliced<EdgeType>::AStar)
+  if (m_pCurrentSearch->GetType() == Graph_SearchTimeSliced<EdgeType>::AStar &&
+      !isPathPartial())
   {   
-    path.push_back(PathEdge(path.back().Destination(),
+    //the last leg of a hierarchical path may have no edges, in which case
+    //the edge starts from the last node of the path
+    Vector2D from = m_pOwner->Pos();
+
+    if (!path.empty())
+    {
+      from = path.back().Destination();
+    }
+    else if (!m_pCurrentSearch->GetPathToTarget().empty())
+    {
+      from = GetNodePosition(m_pCurrentSearch->GetPathToTarget().back());
+    }
+
+    path.push_back(PathEdge(from,
                             m_vDestinationPos,
                             NavGraphEdge::normal));
   }
 
+  //an any-angle path is already as smooth as it can be, apart from its ends
+  if (m_pAnyAngleSearch)
+  {
+    SmoothPathEnds(path);
+  }
+
   //smooth paths if required
-  if (UserOptions->m_bSmoothPathsQuick)
+  else if (UserOptions->m_bSmoothPathsQuick)
   {
     SmoothPathEdgesQuick(path);
   }
 
-  if (UserOptions->m_bSmoothPathsPrecise)
+  else if (UserOptions->m_bSmoothPathsPrecise)
   {
     SmoothPathEdgesPrecise(path);
   }
+}
 
-  return path;
+//---------------------------- SmoothPathEnds ---------------------------------
+//-----------------------------------------------------------------------------
+void Raven_PathPlanner::SmoothPathEnds(Path& path)
+{
+  if (path.size() < 2) return;
+
+  Path::iterator e1(path.begin()), e2(path.begin());
+
+  ++e2;
+
+  if ((e2->Behavior() == EdgeType::normal) &&
+       m_pOwner->canWalkBetween(e1->Source(), e2->Destination()))
+  {
+    e1->SetDestination(e2->Destination());
+    path.erase(e2);
+  }
+
+  if (path.size() < 2) return;
+
+  e2 = path.end(); --e2;
+  e1 = e2;         --e1;
+
+  if ((e1->Behavior() == EdgeType::normal) &&
+       m_pOwner->canWalkBetween(e1->Source(), e2->Destination()))
+  {
+    e1->SetDestination(e2->Destination());
+    path.erase(e2);
+  }
+}
+
+//---------------------------- isPathPartial ----------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_PathPlanner::isPathPartial()const
+{
+  return m_pHierarchicalSearch && !m_pHierarchicalSearch->isFullyRefined();
+}
+
+//------------------------------ GetNextLeg -----------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_PathPlanner::GetNextLeg(unsigned int SearchID, Path& NextLeg)
+{
+  if (SearchID != m_iSearchID || !isPathPartial()) return false;
+
+  NextLeg = m_pHierarchicalSearch->RefineNextLeg();
+
+  //the whole path is known once the last leg has been refined
+  if (!isPathPartial()) CacheResult(true);
+
+  FinishPath(NextLeg);
+
+  return true;
 }
 
 //--------------------------- SmoothPathEdgesQuick ----------------------------
@@ -163,6 +244,8 @@ Raven_PathPlanner::Path Raven_PathPlanner::GetPath()
 //-----------------------------------------------------------------------------
 void Raven_PathPlanner::SmoothPathEdgesQuick(Path& path)
 {
+  if (path.empty()) return;
+
   //create a couple of iterators and point them at the front of the path
   Path::iterator e1(path.begin()), e2(path.begin());
 
@@ -246,9 +329,45 @@ void Raven_PathPlanner::SmoothPathEdgesPrecise(Path& path)
 //-----------------------------------------------------------------------------
 int Raven_PathPlanner::CycleOnce()const
 {
-  assert (m_pCurrentSearch && "<Raven_PathPlanner::CycleOnce>: No search object instantiated");
+  int result = CycleSearch();
+
+  NotifyOwner(result);
+
+  return result;
+}
+
+//--------------------------- CycleSearch -------------------------------------
+//-----------------------------------------------------------------------------
+int Raven_PathPlanner::CycleSearch()const
+{
+  assert (m_pCurrentSearch && "<Raven_PathPlanner::CycleSearch>: No search object instantiated");
+
+  return m_pCurrentSearch->CycleOnce();
+}
+
+//--------------------------- CanSearchOnWorker -------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_PathPlanner::CanSearchOnWorker()const
+{
+  //the incremental search reads the state of the doors and the any-angle
+  //search the positions of the walls
+  return m_pCurrentSearch &&
+         m_pCurrentSearch != m_pIncrementalSearch &&
+         m_pCurrentSearch != m_pAnyAngleSearch &&
+         m_pCurrentSearch->GetType() == Graph_SearchTimeSliced<EdgeType>::AStar;
+}
 
-  int result = m_pCurrentSearch->CycleOnce();
+//--------------------------- NotifyOwner -------------------------------------
+//
+//  lets the bot know the outcome of a terminated search
+//-----------------------------------------------------------------------------
+void Raven_PathPlanner::NotifyOwner(int result)const
+{
+  //a hierarchical path is not cached until the last of it has been refined
+  if (result == target_not_found || (result == target_found && !isPathPartial()))
+  {
+    CacheResult(result == target_found);
+  }
 
   //let the bot know of the failure to find a path
   if (result == target_not_found)
@@ -277,8 +396,6 @@ int Raven_PathPlanner::CycleOnce()const
                             Msg_PathReady,
                             pTrigger);
   }
-
-  return result;
 }
 
 //------------------------ GetClosestNodeToPosition ---------------------------
@@ -321,6 +438,109 @@ int Raven_PathPlanner::GetClosestNodeToPosition(Vector2D pos)const
   return ClosestNode;
 }
 
+//--------------------------- FindCachedResult --------------------------------
+//-----------------------------------------------------------------------------
+bool Raven_PathPlanner::FindCachedResult(int source, int target, bool bItemType)
+{
+  Raven_Map* pMap = m_pOwner->GetWorld()->GetMap();
+
+  m_iCacheSource         = source;
+  m_iCacheTarget         = target;
+  m_iCacheGraphVersion   = pMap->GetNavGraphVersion();
+  m_iCacheTriggerVersion = pMap->GetTriggerVersion();
+
+  const Raven_Map::SearchPathCache::Entry* pEntry;
+
+  if (bItemType)
+  {
+    pEntry = pMap->GetPathCache().FindPathToItem(source,
+                                                 target,
+                                                 m_iCacheGraphVersion,
+                                                 m_iCacheTriggerVersion);
+  }
+  else
+  {
+    pEntry = pMap->GetPathCache().FindPathToNode(source,
+                                                 target,
+                                                 m_iCacheGraphVersion);
+  }
+
+  if (!pEntry)
+  {
+    m_bCacheResult = true; return false;
+  }
+
+  typedef Graph_SearchCached_TS<Raven_Map::SearchGraph> CachedSearch;
+
+  m_pCurrentSearch = new CachedSearch(m_NavGraph,
+                                      bItemType ? Graph_SearchTimeSliced<EdgeType>::Dijkstra :
+                                                  Graph_SearchTimeSliced<EdgeType>::AStar,
+                                      source,
+                                      pEntry->bFound,
+                                      pEntry->Path);
+
+  return true;
+}
+
+//----------------------------- CacheResult -----------------------------------
+//-----------------------------------------------------------------------------
+void Raven_PathPlanner::CacheResult(bool bFound)const
+{
+  if (!m_bCacheResult) return;
+
+  Raven_Map::SearchPathCache::EdgeList path;
+
+  if (bFound)
+  {
+    std::list<int> nodes = m_pCurrentSearch->GetPathToTarget();
+
+    std::list<int>::const_iterator from = nodes.begin(), to = nodes.begin();
+    for (++to; to != nodes.end(); ++from, ++to)
+    {
+      path.push_back(&m_NavGraph.GetEdge(*from, *to));
+    }
+  }
+
+  Raven_Map::SearchPathCache& cache = m_pOwner->GetWorld()->GetMap()->GetPathCache();
+
+  if (m_pCurrentSearch->GetType() == Graph_SearchTimeSliced<EdgeType>::Dijkstra)
+  {
+    cache.AddPathToItem(m_iCacheSource,
+                        m_iCacheTarget,
+                        bFound,
+                        path,
+                        m_iCacheGraphVersion,
+                        m_iCacheTriggerVersion);
+  }
+  else
+  {
+    cache.AddPathToNode(m_iCacheSource,
+                        m_iCacheTarget,
+                        bFound,
+                        path,
+                        m_iCacheGraphVersion);
+  }
+}
+
+//---------------------------- RegisterSearch ---------------------------------
+//
+//  background requests are given a deadline so that they are not starved
+//  indefinitely by the more urgent ones
+//-----------------------------------------------------------------------------
+void Raven_PathPlanner::RegisterSearch(int priority)
+{
+  if (m_pOwner->isPossessed()) priority = path_priority_player;
+
+  int MaxUpdates = 0;
+
+  if (priority == path_priority_background)
+  {
+    MaxUpdates = script->GetInt("BackgroundPathDeadline");
+  }
+
+  m_pOwner->GetWorld()->GetPathManager()->Register(this, priority, MaxUpdates);
+}
+
 //--------------------------- RequestPathToPosition ------------------------------
 //
 //  Given a target, this method first determines if nodes can be reached from 
@@ -332,7 +552,7 @@ int Raven_PathPlanner::GetClosestNodeToPosition(Vector2D pos)const
 //  method then returns true.
 //        
 //-----------------------------------------------------------------------------
-bool Raven_PathPlanner::RequestPathToPosition(Vector2D TargetPos)
+bool Raven_PathPlanner::RequestPathToPosition(Vector2D TargetPos, int priority)
 { 
   #ifdef SHOW_NAVINFO
     debug_con << "------------------------------------------------" << "";
@@ -390,28 +610,161 @@ bool Raven_PathPlanner::RequestPathToPosition(Vector2D TargetPos)
     debug_con << "Closest node to target is " << ClosestNodeToTarget << "";
 #endif
 
-  //create an instance of a the distributed A* search class
-  typedef Graph_SearchAStar_TS<Raven_Map::NavGraph, Heuristic_Euclid> AStar;
-   
-  m_pCurrentSearch = new AStar(m_NavGraph,
-                               ClosestNodeToBot,
-                               ClosestNodeToTarget);
+  const CompressedPathTable* pTable = m_pOwner->GetWorld()->GetMap()->GetPathTable();
+
+  //if the doors alter the edge costs the path is planned incrementally.
+  //Otherwise, if the map has a table of next nodes the path is read from it
+  //without searching, or else a recent search between the same nodes will
+  //have found the same path. (either way the result is still registered with
+  //the path manager so the bot is notified in the usual way)
+  if (m_pOwner->GetWorld()->GetMap()->HasDoorEdgeCosts())
+  {
+    PrepareIncrementalSearch(ClosestNodeToBot, ClosestNodeToTarget);
+  }
+
+  //if smooth paths are wanted an any-angle search finds one directly,
+  //rather than the path found by any other means being smoothed afterwards
+  else if (UserOptions->m_bSmoothPathsPrecise)
+  {
+    m_pAnyAngleSearch = new AnyAngleSearch(m_NavGraph,
+                                           ClosestNodeToBot,
+                                           ClosestNodeToTarget,
+                                           WalkTest(m_pOwner),
+                                           &m_pOwner->GetWorld()->GetPathManager()->GetWorkspaces());
+
+    m_pCurrentSearch = m_pAnyAngleSearch;
+  }
+  else if (pTable)
+  {
+    std::vector<const EdgeType*> path;
+
+    int nd = ClosestNodeToBot;
+
+    while (nd != ClosestNodeToTarget)
+    {
+      int next = pTable->GetNextNode(nd, ClosestNodeToTarget);
+
+      if (next == invalid_node_index) break;
+
+      path.push_back(&m_NavGraph.GetEdge(nd, next));
+
+      nd = next;
+    }
+
+    typedef Graph_SearchCached_TS<Raven_Map::SearchGraph> CachedSearch;
+
+    m_pCurrentSearch = new CachedSearch(m_NavGraph,
+                                        Graph_SearchTimeSliced<EdgeType>::AStar,
+                                        ClosestNodeToBot,
+                                        nd == ClosestNodeToTarget,
+                                        path);
+  }
+  else if (!FindCachedResult(ClosestNodeToBot, ClosestNodeToTarget, false))
+  {
+    //the remaining cost of a path is estimated using the map's landmarks
+    Heuristic_Landmarks heuristic(m_pOwner->GetWorld()->GetMap()->GetLandmarks());
+
+    //if the map has been divided into clusters and the path leaves the
+    //bot's cluster plan it hierarchically
+    const Raven_Map::NavHierarchy* pHierarchy = m_pOwner->GetWorld()->GetMap()->GetNavHierarchy();
+
+    if (pHierarchy &&
+        pHierarchy->Cluster(ClosestNodeToBot) != pHierarchy->Cluster(ClosestNodeToTarget))
+    {
+      m_pHierarchicalSearch = new HierarchicalSearch(*pHierarchy,
+                                                     ClosestNodeToBot,
+                                                     ClosestNodeToTarget,
+                                                     heuristic);
+
+      m_pCurrentSearch = m_pHierarchicalSearch;
+    }
+
+    //long paths are searched for from both ends at once (see Params.lua)
+    else if (script->GetDouble("BidirectionalSearchMinDistance") > 0 &&
+             Vec2DDistance(m_NavGraph.GetNode(ClosestNodeToBot).Pos(),
+                           m_NavGraph.GetNode(ClosestNodeToTarget).Pos()) >=
+             script->GetDouble("BidirectionalSearchMinDistance"))
+    {
+      typedef Graph_SearchBidirectionalAStar_TS<Raven_Map::SearchGraph, Heuristic_Landmarks> BiAStar;
+
+      m_pCurrentSearch = new BiAStar(m_NavGraph,
+                                     ClosestNodeToBot,
+                                     ClosestNodeToTarget,
+                                     &m_pOwner->GetWorld()->GetPathManager()->GetWorkspaces(),
+                                     heuristic);
+    }
+
+    //otherwise create an instance of a the distributed A* search class
+    else
+    {
+      typedef Graph_SearchAStar_TS<Raven_Map::SearchGraph, Heuristic_Landmarks> AStar;
+       
+      m_pCurrentSearch = new AStar(m_NavGraph,
+                                   ClosestNodeToBot,
+                                   ClosestNodeToTarget,
+                                   &m_pOwner->GetWorld()->GetPathManager()->GetWorkspaces(),
+                                   heuristic);
+    }
+  }
 
   //and register the search with the path manager
-  m_pOwner->GetWorld()->GetPathManager()->Register(this);
+  RegisterSearch(priority);
 
   return true;
 }
 
 
+//------------------------- PrepareIncrementalSearch --------------------------
+//
+//  the kept search is reused if it is to the same target. It is told of the
+//  bot's new position and, if any door has changed state since it was last
+//  used, of every edge through a door. (the costs of edges through doors
+//  that have not changed are unaffected)
+//-----------------------------------------------------------------------------
+void Raven_PathPlanner::PrepareIncrementalSearch(int source, int target)
+{
+  Raven_Map* pMap = m_pOwner->GetWorld()->GetMap();
+
+  if (m_pIncrementalSearch && m_pIncrementalSearch->GetTarget() == target)
+  {
+    m_pIncrementalSearch->SetSource(source);
+
+    if (m_iIncrementalGraphVersion != pMap->GetNavGraphVersion())
+    {
+      const std::vector<std::pair<int, int> >& edges = pMap->GetDoorEdges();
+
+      for (unsigned int e=0; e<edges.size(); ++e)
+      {
+        m_pIncrementalSearch->EdgeCostChanged(edges[e].first, edges[e].second);
+      }
+    }
+  }
+  else
+  {
+    delete m_pIncrementalSearch;
+
+    m_pIncrementalSearch = new IncrementalSearch(m_NavGraph,
+                                                 source,
+                                                 target,
+                                                 Heuristic_Landmarks(pMap->GetLandmarks()),
+                                                 Raven_Map::DoorEdgeCost(pMap));
+  }
+
+  m_iIncrementalGraphVersion = pMap->GetNavGraphVersion();
+
+  m_pCurrentSearch = m_pIncrementalSearch;
+}
+
 //------------------------------ RequestPathToItem -----------------------------
 //
 // Given an item type, this method determines the closest reachable graph node
 // to the bot's position and then creates a instance of the time-sliced 
-// Dijkstra's algorithm, which it registers with the search manager
+// Dijkstra's algorithm, which it registers with the search manager. (for the
+// item types the map keeps distance fields for, the registered search simply
+// hands back the path read from the field)
 //
 //-----------------------------------------------------------------------------
-bool Raven_PathPlanner::RequestPathToItem(unsigned int ItemType)
+bool Raven_PathPlanner::RequestPathToItem(unsigned int ItemType, int priority)
 {    
   //clear the waypoint list and delete any active search
   GetReadyForNewSearch();
@@ -432,16 +785,40 @@ bool Raven_PathPlanner::RequestPathToItem(unsigned int ItemType)
     return false; 
   }
 
-  //create an instance of the search algorithm
-  typedef FindActiveTrigger<Trigger<Raven_Bot> > t_con; 
-  typedef Graph_SearchDijkstras_TS<Raven_Map::NavGraph, t_con> DijSearch;
-  
-  m_pCurrentSearch = new DijSearch(m_NavGraph,
-                                   ClosestNodeToBot,
-                                   ItemType);  
+  const Raven_Map::ItemDistanceField* pField =
+                   m_pOwner->GetWorld()->GetMap()->GetItemDistanceField(ItemType);
+
+  //if the map keeps a distance field for the item type the path to the
+  //closest active item is simply read from it. Otherwise create an instance
+  //of the search algorithm, unless a recent search from the same node for
+  //the same item type can be reused
+  if (pField)
+  {
+    std::vector<const EdgeType*> path;
+
+    bool bFound = pField->GetPathToClosestSource(ClosestNodeToBot, path);
+
+    typedef Graph_SearchCached_TS<Raven_Map::SearchGraph> CachedSearch;
+
+    m_pCurrentSearch = new CachedSearch(m_NavGraph,
+                                        Graph_SearchTimeSliced<EdgeType>::Dijkstra,
+                                        ClosestNodeToBot,
+                                        bFound,
+                                        path);
+  }
+  else if (!FindCachedResult(ClosestNodeToBot, ItemType, true))
+  {
+    typedef FindActiveTrigger<Trigger<Raven_Bot> > t_con; 
+    typedef Graph_SearchDijkstras_TS<Raven_Map::SearchGraph, t_con> DijSearch;
+    
+    m_pCurrentSearch = new DijSearch(m_NavGraph,
+                                     ClosestNodeToBot,
+                                     ItemType,
+                                     &m_pOwner->GetWorld()->GetPathManager()->GetWorkspaces());
+  }
 
   //register the search with the path manager
-  m_pOwner->GetWorld()->GetPathManager()->Register(this);
+  RegisterSearch(priority);
 
   return true;
 }
@@ -14,6 +14,7 @@
 #include "Graph/GraphAlgorithms.h"
 #include "Graph/SparseGraph.h"
 #include "PathEdge.h"
+#include "PathPriority.h"
 #include "../Raven_Map.h"
 
 class Raven_Bot;
@@ -36,23 +37,76 @@ public:
   
 private:
 
+  typedef Graph_SearchHPA_TS<Raven_Map::SearchGraph, Heuristic_Landmarks> HierarchicalSearch;
+
+  typedef Graph_SearchDStarLite_TS<Raven_Map::SearchGraph,
+                                   Heuristic_Landmarks,
+                                   Raven_Map::DoorEdgeCost>               IncrementalSearch;
+
+  //a walk_test policy for the any-angle search. The way between two
+  //positions is clear if the owner could walk it
+  class WalkTest
+  {
+  private:
+
+    const Raven_Bot* m_pBot;
+
+  public:
+
+    WalkTest(const Raven_Bot* pBot):m_pBot(pBot){}
+
+    bool isWalkable(Vector2D from, Vector2D to)const;
+  };
+
+  //the landmarks may overestimate the length of an any-angle path so the
+  //straight line distance is used
+  typedef Graph_SearchThetaStar_TS<Raven_Map::SearchGraph,
+                                   Heuristic_Euclid,
+                                   WalkTest>                              AnyAngleSearch;
+
   //A pointer to the owner of this class
   Raven_Bot*                          m_pOwner;
 
-  //a reference to the navgraph
-  const Raven_Map::NavGraph&          m_NavGraph;
+  //a reference to the map's read only copy of the navgraph (see CSRGraph.h)
+  const Raven_Map::SearchGraph&       m_NavGraph;
 
   //a pointer to an instance of the current graph search algorithm.
   Graph_SearchTimeSliced<EdgeType>*  m_pCurrentSearch;
+
+  //if the current search is hierarchical this points to it too, so the
+  //rest of its path can be refined as the bot follows it
+  HierarchicalSearch*                 m_pHierarchicalSearch;
+
+  //if the current search is any-angle this points to it too. Its paths
+  //need no smoothing
+  AnyAngleSearch*                     m_pAnyAngleSearch;
+
+  //on maps where the doors alter the edge costs paths to positions are
+  //planned with an incremental search. It is kept after it has finished and
+  //reused if the next path is to the same node, when it need only repair the
+  //parts affected by the bot's movement and by doors changing state since
+  //the navgraph version noted
+  IncrementalSearch*                  m_pIncrementalSearch;
+  unsigned int                        m_iIncrementalGraphVersion;
+
+  //incremented with each new search so that the path following goals can
+  //tell if the search that gave them their path has been replaced
+  unsigned int                        m_iSearchID;
+
+  //true if the result of the current search should be added to the map's
+  //path cache once known. The search's source and target (a node or an
+  //item type) and the versions of the navgraph and triggers when it was
+  //requested are kept for the purpose
+  bool                                m_bCacheResult;
+  int                                 m_iCacheSource;
+  int                                 m_iCacheTarget;
+  unsigned int                        m_iCacheGraphVersion;
+  unsigned int                        m_iCacheTriggerVersion;
   
   //this is the position the bot wishes to plan a path to reach
   Vector2D                            m_vDestinationPos;
 
 
-  //returns the index of the closest visible and unobstructed graph node to
-  //the given position
-  int   GetClosestNodeToPosition(Vector2D pos)const;
-
   //smooths a path by removing extraneous edges. (may not remove all
   //extraneous edges)
   void  SmoothPathEdgesQuick(Path& path);
@@ -61,10 +115,34 @@ private:
   //edges)
   void  SmoothPathEdgesPrecise(Path& path);
 
+  //cuts across the corners at either end of an any-angle path, where it
+  //joins the bot's position and the destination
+  void  SmoothPathEnds(Path& path);
+
+  //adds the edge to the destination (if the path is to a position and is
+  //complete) and smooths the path as the user options require
+  void  FinishPath(Path& path);
+
   //called at the commencement of a new search request. It clears up the 
   //appropriate lists and memory in preparation for a new search request
   void  GetReadyForNewSearch();
 
+  //makes m_pCurrentSearch the incremental search from the source node to
+  //the target node
+  void  PrepareIncrementalSearch(int source, int target);
+
+  //if the map's path cache holds a valid result for the search this makes
+  //m_pCurrentSearch a search that simply returns it and returns true.
+  //Otherwise the search is noted so that its result can be cached
+  bool  FindCachedResult(int source, int target, bool bItemType);
+
+  //adds the result of the current search to the map's path cache
+  void  CacheResult(bool bFound)const;
+
+  //registers m_pCurrentSearch with the path manager. The requests of a bot
+  //possessed by the player are always given the player's priority
+  void  RegisterSearch(int priority);
+
 
 
 public:
@@ -74,12 +152,14 @@ public:
   Raven_PathPlanner(Raven_Bot* owner);
 
   //creates an instance of the A* time-sliced search and registers it with
-  //the path manager
-  bool       RequestPathToItem(unsigned int ItemType);
+  //the path manager at the given priority (see PathPriority.h)
+  bool       RequestPathToItem(unsigned int ItemType,
+                               int          priority = path_priority_normal);
 
   //creates an instance of the Dijkstra's time-sliced search and registers 
-  //it with the path manager
-  bool       RequestPathToPosition(Vector2D TargetPos);
+  //it with the path manager at the given priority
+  bool       RequestPathToPosition(Vector2D TargetPos,
+                                   int      priority = path_priority_normal);
 
   //called by an agent after it has been notified that a search has terminated
   //successfully. The method extracts the path from m_pCurrentSearch, adds
@@ -87,23 +167,50 @@ public:
   //PathEdges.
   Path       GetPath();
 
+  //a path found by a hierarchical search is handed out a leg at a time.
+  //This returns true if the path returned by GetPath has more legs to come
+  bool       isPathPartial()const;
+
+  //identifies the current search (see GetNextLeg)
+  unsigned int GetSearchID()const{return m_iSearchID;}
+
+  //called as a bot following a partial path nears the end of what it has.
+  //Refines the next leg of the path and returns it in NextLeg. Returns false
+  //if the search with the given ID has been replaced
+  bool       GetNextLeg(unsigned int SearchID, Path& NextLeg);
+
+  //returns the index of the closest visible and unobstructed graph node to
+  //the given position
+  int        GetClosestNodeToPosition(Vector2D pos)const;
+
   //returns the cost to travel from the bot's current position to a specific 
   //graph node. This method makes use of the pre-calculated lookup table
   //created by Raven_Game
   double      GetCostToNode(unsigned int NodeIdx)const;
 
   //returns the cost to the closest instance of the GiverType. This method
-  //also makes use of the pre-calculated lookup table. Returns -1 if no active
+  //reads the map's distance field for the type. Returns -1 if no active
   //trigger found
   double      GetCostToClosestItem(unsigned int GiverType)const;
 
   
-  //the path manager calls this to iterate once though the search cycle
-  //of the currently assigned search algorithm. When a search is terminated
-  //the method messages the owner with either the msg_NoPathAvailable or
-  //msg_PathReady messages
+  //iterates once though the search cycle of the currently assigned search
+  //algorithm. When a search is terminated the method messages the owner
+  //with either the msg_NoPathAvailable or msg_PathReady messages
   int        CycleOnce()const;
 
+  //as above but the owner is not messaged. The path manager uses this and
+  //calls NotifyOwner from the game thread once the search has terminated
+  int        CycleSearch()const;
+
+  //messages the owner with the result of a terminated search
+  void       NotifyOwner(int result)const;
+
+  //returns true if the current search only reads the navgraph and so may be
+  //run on one of the path manager's worker threads. (a search for an item
+  //type tests the state of the item triggers as it goes so is not)
+  bool       CanSearchOnWorker()const;
+
   Vector2D   GetDestination()const{return m_vDestinationPos;}
   void       SetDestination(Vector2D NewPos){m_vDestinationPos = NewPos;}
 
@@ -0,0 +1,184 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   SearchWorkspace.h
+//
+//  Desc:   the per-node arrays and priority queue used by the time-sliced
+//          searches.
+//
+//          Rather than zero every array at the start of a search, each
+//          node carries the number of the search that last wrote to it.
+//          A node whose stamp is not the current search's is treated as
+//          untouched (not on the frontier or the SPT), so starting a new
+//          search only needs the search number to be incremented.
+//
+//          SearchWorkspacePool keeps the workspaces of finished searches
+//          for reuse, so once a game has warmed up starting a search
+//          allocates no memory at all.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <cassert>
+
+#include "misc/PriorityQueue.h"
+
+
+template <class edge_type>
+class SearchWorkspace
+{
+private:
+
+  //the number of the current search
+  unsigned int                   m_iSearch;
+
+  //indexed by node. The number of the search that last touched each node
+  std::vector<unsigned int>      m_Stamps;
+
+  //indexed by node. The cost of the cheapest path found so far from the
+  //source (G) and that cost plus the heuristic (F). The queue is keyed on F
+  std::vector<double>            m_GCosts;
+  std::vector<double>            m_FCosts;
+
+  std::vector<const edge_type*>  m_ShortestPathTree;
+  std::vector<const edge_type*>  m_SearchFrontier;
+
+  IndexedPriorityQLow<double>*   m_pPQ;
+
+  //no copies; the PQ refers to m_FCosts
+  SearchWorkspace(const SearchWorkspace&);
+  SearchWorkspace& operator=(const SearchWorkspace&);
+
+public:
+
+  SearchWorkspace():m_iSearch(0), m_pPQ(NULL){}
+
+  ~SearchWorkspace(){delete m_pPQ;}
+
+  //readies the workspace for a new search of a graph with NumNodes nodes.
+  //This is constant time unless the graph is a different size to the last
+  //one searched or the search number wraps around
+  void Reset(int NumNodes)
+  {
+    if ((int)m_Stamps.size() != NumNodes)
+    {
+      m_Stamps.assign(NumNodes, 0);
+      m_GCosts.resize(NumNodes);
+      m_FCosts.resize(NumNodes);
+      m_ShortestPathTree.resize(NumNodes);
+      m_SearchFrontier.resize(NumNodes);
+
+      delete m_pPQ;
+      m_pPQ = new IndexedPriorityQLow<double>(m_FCosts, NumNodes);
+
+      m_iSearch = 0;
+    }
+
+    if (++m_iSearch == 0)
+    {
+      m_Stamps.assign(NumNodes, 0);
+
+      m_iSearch = 1;
+    }
+
+    m_pPQ->clear();
+  }
+
+  int  NumNodes()const{return m_Stamps.size();}
+
+  //returns true if the node has been reached by the current search
+  bool isTouched(int node)const{return m_Stamps[node] == m_iSearch;}
+
+  //marks a node as reached by the current search with the given costs.
+  //It is neither on the frontier nor the SPT until those are set
+  void Touch(int node, double GCost, double FCost)
+  {
+    m_Stamps[node]           = m_iSearch;
+    m_GCosts[node]           = GCost;
+    m_FCosts[node]           = FCost;
+    m_ShortestPathTree[node] = NULL;
+    m_SearchFrontier[node]   = NULL;
+  }
+
+  //these may only be called for nodes touched by the current search
+  double GCost(int node)const{assert(isTouched(node)); return m_GCosts[node];}
+  double FCost(int node)const{assert(isTouched(node)); return m_FCosts[node];}
+
+  void   SetCosts(int node, double GCost, double FCost)
+  {
+    assert(isTouched(node));
+
+    m_GCosts[node] = GCost;
+    m_FCosts[node] = FCost;
+  }
+
+  void   SetFrontier(int node, const edge_type* pE){assert(isTouched(node)); m_SearchFrontier[node] = pE;}
+  void   SetSPT(int node, const edge_type* pE){assert(isTouched(node)); m_ShortestPathTree[node] = pE;}
+
+  //these return NULL for untouched nodes
+  const edge_type* Frontier(int node)const{return isTouched(node) ? m_SearchFrontier[node] : NULL;}
+  const edge_type* SPT(int node)const{return isTouched(node) ? m_ShortestPathTree[node] : NULL;}
+
+  IndexedPriorityQLow<double>& PQ(){return *m_pPQ;}
+};
+
+
+//------------------------- SearchWorkspacePool -------------------------------
+//
+//  hands out workspaces to searches and takes them back when the searches
+//  are finished with them
+//-----------------------------------------------------------------------------
+template <class edge_type>
+class SearchWorkspacePool
+{
+private:
+
+  typedef SearchWorkspace<edge_type> Workspace;
+
+  //the workspaces not currently in use
+  std::vector<Workspace*>  m_Free;
+
+  SearchWorkspacePool(const SearchWorkspacePool&);
+  SearchWorkspacePool& operator=(const SearchWorkspacePool&);
+
+public:
+
+  SearchWorkspacePool(){}
+
+  //every workspace must have been released before the pool is destroyed
+  ~SearchWorkspacePool()
+  {
+    for (unsigned int w=0; w<m_Free.size(); ++w) delete m_Free[w];
+  }
+
+  //returns a workspace reset for a search of a graph of NumNodes nodes
+  Workspace* Acquire(int NumNodes)
+  {
+    Workspace* pWorkspace;
+
+    if (m_Free.empty())
+    {
+      pWorkspace = new Workspace();
+    }
+    else
+    {
+      pWorkspace = m_Free.back();
+      m_Free.pop_back();
+    }
+
+    pWorkspace->Reset(NumNodes);
+
+    return pWorkspace;
+  }
+
+  void Release(Workspace* pWorkspace)
+  {
+    if (pWorkspace) m_Free.push_back(pWorkspace);
+  }
+
+  int  NumFree()const{return m_Free.size();}
+};
+
+
+
+#endif
@@ -10,6 +10,28 @@
 //
 //          Any graphs passed to these functions must conform to the
 //          same interface used by the SparseGraph
+//
+//          The per-node data of each search is kept in a SearchWorkspace.
+//          If a search is given a SearchWorkspacePool it borrows a
+//          workspace from the pool for its lifetime, otherwise it creates
+//          its own
+//
+//          Graph_SearchBidirectionalAStar_TS searches from both ends of
+//          the path at once
+//
+//          Graph_SearchThetaStar_TS finds any-angle paths that cut across
+//          the graph wherever the way is clear
+//
+//          Graph_SearchHPA_TS plans over a HierarchicalGraph and only turns
+//          the first stretch of the path into graph edges. The rest is
+//          refined on request as the bot follows the path
+//
+//          Graph_SearchCached_TS does no searching at all. It hands back the
+//          result of an earlier search (see PathCache.h)
+//
+//          Graph_SearchDStarLite_TS is kept from one search to the next. When
+//          the source moves or edge costs change it only repairs the part of
+//          its search that is affected
 //          
 //  Author: Mat Buckland (fup@ai-junkie.com)
 //
@@ -18,12 +40,15 @@
 #include <list>
 #include <queue>
 #include <stack>
+#include <set>
 
-#include "graph/SparseGraph.h"
+#include "Graph/SparseGraph.h"
 #include "misc/PriorityQueue.h"
 #include "Graph/AStarHeuristicPolicies.h"
+#include "Graph/HierarchicalGraph.h"
 #include "SearchTerminationPolicies.h"
 #include "PathEdge.h"
+#include "SearchWorkspace.h"
 
 
 
@@ -96,47 +121,55 @@ private:
 
   const graph_type&              m_Graph;
 
-  //indexed into my node. Contains the 'real' accumulative cost to that node
-  std::vector<double>            m_GCosts; 
-
-  //indexed into by node. Contains the cost from adding m_GCosts[n] to
-  //the heuristic cost from n to the target node. This is the vector the
-  //iPQ indexes into.
-  std::vector<double>            m_FCosts;
+  //holds the 'real' accumulative cost to each node (G), that cost plus
+  //the heuristic cost from the node to the target (F), the SPT and the
+  //search frontier. Its indexed priority queue of nodes is keyed on F so
+  //the nodes with the lowest overall cost are positioned at the front.
+  SearchWorkspace<Edge>*         m_pWorkspace;
 
-  std::vector<const Edge*>       m_ShortestPathTree;
-  std::vector<const Edge*>       m_SearchFrontier;
+  //the pool the workspace is returned to (NULL if the search owns it)
+  SearchWorkspacePool<Edge>*     m_pPool;
 
   int                            m_iSource;
   int                            m_iTarget;
 
-  //create an indexed priority queue of nodes. The nodes with the
-  //lowest overall F cost (G+H) are positioned at the front.
-  IndexedPriorityQLow<double>*    m_pPQ;
+  heuristic                      m_Heuristic;
 
  
 public:
 
-  Graph_SearchAStar_TS(const graph_type& G,
-                      int                source,
-                      int                target):Graph_SearchTimeSliced<Edge>(AStar),
+  Graph_SearchAStar_TS(const graph_type&          G,
+                       int                        source,
+                       int                        target,
+                       SearchWorkspacePool<Edge>* pPool = NULL,
+                       const heuristic&           h = heuristic()):Graph_SearchTimeSliced<Edge>(Graph_SearchTimeSliced<Edge>::AStar),
   
                                               m_Graph(G),
-                                              m_ShortestPathTree(G.NumNodes()),                              
-                                              m_SearchFrontier(G.NumNodes()),
-                                              m_GCosts(G.NumNodes(), 0.0),
-                                              m_FCosts(G.NumNodes(), 0.0),
+                                              m_pPool(pPool),
                                               m_iSource(source),
-                                              m_iTarget(target)
+                                              m_iTarget(target),
+                                              m_Heuristic(h)
   { 
-     //create the PQ   
-     m_pPQ =new IndexedPriorityQLow<double>(m_FCosts, m_Graph.NumNodes());
+    if (m_pPool)
+    {
+      m_pWorkspace = m_pPool->Acquire(m_Graph.NumNodes());
+    }
+    else
+    {
+      m_pWorkspace = new SearchWorkspace<Edge>();
+      m_pWorkspace->Reset(m_Graph.NumNodes());
+    }
 
     //put the source node on the queue
-    m_pPQ->insert(m_iSource);
+    m_pWorkspace->Touch(m_iSource, 0.0, 0.0);
+    m_pWorkspace->PQ().insert(m_iSource);
   }
 
-   ~Graph_SearchAStar_TS(){delete m_pPQ;}
+  ~Graph_SearchAStar_TS()
+  {
+    if (m_pPool) m_pPool->Release(m_pWorkspace);
+    else         delete m_pWorkspace;
+  }
 
 
   //When called, this method pops the next node off the PQ and examines all
@@ -145,7 +178,7 @@ public:
   int                      CycleOnce();
 
   //returns the vector of edges that the algorithm has examined
-  std::vector<const Edge*> GetSPT()const{return m_ShortestPathTree;}
+  std::vector<const Edge*> GetSPT()const;
 
   //returns a vector of node indexes that comprise the shortest path
   //from the source to the target
@@ -155,24 +188,29 @@ public:
   std::list<PathEdge>    GetPathAsPathEdges()const;
 
   //returns the total cost to the target
-  double            GetCostToTarget()const{return m_GCosts[m_iTarget];}
+  double            GetCostToTarget()const
+  {
+    return m_pWorkspace->isTouched(m_iTarget) ? m_pWorkspace->GCost(m_iTarget) : 0.0;
+  }
 };
 
 //-----------------------------------------------------------------------------
 template <class graph_type, class heuristic>
 int Graph_SearchAStar_TS<graph_type, heuristic>::CycleOnce()
 {
+  SearchWorkspace<Edge>& ws = *m_pWorkspace;
+
   //if the PQ is empty the target has not been found
-  if (m_pPQ->empty())
+  if (ws.PQ().empty())
   {
     return target_not_found;
   }
 
   //get lowest cost node from the queue
-  int NextClosestNode = m_pPQ->Pop();
+  int NextClosestNode = ws.PQ().Pop();
 
   //put the node on the SPT
-  m_ShortestPathTree[NextClosestNode] = m_SearchFrontier[NextClosestNode];
+  ws.SetSPT(NextClosestNode, ws.Frontier(NextClosestNode));
 
   //if the target has been found exit
   if (NextClosestNode == m_iTarget)
@@ -181,40 +219,38 @@ int Graph_SearchAStar_TS<graph_type, heuristic>::CycleOnce()
   }
 
   //now to test all the edges attached to this node
-  graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
+  typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
   for (const Edge* pE=ConstEdgeItr.begin();
       !ConstEdgeItr.end();
        pE=ConstEdgeItr.next())
   {
     //calculate the heuristic cost from this node to the target (H)                       
-    double HCost = heuristic::Calculate(m_Graph, m_iTarget, pE->To()); 
+    double HCost = m_Heuristic.Calculate(m_Graph, m_iTarget, pE->To()); 
 
     //calculate the 'real' cost to this node from the source (G)
-    double GCost = m_GCosts[NextClosestNode] + pE->Cost();
+    double GCost = ws.GCost(NextClosestNode) + pE->Cost();
 
-    //if the node has not been added to the frontier, add it and update
+    //if the node has not been added to the frontier, add it and set
     //the G and F costs
-    if (m_SearchFrontier[pE->To()] == NULL)
+    if (ws.Frontier(pE->To()) == NULL)
     {
-      m_FCosts[pE->To()] = GCost + HCost;
-      m_GCosts[pE->To()] = GCost;
+      ws.Touch(pE->To(), GCost, GCost + HCost);
 
-      m_pPQ->insert(pE->To());
+      ws.PQ().insert(pE->To());
 
-      m_SearchFrontier[pE->To()] = pE;
+      ws.SetFrontier(pE->To(), pE);
     }
 
     //if this node is already on the frontier but the cost to get here
     //is cheaper than has been found previously, update the node
     //costs and frontier accordingly.
-    else if ((GCost < m_GCosts[pE->To()]) && (m_ShortestPathTree[pE->To()]==NULL))
+    else if ((GCost < ws.GCost(pE->To())) && (ws.SPT(pE->To())==NULL))
     {
-      m_FCosts[pE->To()] = GCost + HCost;
-      m_GCosts[pE->To()] = GCost;
+      ws.SetCosts(pE->To(), GCost, GCost + HCost);
 
-      m_pPQ->ChangePriority(pE->To());
+      ws.PQ().ChangePriority(pE->To());
 
-      m_SearchFrontier[pE->To()] = pE;
+      ws.SetFrontier(pE->To(), pE);
     }
   }
   
@@ -222,6 +258,22 @@ int Graph_SearchAStar_TS<graph_type, heuristic>::CycleOnce()
   return search_incomplete;
 }
 
+//------------------------------- GetSPT --------------------------------------
+//
+//  the workspace only holds valid entries for the nodes this search has
+//  reached so the SPT is copied out node by node
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+std::vector<const typename graph_type::EdgeType*>
+Graph_SearchAStar_TS<graph_type, heuristic>::GetSPT()const
+{
+  std::vector<const Edge*> spt(m_pWorkspace->NumNodes());
+
+  for (unsigned int nd=0; nd<spt.size(); ++nd) spt[nd] = m_pWorkspace->SPT(nd);
+
+  return spt;
+}
+
 //-----------------------------------------------------------------------------
 template <class graph_type, class heuristic>
 std::list<int> 
@@ -236,9 +288,9 @@ Graph_SearchAStar_TS<graph_type, heuristic>::GetPathToTarget()const
 
   path.push_back(nd);
     
-  while ((nd != m_iSource) && (m_ShortestPathTree[nd] != 0))
+  while ((nd != m_iSource) && (m_pWorkspace->SPT(nd) != 0))
   {
-    nd = m_ShortestPathTree[nd]->From();
+    nd = m_pWorkspace->SPT(nd)->From();
 
     path.push_front(nd);
   }
@@ -262,219 +314,1720 @@ Graph_SearchAStar_TS<graph_type, heuristic>::GetPathAsPathEdges()const
 
   int nd = m_iTarget;
     
-  while ((nd != m_iSource) && (m_ShortestPathTree[nd] != 0))
+  while ((nd != m_iSource) && (m_pWorkspace->SPT(nd) != 0))
   {
-    path.push_front(PathEdge(m_Graph.GetNode(m_ShortestPathTree[nd]->From()).Pos(),
-                             m_Graph.GetNode(m_ShortestPathTree[nd]->To()).Pos(),
-                             m_ShortestPathTree[nd]->Flags(),
-                             m_ShortestPathTree[nd]->IDofIntersectingEntity()));
+    const Edge* pE = m_pWorkspace->SPT(nd);
+
+    path.push_front(PathEdge(m_Graph.GetNode(pE->From()).Pos(),
+                             m_Graph.GetNode(pE->To()).Pos(),
+                             pE->Flags(),
+                             pE->IDofIntersectingEntity()));
 
-    nd = m_ShortestPathTree[nd]->From();
+    nd = pE->From();
   }
 
   return path;
 }
 
-//-------------------------- Graph_SearchDijkstras_TS -------------------------
+//--------------------- Graph_SearchBidirectionalAStar_TS ---------------------
 //
-//  Dijkstra's algorithm class modified to spread a search over multiple
-//  update-steps
+//  A* run from the source and from the target at once. Each cycle expands a
+//  node of whichever search has the smaller frontier, so on long paths the
+//  two searches together cover far less of the graph than one would.
+//
+//  For the keys of the two searches to be comparable each uses half the
+//  heuristic cost toward its own goal less half that toward the other's. The
+//  search finishes when the keys at the front of the two queues sum to no
+//  less than the cost of the cheapest path found through a node reached by
+//  both.
+//
+//  The graph must be undirected.
 //-----------------------------------------------------------------------------
-template <class graph_type, class termination_condition>
-class Graph_SearchDijkstras_TS : public Graph_SearchTimeSliced<typename graph_type::EdgeType>
+template <class graph_type, class heuristic>
+class Graph_SearchBidirectionalAStar_TS : public Graph_SearchTimeSliced<typename graph_type::EdgeType>
 {
 private:
 
-  //create typedefs for the node and edge types used by the graph
   typedef typename graph_type::EdgeType Edge;
-  typedef typename graph_type::NodeType Node;
 
 private:
 
-  const graph_type&                   m_Graph;
+  const graph_type&              m_Graph;
 
-  //indexed into my node. Contains the accumulative cost to that node
-  std::vector<double>             m_CostToThisNode; 
+  //the searches from the source and from the target. The edges on the
+  //SPT and frontier of the search from the target point away from it
+  SearchWorkspace<Edge>*         m_pForward;
+  SearchWorkspace<Edge>*         m_pBackward;
 
-  std::vector<const Edge*>  m_ShortestPathTree;
-  std::vector<const Edge*>  m_SearchFrontier;
+  //the pool the workspaces are returned to (NULL if the search owns them)
+  SearchWorkspacePool<Edge>*     m_pPool;
 
   int                            m_iSource;
   int                            m_iTarget;
 
-  //create an indexed priority queue of nodes. The nodes with the
-  //lowest overall F cost (G+H) are positioned at the front.
-  IndexedPriorityQLow<double>*     m_pPQ;
-
- 
+  heuristic                      m_Heuristic;
 
-public:
+  //the cheapest path found so far and the node the two searches meet at
+  //on it
+  double                         m_dBestCost;
+  int                            m_iMeetingNode;
 
-  Graph_SearchDijkstras_TS(const graph_type&  G,
-                          int                   source,
-                          int                   target):Graph_SearchTimeSliced<Edge>(Dijkstra),
-  
-                                              m_Graph(G),
-                                              m_ShortestPathTree(G.NumNodes()),                              
-                                              m_SearchFrontier(G.NumNodes()),
-                                              m_CostToThisNode(G.NumNodes(), 0.0),
-                                              m_iSource(source),
-                                              m_iTarget(target)
-  { 
-     //create the PQ         ,
-     m_pPQ =new IndexedPriorityQLow<double>(m_CostToThisNode, m_Graph.NumNodes());
+  //search_incomplete until the search has finished
+  int                            m_iResult;
 
-    //put the source node on the queue
-    m_pPQ->insert(m_iSource);
+  //the heuristic part of the forward search's key. The backward search
+  //uses the negative of this
+  double Potential(int node)const
+  {
+    return 0.5 * (m_Heuristic.Calculate(m_Graph, m_iTarget, node) -
+                  m_Heuristic.Calculate(m_Graph, m_iSource, node));
   }
 
-  //let the search class take care of tidying up memory (the wary amongst
-  //you may prefer to use std::auto_ptr or similar to replace the pointer
-  //to the termination condition)
-   ~Graph_SearchDijkstras_TS()
-   {
-     delete m_pPQ;
-   }
+  //expands the node at the front of the given search's queue. Sign is 1
+  //for the forward search and -1 for the backward
+  void Expand(SearchWorkspace<Edge>& ws, const SearchWorkspace<Edge>& other, double sign);
 
+public:
 
-  //When called, this method pops the next node off the PQ and examines all
-  //its edges. The method returns an enumerated value (target_found,
-  //target_not_found, search_incomplete) indicating the status of the search
-  int              CycleOnce();
+  Graph_SearchBidirectionalAStar_TS(const graph_type&          G,
+                                    int                        source,
+                                    int                        target,
+                                    SearchWorkspacePool<Edge>* pPool = NULL,
+                                    const heuristic&           h = heuristic());
 
-  //returns the vector of edges that the algorithm has examined
-  std::vector<const Edge*> GetSPT()const{return m_ShortestPathTree;}
+  ~Graph_SearchBidirectionalAStar_TS()
+  {
+    if (m_pPool)
+    {
+      m_pPool->Release(m_pForward);
+      m_pPool->Release(m_pBackward);
+    }
+    else
+    {
+      delete m_pForward;
+      delete m_pBackward;
+    }
+  }
 
-  //returns a vector of node indexes that comprise the shortest path
-  //from the source to the target
-  std::list<int> GetPathToTarget()const;
+  int                      CycleOnce();
 
-  //returns the path as a list of PathEdges
-  std::list<PathEdge>    GetPathAsPathEdges()const;
+  //returns the SPT of the search from the source together with the part
+  //of the path found by the search from the target
+  std::vector<const Edge*> GetSPT()const;
 
-  //returns the total cost to the target
-  double            GetCostToTarget()const{return m_CostToThisNode[m_iTarget];}
+  std::list<int>           GetPathToTarget()const;
+
+  std::list<PathEdge>      GetPathAsPathEdges()const;
+
+  double                   GetCostToTarget()const
+  {
+    return m_iResult == target_found ? m_dBestCost : 0.0;
+  }
 };
 
+
+//------------------------------- ctor ----------------------------------------
 //-----------------------------------------------------------------------------
-template <class graph_type, class termination_condition>
-int Graph_SearchDijkstras_TS<graph_type, termination_condition>::CycleOnce()
+template <class graph_type, class heuristic>
+Graph_SearchBidirectionalAStar_TS<graph_type, heuristic>::Graph_SearchBidirectionalAStar_TS(
+                                         const graph_type&          G,
+                                         int                        source,
+                                         int                        target,
+                                         SearchWorkspacePool<Edge>* pPool,
+                                         const heuristic&           h):Graph_SearchTimeSliced<Edge>(Graph_SearchTimeSliced<Edge>::AStar),
+                                                                       m_Graph(G),
+                                                                       m_pPool(pPool),
+                                                                       m_iSource(source),
+                                                                       m_iTarget(target),
+                                                                       m_Heuristic(h),
+                                                                       m_dBestCost(MaxDouble),
+                                                                       m_iMeetingNode(source),
+                                                                       m_iResult(search_incomplete)
 {
-  //if the PQ is empty the target has not been found
-  if (m_pPQ->empty())
+  assert (!G.isDigraph() && "<Graph_SearchBidirectionalAStar_TS::ctor>: the graph must be undirected");
+
+  if (m_pPool)
   {
-    return target_not_found;
+    m_pForward  = m_pPool->Acquire(m_Graph.NumNodes());
+    m_pBackward = m_pPool->Acquire(m_Graph.NumNodes());
   }
+  else
+  {
+    m_pForward = new SearchWorkspace<Edge>();
+    m_pForward->Reset(m_Graph.NumNodes());
 
-  //get lowest cost node from the queue
-  int NextClosestNode = m_pPQ->Pop();
+    m_pBackward = new SearchWorkspace<Edge>();
+    m_pBackward->Reset(m_Graph.NumNodes());
+  }
 
-  //move this node from the frontier to the spanning tree
-  m_ShortestPathTree[NextClosestNode] = m_SearchFrontier[NextClosestNode];
+  m_pForward->Touch(m_iSource, 0.0, Potential(m_iSource));
+  m_pForward->PQ().insert(m_iSource);
 
-  //if the target has been found exit
-  if (termination_condition::isSatisfied(m_Graph, m_iTarget, NextClosestNode))
-  {
-    //make a note of the node index that has satisfied the condition. This
-    //is so we can work backwards from the index to extract the path from
-    //the shortest path tree.
-    m_iTarget = NextClosestNode;
+  m_pBackward->Touch(m_iTarget, 0.0, -Potential(m_iTarget));
+  m_pBackward->PQ().insert(m_iTarget);
 
-    return target_found;
-  }
+  if (m_iSource == m_iTarget) m_dBestCost = 0.0;
+}
 
-  //now to test all the edges attached to this node
-  graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
+//------------------------------- Expand --------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+void Graph_SearchBidirectionalAStar_TS<graph_type, heuristic>::Expand(SearchWorkspace<Edge>&       ws,
+                                                                      const SearchWorkspace<Edge>& other,
+                                                                      double                       sign)
+{
+  int NextClosestNode = ws.PQ().Pop();
+
+  ws.SetSPT(NextClosestNode, ws.Frontier(NextClosestNode));
+
+  typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
   for (const Edge* pE=ConstEdgeItr.begin();
       !ConstEdgeItr.end();
        pE=ConstEdgeItr.next())
   {
-    //the total cost to the node this edge points to is the cost to the
-    //current node plus the cost of the edge connecting them.
-    double NewCost = m_CostToThisNode[NextClosestNode] + pE->Cost();
+    int    to    = pE->To();
+    double GCost = ws.GCost(NextClosestNode) + pE->Cost();
 
-    //if this edge has never been on the frontier make a note of the cost
-    //to get to the node it points to, then add the edge to the frontier
-    //and the destination node to the PQ.
-    if (m_SearchFrontier[pE->To()] == 0)
+    if (!ws.isTouched(to))
     {
-      m_CostToThisNode[pE->To()] = NewCost;
+      ws.Touch(to, GCost, GCost + sign * Potential(to));
 
-      m_pPQ->insert(pE->To());
+      ws.PQ().insert(to);
 
-      m_SearchFrontier[pE->To()] = pE;
+      ws.SetFrontier(to, pE);
     }
 
-    //else test to see if the cost to reach the destination node via the
-    //current node is cheaper than the cheapest cost found so far. If
-    //this path is cheaper, we assign the new cost to the destination
-    //node, update its entry in the PQ to reflect the change and add the
-    //edge to the frontier
-    else if ( (NewCost < m_CostToThisNode[pE->To()]) &&
-              (m_ShortestPathTree[pE->To()] == 0) )
+    else if ((GCost < ws.GCost(to)) && (ws.SPT(to) == NULL))
     {
-      m_CostToThisNode[pE->To()] = NewCost;
+      //the node's potential is already part of its F cost
+      ws.SetCosts(to, GCost, GCost + ws.FCost(to) - ws.GCost(to));
 
-      //because the cost is less than it was previously, the PQ must be
-      //re-sorted to account for this.
-      m_pPQ->ChangePriority(pE->To());
+      ws.PQ().ChangePriority(to);
 
-      m_SearchFrontier[pE->To()] = pE;
+      ws.SetFrontier(to, pE);
+    }
+
+    //a node reached by both searches completes a path
+    if (other.isTouched(to) && ws.GCost(to) + other.GCost(to) < m_dBestCost)
+    {
+      m_dBestCost    = ws.GCost(to) + other.GCost(to);
+      m_iMeetingNode = to;
     }
   }
-  
-  //there are still nodes to explore
+}
+
+//------------------------------ CycleOnce ------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+int Graph_SearchBidirectionalAStar_TS<graph_type, heuristic>::CycleOnce()
+{
+  if (m_iResult != search_incomplete) return m_iResult;
+
+  SearchWorkspace<Edge>& fw = *m_pForward;
+  SearchWorkspace<Edge>& bw = *m_pBackward;
+
+  //no path can be cheaper than the best found once the fronts of the queues
+  //are too costly. (and none can be found at all once either is empty)
+  if (fw.PQ().empty() || bw.PQ().empty() ||
+      fw.FCost(fw.PQ().Peek()) + bw.FCost(bw.PQ().Peek()) >= m_dBestCost)
+  {
+    m_iResult = m_dBestCost < MaxDouble ? target_found : target_not_found;
+
+    return m_iResult;
+  }
+
+  if (fw.PQ().size() <= bw.PQ().size())
+  {
+    Expand(fw, bw, 1.0);
+  }
+  else
+  {
+    Expand(bw, fw, -1.0);
+  }
+
   return search_incomplete;
 }
 
+//------------------------------- GetSPT --------------------------------------
 //-----------------------------------------------------------------------------
-template <class graph_type, class termination_condition>
+template <class graph_type, class heuristic>
+std::vector<const typename graph_type::EdgeType*>
+Graph_SearchBidirectionalAStar_TS<graph_type, heuristic>::GetSPT()const
+{
+  std::vector<const Edge*> spt(m_Graph.NumNodes());
+
+  for (unsigned int nd=0; nd<spt.size(); ++nd) spt[nd] = m_pForward->SPT(nd);
+
+  if (m_iResult != target_found) return spt;
+
+  std::list<int> path = GetPathToTarget();
+
+  std::list<int>::const_iterator from = path.begin(), to = path.begin();
+
+  for (++to; to != path.end(); ++from, ++to)
+  {
+    spt[*to] = &m_Graph.GetEdge(*from, *to);
+  }
+
+  return spt;
+}
+
+//--------------------------- GetPathToTarget ---------------------------------
+//
+//  the path runs back along the forward search's edges from the meeting
+//  node to the source and then along the backward search's to the target
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
 std::list<int> 
-Graph_SearchDijkstras_TS<graph_type, termination_condition>::GetPathToTarget()const
+Graph_SearchBidirectionalAStar_TS<graph_type, heuristic>::GetPathToTarget()const
 {
   std::list<int> path;
 
-  //just return an empty path if no target or no path found
-  if (m_iTarget < 0)  return path;    
+  if (m_iResult != target_found) return path;
 
-  int nd = m_iTarget;
+  int nd = m_iMeetingNode;
 
   path.push_back(nd);
-    
-  while ((nd != m_iSource) && (m_ShortestPathTree[nd] != 0))
+
+  while (nd != m_iSource)
   {
-    nd = m_ShortestPathTree[nd]->From();
+    nd = m_pForward->Frontier(nd)->From();
 
     path.push_front(nd);
   }
 
-  return path;
-} 
+  nd = m_iMeetingNode;
+
+  while (nd != m_iTarget)
+  {
+    nd = m_pBackward->Frontier(nd)->From();
+
+    path.push_back(nd);
+  }
 
+  return path;
+}
 
 //-------------------------- GetPathAsPathEdges -------------------------------
-//
-//  returns the path as a list of PathEdges
 //-----------------------------------------------------------------------------
-template <class graph_type, class termination_condition>
+template <class graph_type, class heuristic>
 std::list<PathEdge> 
-Graph_SearchDijkstras_TS<graph_type, termination_condition>::GetPathAsPathEdges()const
+Graph_SearchBidirectionalAStar_TS<graph_type, heuristic>::GetPathAsPathEdges()const
 {
   std::list<PathEdge> path;
 
-  //just return an empty path if no target or no path found
-  if (m_iTarget < 0)  return path;    
+  std::list<int> nodes = GetPathToTarget();
 
-  int nd = m_iTarget;
-    
-  while ((nd != m_iSource) && (m_ShortestPathTree[nd] != 0))
+  if (nodes.empty()) return path;
+
+  std::list<int>::const_iterator from = nodes.begin(), to = nodes.begin();
+
+  for (++to; to != nodes.end(); ++from, ++to)
   {
-    path.push_front(PathEdge(m_Graph.GetNode(m_ShortestPathTree[nd]->From()).Pos(),
-                             m_Graph.GetNode(m_ShortestPathTree[nd]->To()).Pos(),
-                             m_ShortestPathTree[nd]->Flags(),
-                             m_ShortestPathTree[nd]->IDofIntersectingEntity()));
-    
-    nd = m_ShortestPathTree[nd]->From();
+    const Edge& edge = m_Graph.GetEdge(*from, *to);
+
+    path.push_back(PathEdge(m_Graph.GetNode(*from).Pos(),
+                            m_Graph.GetNode(*to).Pos(),
+                            edge.Flags(),
+                            edge.IDofIntersectingEntity()));
+  }
+
+  return path;
+}
+
+//------------------------- Graph_SearchThetaStar_TS --------------------------
+//
+//  an any-angle version of A*. When a node is expanded each neighbour may be
+//  reached straight from the node's own parent rather than by way of the
+//  node, if the walk_test policy says the way between them is clear. The
+//  path is then made of straight lines between a few of the graph's nodes
+//  and needs no smoothing afterwards.
+//
+//  The way is only tested once the neighbour is itself expanded (this is
+//  'Lazy Theta*'), so there is one test per node expanded rather than one
+//  per edge. If the way turns out to be blocked the node is given the
+//  cheapest of its expanded neighbours as its parent instead.
+//
+//  The walk_test policy must have a method
+//
+//    bool isWalkable(Vector2D from, Vector2D to)const;
+//
+//  Only normal edges are cut across, and the cost of a straight line is
+//  its length, so the costs of normal edges must be their lengths. The
+//  heuristic must never overestimate the straight line distance.
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class walk_test>
+class Graph_SearchThetaStar_TS : public Graph_SearchTimeSliced<typename graph_type::EdgeType>
+{
+private:
+
+  typedef typename graph_type::EdgeType Edge;
+
+private:
+
+  const graph_type&              m_Graph;
+
+  //the per-node data of the search (see SearchWorkspace.h). A node's
+  //frontier edge is the edge it was reached along from the node being
+  //expanded, which is not its parent if the way was cut short
+  SearchWorkspace<Edge>*         m_pWorkspace;
+
+  //the pool the workspace is returned to (NULL if the search owns it)
+  SearchWorkspacePool<Edge>*     m_pPool;
+
+  //the node each node is reached from in a straight line
+  std::vector<int>               m_Parents;
+
+  int                            m_iSource;
+  int                            m_iTarget;
+
+  heuristic                      m_Heuristic;
+  walk_test                      m_WalkTest;
+
+  //returns true if the node was reached straight along its frontier edge
+  bool isReachedAlongEdge(int node)const
+  {
+    return m_pWorkspace->Frontier(node) &&
+           m_pWorkspace->Frontier(node)->From() == m_Parents[node];
+  }
+
+  //gives the node the parent and cost if they are cheaper than its own
+  void Relax(int node, int parent, double GCost, const Edge* pE);
+
+  //called as a node is expanded. If the node was reached straight from
+  //its parent and the way is blocked it is reached from the cheapest of its
+  //expanded neighbours instead
+  void CheckParent(int node);
+
+public:
+
+  Graph_SearchThetaStar_TS(const graph_type&          G,
+                           int                        source,
+                           int                        target,
+                           const walk_test&           WalkTest,
+                           SearchWorkspacePool<Edge>* pPool = NULL,
+                           const heuristic&           h = heuristic());
+
+  ~Graph_SearchThetaStar_TS()
+  {
+    if (m_pPool) m_pPool->Release(m_pWorkspace); else delete m_pWorkspace;
+  }
+
+  int                      CycleOnce();
+
+  //returns the edges the nodes were reached along
+  std::vector<const Edge*> GetSPT()const;
+
+  //returns the nodes at the corners of the path
+  std::list<int>           GetPathToTarget()const;
+
+  std::list<PathEdge>      GetPathAsPathEdges()const;
+
+  double                   GetCostToTarget()const
+  {
+    return m_pWorkspace->isTouched(m_iTarget) ? m_pWorkspace->GCost(m_iTarget) : 0.0;
+  }
+};
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class walk_test>
+Graph_SearchThetaStar_TS<graph_type, heuristic, walk_test>::Graph_SearchThetaStar_TS(
+                                         const graph_type&          G,
+                                         int                        source,
+                                         int                        target,
+                                         const walk_test&           WalkTest,
+                                         SearchWorkspacePool<Edge>* pPool,
+                                         const heuristic&           h):Graph_SearchTimeSliced<Edge>(Graph_SearchTimeSliced<Edge>::AStar),
+                                                                       m_Graph(G),
+                                                                       m_pPool(pPool),
+                                                                       m_Parents(G.NumNodes(), invalid_node_index),
+                                                                       m_iSource(source),
+                                                                       m_iTarget(target),
+                                                                       m_Heuristic(h),
+                                                                       m_WalkTest(WalkTest)
+{
+  assert (!G.isDigraph() && "<Graph_SearchThetaStar_TS::ctor>: the graph must be undirected");
+
+  if (m_pPool)
+  {
+    m_pWorkspace = m_pPool->Acquire(m_Graph.NumNodes());
+  }
+  else
+  {
+    m_pWorkspace = new SearchWorkspace<Edge>();
+    m_pWorkspace->Reset(m_Graph.NumNodes());
+  }
+
+  m_Parents[m_iSource] = m_iSource;
+
+  m_pWorkspace->Touch(m_iSource, 0.0, m_Heuristic.Calculate(m_Graph, m_iTarget, m_iSource));
+  m_pWorkspace->PQ().insert(m_iSource);
+}
+
+//-------------------------------- Relax --------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class walk_test>
+void Graph_SearchThetaStar_TS<graph_type, heuristic, walk_test>::Relax(int         node,
+                                                                       int         parent,
+                                                                       double      GCost,
+                                                                       const Edge* pE)
+{
+  SearchWorkspace<Edge>& ws = *m_pWorkspace;
+
+  if (!ws.isTouched(node))
+  {
+    ws.Touch(node, GCost, GCost + m_Heuristic.Calculate(m_Graph, m_iTarget, node));
+
+    ws.PQ().insert(node);
+  }
+
+  else if ((GCost < ws.GCost(node)) && (ws.SPT(node) == NULL))
+  {
+    ws.SetCosts(node, GCost, GCost + ws.FCost(node) - ws.GCost(node));
+
+    ws.PQ().ChangePriority(node);
+  }
+
+  else
+  {
+    return;
+  }
+
+  ws.SetFrontier(node, pE);
+
+  m_Parents[node] = parent;
+}
+
+//----------------------------- CheckParent -----------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class walk_test>
+void Graph_SearchThetaStar_TS<graph_type, heuristic, walk_test>::CheckParent(int node)
+{
+  SearchWorkspace<Edge>& ws = *m_pWorkspace;
+
+  if (node == m_iSource || isReachedAlongEdge(node) ||
+      m_WalkTest.isWalkable(m_Graph.GetNode(m_Parents[node]).Pos(),
+                            m_Graph.GetNode(node).Pos()))
+  {
+    return;
+  }
+
+  //the neighbour the node was reached by way of is always expanded, so one
+  //is certain to be found
+  double      BestCost = MaxDouble;
+  const Edge* pBest    = NULL;
+
+  typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, node);
+  for (const Edge* pE=ConstEdgeItr.begin();
+      !ConstEdgeItr.end();
+       pE=ConstEdgeItr.next())
+  {
+    int from = pE->To();
+
+    if (ws.SPT(from) == NULL && from != m_iSource) continue;
+
+    const Edge& ToNode = m_Graph.GetEdge(from, node);
+
+    if (ws.GCost(from) + ToNode.Cost() < BestCost)
+    {
+      BestCost = ws.GCost(from) + ToNode.Cost();
+      pBest    = &ToNode;
+    }
+  }
+
+  ws.SetCosts(node, BestCost, BestCost + ws.FCost(node) - ws.GCost(node));
+  ws.SetFrontier(node, pBest);
+
+  m_Parents[node] = pBest->From();
+}
+
+//------------------------------ CycleOnce ------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class walk_test>
+int Graph_SearchThetaStar_TS<graph_type, heuristic, walk_test>::CycleOnce()
+{
+  SearchWorkspace<Edge>& ws = *m_pWorkspace;
+
+  //if the PQ is empty the target has not been found
+  if (ws.PQ().empty())
+  {
+    return target_not_found;
+  }
+
+  int NextClosestNode = ws.PQ().Pop();
+
+  CheckParent(NextClosestNode);
+
+  ws.SetSPT(NextClosestNode, ws.Frontier(NextClosestNode));
+
+  if (NextClosestNode == m_iTarget)
+  {
+    return target_found;
+  }
+
+  int parent = m_Parents[NextClosestNode];
+
+  //the way to the node may only be cut across if it is made of normal
+  //edges, and it is already straight if the node is the source
+  bool bCanCutAcross = parent != NextClosestNode &&
+                       (!isReachedAlongEdge(NextClosestNode) ||
+                        ws.Frontier(NextClosestNode)->Flags() == Edge::normal);
+
+  typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
+  for (const Edge* pE=ConstEdgeItr.begin();
+      !ConstEdgeItr.end();
+       pE=ConstEdgeItr.next())
+  {
+    int to = pE->To();
+
+    if (ws.SPT(to) != NULL) continue;
+
+    //assume the neighbour can be reached straight from the node's parent.
+    //This is checked when the neighbour is expanded
+    if (bCanCutAcross && pE->Flags() == Edge::normal)
+    {
+      Relax(to,
+            parent,
+            ws.GCost(parent) + Vec2DDistance(m_Graph.GetNode(parent).Pos(),
+                                             m_Graph.GetNode(to).Pos()),
+            pE);
+    }
+    else
+    {
+      Relax(to, NextClosestNode, ws.GCost(NextClosestNode) + pE->Cost(), pE);
+    }
+  }
+
+  return search_incomplete;
+}
+
+//------------------------------- GetSPT --------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class walk_test>
+std::vector<const typename graph_type::EdgeType*>
+Graph_SearchThetaStar_TS<graph_type, heuristic, walk_test>::GetSPT()const
+{
+  std::vector<const Edge*> spt(m_Graph.NumNodes());
+
+  for (unsigned int nd=0; nd<spt.size(); ++nd) spt[nd] = m_pWorkspace->SPT(nd);
+
+  return spt;
+}
+
+//--------------------------- GetPathToTarget ---------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class walk_test>
+std::list<int> 
+Graph_SearchThetaStar_TS<graph_type, heuristic, walk_test>::GetPathToTarget()const
+{
+  std::list<int> path;
+
+  //the target has only been found once it is on the SPT
+  if (m_pWorkspace->SPT(m_iTarget) == NULL && m_iTarget != m_iSource)
+  {
+    return path;
+  }
+
+  int nd = m_iTarget;
+
+  path.push_front(nd);
+
+  while (nd != m_iSource)
+  {
+    nd = m_Parents[nd];
+
+    path.push_front(nd);
+  }
+
+  return path;
+}
+
+//-------------------------- GetPathAsPathEdges -------------------------------
+//
+//  the lines cut across the graph are all normal edges
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class walk_test>
+std::list<PathEdge> 
+Graph_SearchThetaStar_TS<graph_type, heuristic, walk_test>::GetPathAsPathEdges()const
+{
+  std::list<PathEdge> path;
+
+  std::list<int> nodes = GetPathToTarget();
+
+  if (nodes.empty()) return path;
+
+  std::list<int>::const_iterator from = nodes.begin(), to = nodes.begin();
+
+  for (++to; to != nodes.end(); ++from, ++to)
+  {
+    if (isReachedAlongEdge(*to))
+    {
+      const Edge* pE = m_pWorkspace->Frontier(*to);
+
+      path.push_back(PathEdge(m_Graph.GetNode(*from).Pos(),
+                              m_Graph.GetNode(*to).Pos(),
+                              pE->Flags(),
+                              pE->IDofIntersectingEntity()));
+    }
+    else
+    {
+      path.push_back(PathEdge(m_Graph.GetNode(*from).Pos(),
+                              m_Graph.GetNode(*to).Pos(),
+                              Edge::normal));
+    }
+  }
+
+  return path;
+}
+
+//-------------------------- Graph_SearchDijkstras_TS -------------------------
+//
+//  Dijkstra's algorithm class modified to spread a search over multiple
+//  update-steps
+//-----------------------------------------------------------------------------
+template <class graph_type, class termination_condition>
+class Graph_SearchDijkstras_TS : public Graph_SearchTimeSliced<typename graph_type::EdgeType>
+{
+private:
+
+  //create typedefs for the node and edge types used by the graph
+  typedef typename graph_type::EdgeType Edge;
+  typedef typename graph_type::NodeType Node;
+
+private:
+
+  const graph_type&              m_Graph;
+
+  //holds the accumulative cost to each node, the SPT and the search
+  //frontier. There is no heuristic so both the G and F costs of a node
+  //are set to its cost
+  SearchWorkspace<Edge>*         m_pWorkspace;
+
+  //the pool the workspace is returned to (NULL if the search owns it)
+  SearchWorkspacePool<Edge>*     m_pPool;
+
+  int                            m_iSource;
+  int                            m_iTarget;
+
+ 
+
+public:
+
+  Graph_SearchDijkstras_TS(const graph_type&          G,
+                           int                        source,
+                           int                        target,
+                           SearchWorkspacePool<Edge>* pPool = NULL):Graph_SearchTimeSliced<Edge>(Graph_SearchTimeSliced<Edge>::Dijkstra),
+  
+                                              m_Graph(G),
+                                              m_pPool(pPool),
+                                              m_iSource(source),
+                                              m_iTarget(target)
+  { 
+    if (m_pPool)
+    {
+      m_pWorkspace = m_pPool->Acquire(m_Graph.NumNodes());
+    }
+    else
+    {
+      m_pWorkspace = new SearchWorkspace<Edge>();
+      m_pWorkspace->Reset(m_Graph.NumNodes());
+    }
+
+    //put the source node on the queue
+    m_pWorkspace->Touch(m_iSource, 0.0, 0.0);
+    m_pWorkspace->PQ().insert(m_iSource);
+  }
+
+  ~Graph_SearchDijkstras_TS()
+  {
+    if (m_pPool) m_pPool->Release(m_pWorkspace);
+    else         delete m_pWorkspace;
+  }
+
+
+  //When called, this method pops the next node off the PQ and examines all
+  //its edges. The method returns an enumerated value (target_found,
+  //target_not_found, search_incomplete) indicating the status of the search
+  int              CycleOnce();
+
+  //returns the vector of edges that the algorithm has examined
+  std::vector<const Edge*> GetSPT()const;
+
+  //returns a vector of node indexes that comprise the shortest path
+  //from the source to the target
+  std::list<int> GetPathToTarget()const;
+
+  //returns the path as a list of PathEdges
+  std::list<PathEdge>    GetPathAsPathEdges()const;
+
+  //returns the total cost to the target
+  double            GetCostToTarget()const
+  {
+    return m_pWorkspace->isTouched(m_iTarget) ? m_pWorkspace->GCost(m_iTarget) : 0.0;
+  }
+};
+
+//-----------------------------------------------------------------------------
+template <class graph_type, class termination_condition>
+int Graph_SearchDijkstras_TS<graph_type, termination_condition>::CycleOnce()
+{
+  SearchWorkspace<Edge>& ws = *m_pWorkspace;
+
+  //if the PQ is empty the target has not been found
+  if (ws.PQ().empty())
+  {
+    return target_not_found;
+  }
+
+  //get lowest cost node from the queue
+  int NextClosestNode = ws.PQ().Pop();
+
+  //move this node from the frontier to the spanning tree
+  ws.SetSPT(NextClosestNode, ws.Frontier(NextClosestNode));
+
+  //if the target has been found exit
+  if (termination_condition::isSatisfied(m_Graph, m_iTarget, NextClosestNode))
+  {
+    //make a note of the node index that has satisfied the condition. This
+    //is so we can work backwards from the index to extract the path from
+    //the shortest path tree.
+    m_iTarget = NextClosestNode;
+
+    return target_found;
+  }
+
+  //now to test all the edges attached to this node
+  typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
+  for (const Edge* pE=ConstEdgeItr.begin();
+      !ConstEdgeItr.end();
+       pE=ConstEdgeItr.next())
+  {
+    //the total cost to the node this edge points to is the cost to the
+    //current node plus the cost of the edge connecting them.
+    double NewCost = ws.GCost(NextClosestNode) + pE->Cost();
+
+    //if this edge has never been on the frontier make a note of the cost
+    //to get to the node it points to, then add the edge to the frontier
+    //and the destination node to the PQ.
+    if (ws.Frontier(pE->To()) == 0)
+    {
+      ws.Touch(pE->To(), NewCost, NewCost);
+
+      ws.PQ().insert(pE->To());
+
+      ws.SetFrontier(pE->To(), pE);
+    }
+
+    //else test to see if the cost to reach the destination node via the
+    //current node is cheaper than the cheapest cost found so far. If
+    //this path is cheaper, we assign the new cost to the destination
+    //node, update its entry in the PQ to reflect the change and add the
+    //edge to the frontier
+    else if ( (NewCost < ws.GCost(pE->To())) &&
+              (ws.SPT(pE->To()) == 0) )
+    {
+      ws.SetCosts(pE->To(), NewCost, NewCost);
+
+      //because the cost is less than it was previously, the PQ must be
+      //re-sorted to account for this.
+      ws.PQ().ChangePriority(pE->To());
+
+      ws.SetFrontier(pE->To(), pE);
+    }
+  }
+  
+  //there are still nodes to explore
+  return search_incomplete;
+}
+
+//------------------------------- GetSPT --------------------------------------
+//
+//  the workspace only holds valid entries for the nodes this search has
+//  reached so the SPT is copied out node by node
+//-----------------------------------------------------------------------------
+template <class graph_type, class termination_condition>
+std::vector<const typename graph_type::EdgeType*>
+Graph_SearchDijkstras_TS<graph_type, termination_condition>::GetSPT()const
+{
+  std::vector<const Edge*> spt(m_pWorkspace->NumNodes());
+
+  for (unsigned int nd=0; nd<spt.size(); ++nd) spt[nd] = m_pWorkspace->SPT(nd);
+
+  return spt;
+}
+
+//-----------------------------------------------------------------------------
+template <class graph_type, class termination_condition>
+std::list<int> 
+Graph_SearchDijkstras_TS<graph_type, termination_condition>::GetPathToTarget()const
+{
+  std::list<int> path;
+
+  //just return an empty path if no target or no path found
+  if (m_iTarget < 0)  return path;    
+
+  int nd = m_iTarget;
+
+  path.push_back(nd);
+    
+  while ((nd != m_iSource) && (m_pWorkspace->SPT(nd) != 0))
+  {
+    nd = m_pWorkspace->SPT(nd)->From();
+
+    path.push_front(nd);
+  }
+
+  return path;
+} 
+
+
+//-------------------------- GetPathAsPathEdges -------------------------------
+//
+//  returns the path as a list of PathEdges
+//-----------------------------------------------------------------------------
+template <class graph_type, class termination_condition>
+std::list<PathEdge> 
+Graph_SearchDijkstras_TS<graph_type, termination_condition>::GetPathAsPathEdges()const
+{
+  std::list<PathEdge> path;
+
+  //just return an empty path if no target or no path found
+  if (m_iTarget < 0)  return path;    
+
+  int nd = m_iTarget;
+    
+  while ((nd != m_iSource) && (m_pWorkspace->SPT(nd) != 0))
+  {
+    const Edge* pE = m_pWorkspace->SPT(nd);
+
+    path.push_front(PathEdge(m_Graph.GetNode(pE->From()).Pos(),
+                             m_Graph.GetNode(pE->To()).Pos(),
+                             pE->Flags(),
+                             pE->IDofIntersectingEntity()));
+    
+    nd = pE->From();
+  }
+
+  return path;
+}
+
+
+//--------------------------- Graph_SearchHPA_TS ------------------------------
+//
+//  a hierarchical A* search. The source and target are first joined to the
+//  entrances of their clusters, then A* finds a path through the abstract
+//  graph, one entrance per cycle. Once the target is reached the coarse
+//  path is refined into graph edges one leg at a time, where a leg is the
+//  path across a cluster and the edge out of it. The first leg is refined
+//  when the search completes and each further leg by RefineNextLeg.
+//
+//  The source and target must be in different clusters
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+class Graph_SearchHPA_TS : public Graph_SearchTimeSliced<typename graph_type::EdgeType>
+{
+private:
+
+  typedef typename graph_type::EdgeType   Edge;
+  typedef HierarchicalGraph<graph_type>   Hierarchy;
+
+private:
+
+  const graph_type&              m_Graph;
+  const Hierarchy&               m_Hierarchy;
+
+  int                            m_iSource;
+  int                            m_iTarget;
+
+  heuristic                      m_Heuristic;
+
+  //the target is given the abstract index one past the last entrance
+  int                            m_iAbstractTarget;
+
+  //set once the source and target have been joined to the abstract graph
+  bool                           m_bConnected;
+
+  //indexed by abstract index. The A* costs, the entrance each was reached
+  //from (-1 for the source) and whether the cheapest path to it is known
+  std::vector<double>            m_GCosts;
+  std::vector<double>            m_FCosts;
+  std::vector<int>               m_Parents;
+  std::vector<bool>              m_Expanded;
+
+  //the cost from each entrance of the target's cluster to the target
+  std::vector<double>            m_CostsToTarget;
+
+  IndexedPriorityQLow<double>*   m_pPQ;
+
+  //the coarse path as graph node indices, from source to target
+  std::vector<int>               m_Waypoints;
+
+  //the waypoint the next leg starts from
+  int                            m_iNextWaypoint;
+
+  //the edges of the legs refined so far
+  std::vector<const Edge*>       m_RefinedPath;
+
+  void Connect();
+
+  void Relax(int idx, double GCost, int parent);
+
+  PathEdge MakePathEdge(const Edge* pE)const
+  {
+    return PathEdge(m_Graph.GetNode(pE->From()).Pos(),
+                    m_Graph.GetNode(pE->To()).Pos(),
+                    pE->Flags(),
+                    pE->IDofIntersectingEntity());
+  }
+
+public:
+
+  Graph_SearchHPA_TS(const Hierarchy& H,
+                     int              source,
+                     int              target,
+                     const heuristic& h = heuristic()):Graph_SearchTimeSliced<Edge>(Graph_SearchTimeSliced<Edge>::AStar),
+                                              m_Graph(H.GetGraph()),
+                                              m_Hierarchy(H),
+                                              m_iSource(source),
+                                              m_iTarget(target),
+                                              m_Heuristic(h),
+                                              m_iAbstractTarget(H.NumEntrances()),
+                                              m_bConnected(false),
+                                              m_GCosts(H.NumEntrances()+1, MaxDouble),
+                                              m_FCosts(H.NumEntrances()+1, 0.0),
+                                              m_Parents(H.NumEntrances()+1, -1),
+                                              m_Expanded(H.NumEntrances()+1, false),
+                                              m_iNextWaypoint(0)
+  {
+    assert (H.Cluster(source) != H.Cluster(target) &&
+            "<Graph_SearchHPA_TS::ctor>: source and target share a cluster");
+
+    m_pPQ = new IndexedPriorityQLow<double>(m_FCosts, H.NumEntrances()+1);
+  }
+
+  ~Graph_SearchHPA_TS(){delete m_pPQ;}
+
+  //the first call joins the source and target to the abstract graph. Each
+  //call after that expands one entrance
+  int                      CycleOnce();
+
+  //returns the edges of the legs refined so far, indexed by the node they
+  //lead to
+  std::vector<const Edge*> GetSPT()const;
+
+  //returns the nodes of the legs refined so far followed by the waypoints
+  //of the legs still to be refined
+  std::list<int>           GetPathToTarget()const;
+
+  //returns the legs refined so far
+  std::list<PathEdge>      GetPathAsPathEdges()const;
+
+  //returns the cost of the coarse path
+  double                   GetCostToTarget()const
+  {
+    return m_Expanded[m_iAbstractTarget] ? m_GCosts[m_iAbstractTarget] : 0.0;
+  }
+
+  //returns true if the whole path has been refined
+  bool                     isFullyRefined()const
+  {
+    return m_iNextWaypoint+1 >= (int)m_Waypoints.size();
+  }
+
+  //refines the next leg of the path and returns its edges
+  std::list<PathEdge>      RefineNextLeg();
+};
+
+//------------------------------- Connect -------------------------------------
+//
+//  the source's cluster is searched to find the entrances it can leave by
+//  and the target's to find those it can be entered by. (the graph is
+//  undirected so the costs from the target are the costs to it)
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+void Graph_SearchHPA_TS<graph_type, heuristic>::Connect()
+{
+  std::vector<double>      Costs;
+  std::vector<const Edge*> SPT;
+
+  int cluster = m_Hierarchy.Cluster(m_iSource);
+
+  m_Hierarchy.SearchCluster(m_iSource, -1, Costs, SPT);
+
+  for (int e=m_Hierarchy.FirstEntrance(cluster); e<m_Hierarchy.FirstEntrance(cluster+1); ++e)
+  {
+    double cost = m_Hierarchy.GetClusterCost(Costs, m_Hierarchy.EntranceNode(e));
+
+    if (cost != MaxDouble) Relax(e, cost, -1);
+  }
+
+  cluster = m_Hierarchy.Cluster(m_iTarget);
+
+  m_Hierarchy.SearchCluster(m_iTarget, -1, Costs, SPT);
+
+  m_CostsToTarget.resize(m_Hierarchy.NumEntrances(cluster));
+
+  for (int i=0; i<m_Hierarchy.NumEntrances(cluster); ++i)
+  {
+    int e = m_Hierarchy.FirstEntrance(cluster) + i;
+
+    m_CostsToTarget[i] = m_Hierarchy.GetClusterCost(Costs, m_Hierarchy.EntranceNode(e));
+  }
+}
+
+//-------------------------------- Relax --------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+void Graph_SearchHPA_TS<graph_type, heuristic>::Relax(int idx, double GCost, int parent)
+{
+  if (m_Expanded[idx] || GCost >= m_GCosts[idx]) return;
+
+  bool bQueued = m_GCosts[idx] != MaxDouble;
+
+  double HCost = 0.0;
+
+  if (idx != m_iAbstractTarget)
+  {
+    HCost = m_Heuristic.Calculate(m_Graph, m_iTarget, m_Hierarchy.EntranceNode(idx));
+  }
+
+  m_GCosts[idx]  = GCost;
+  m_FCosts[idx]  = GCost + HCost;
+  m_Parents[idx] = parent;
+
+  if (bQueued) m_pPQ->ChangePriority(idx);
+  else         m_pPQ->insert(idx);
+}
+
+//------------------------------ CycleOnce ------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+int Graph_SearchHPA_TS<graph_type, heuristic>::CycleOnce()
+{
+  if (!m_bConnected)
+  {
+    Connect();
+
+    m_bConnected = true;
+
+    return m_pPQ->empty() ? target_not_found : search_incomplete;
+  }
+
+  //if the PQ is empty the target has not been found
+  if (m_pPQ->empty())
+  {
+    return target_not_found;
+  }
+
+  int idx = m_pPQ->Pop();
+
+  m_Expanded[idx] = true;
+
+  //if the target has been found make the coarse path and refine its first
+  //leg. The source or target may itself be an entrance, in which case it
+  //is only listed once
+  if (idx == m_iAbstractTarget)
+  {
+    m_Waypoints.push_back(m_iTarget);
+
+    for (int e=m_Parents[idx]; e != -1; e=m_Parents[e])
+    {
+      if (m_Hierarchy.EntranceNode(e) != m_Waypoints.back())
+      {
+        m_Waypoints.push_back(m_Hierarchy.EntranceNode(e));
+      }
+    }
+
+    if (m_iSource != m_Waypoints.back()) m_Waypoints.push_back(m_iSource);
+
+    std::reverse(m_Waypoints.begin(), m_Waypoints.end());
+
+    RefineNextLeg();
+
+    return target_found;
+  }
+
+  const typename Hierarchy::AbstractEdge* pE;
+  for (pE = m_Hierarchy.AbstractEdgesBegin(idx); pE != m_Hierarchy.AbstractEdgesEnd(idx); ++pE)
+  {
+    Relax(pE->iTo, m_GCosts[idx] + pE->dCost, idx);
+  }
+
+  //entrances of the target's cluster lead to the target
+  int cluster = m_Hierarchy.Cluster(m_iTarget);
+
+  if (m_Hierarchy.Cluster(m_Hierarchy.EntranceNode(idx)) == cluster)
+  {
+    double cost = m_CostsToTarget[idx - m_Hierarchy.FirstEntrance(cluster)];
+
+    if (cost != MaxDouble) Relax(m_iAbstractTarget, m_GCosts[idx] + cost, idx);
+  }
+
+  //there are still entrances to explore
+  return search_incomplete;
+}
+
+//---------------------------- RefineNextLeg ----------------------------------
+//
+//  consecutive waypoints are either joined by an edge between two clusters
+//  or lie in the same cluster, in which case the cluster is searched for the
+//  path between them. (the leg returned is empty only if there is nothing
+//  left to refine)
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+std::list<PathEdge> Graph_SearchHPA_TS<graph_type, heuristic>::RefineNextLeg()
+{
+  std::list<PathEdge> leg;
+
+  std::vector<const Edge*> edges;
+
+  while (!isFullyRefined())
+  {
+    int from = m_Waypoints[m_iNextWaypoint];
+    int to   = m_Waypoints[++m_iNextWaypoint];
+
+    if (from == to) continue;
+
+    if (m_Hierarchy.Cluster(from) != m_Hierarchy.Cluster(to))
+    {
+      const Edge* pE = &m_Graph.GetEdge(from, to);
+
+      m_RefinedPath.push_back(pE);
+      leg.push_back(MakePathEdge(pE));
+
+      break;
+    }
+
+    bool bFound = m_Hierarchy.FindPathInCluster(from, to, edges);
+
+    assert (bFound && "<Graph_SearchHPA_TS::RefineNextLeg>: waypoints not connected");
+
+    for (unsigned int i=0; i<edges.size(); ++i)
+    {
+      m_RefinedPath.push_back(edges[i]);
+      leg.push_back(MakePathEdge(edges[i]));
+    }
+  }
+
+  return leg;
+}
+
+//------------------------------- GetSPT --------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+std::vector<const typename graph_type::EdgeType*>
+Graph_SearchHPA_TS<graph_type, heuristic>::GetSPT()const
+{
+  std::vector<const Edge*> spt(m_Graph.NumNodes(), NULL);
+
+  for (unsigned int i=0; i<m_RefinedPath.size(); ++i)
+  {
+    spt[m_RefinedPath[i]->To()] = m_RefinedPath[i];
+  }
+
+  return spt;
+}
+
+//--------------------------- GetPathToTarget ---------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+std::list<int>
+Graph_SearchHPA_TS<graph_type, heuristic>::GetPathToTarget()const
+{
+  std::list<int> path;
+
+  //just return an empty path if no path found
+  if (m_Waypoints.empty()) return path;
+
+  path.push_back(m_iSource);
+
+  for (unsigned int i=0; i<m_RefinedPath.size(); ++i)
+  {
+    path.push_back(m_RefinedPath[i]->To());
+  }
+
+  for (unsigned int w=m_iNextWaypoint+1; w<m_Waypoints.size(); ++w)
+  {
+    if (m_Waypoints[w] != path.back()) path.push_back(m_Waypoints[w]);
+  }
+
+  return path;
+}
+
+//-------------------------- GetPathAsPathEdges -------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic>
+std::list<PathEdge>
+Graph_SearchHPA_TS<graph_type, heuristic>::GetPathAsPathEdges()const
+{
+  std::list<PathEdge> path;
+
+  for (unsigned int i=0; i<m_RefinedPath.size(); ++i)
+  {
+    path.push_back(MakePathEdge(m_RefinedPath[i]));
+  }
+
+  return path;
+}
+
+
+//-------------------------- Graph_SearchCached_TS ----------------------------
+//
+//  presents a path found by an earlier search as a search that completes on
+//  its first cycle
+//-----------------------------------------------------------------------------
+template <class graph_type>
+class Graph_SearchCached_TS : public Graph_SearchTimeSliced<typename graph_type::EdgeType>
+{
+private:
+
+  typedef typename graph_type::EdgeType   Edge;
+
+private:
+
+  const graph_type&         m_Graph;
+
+  int                       m_iSource;
+
+  bool                      m_bFound;
+
+  //the edges of the path from the source to the target
+  std::vector<const Edge*>  m_Path;
+
+public:
+
+  Graph_SearchCached_TS(const graph_type&               G,
+                        typename Graph_SearchTimeSliced<Edge>::SearchType type,
+                        int                             source,
+                        bool                            bFound,
+                        const std::vector<const Edge*>& path):Graph_SearchTimeSliced<Edge>(type),
+                                                              m_Graph(G),
+                                                              m_iSource(source),
+                                                              m_bFound(bFound),
+                                                              m_Path(path)
+  {}
+
+  int                      CycleOnce(){return m_bFound ? target_found : target_not_found;}
+
+  std::vector<const Edge*> GetSPT()const
+  {
+    std::vector<const Edge*> spt(m_Graph.NumNodes(), NULL);
+
+    for (unsigned int i=0; i<m_Path.size(); ++i) spt[m_Path[i]->To()] = m_Path[i];
+
+    return spt;
+  }
+
+  std::list<int>           GetPathToTarget()const
+  {
+    std::list<int> path;
+
+    if (!m_bFound) return path;
+
+    path.push_back(m_iSource);
+
+    for (unsigned int i=0; i<m_Path.size(); ++i) path.push_back(m_Path[i]->To());
+
+    return path;
+  }
+
+  std::list<PathEdge>      GetPathAsPathEdges()const
+  {
+    std::list<PathEdge> path;
+
+    for (unsigned int i=0; i<m_Path.size(); ++i)
+    {
+      const Edge* pE = m_Path[i];
+
+      path.push_back(PathEdge(m_Graph.GetNode(pE->From()).Pos(),
+                              m_Graph.GetNode(pE->To()).Pos(),
+                              pE->Flags(),
+                              pE->IDofIntersectingEntity()));
+    }
+
+    return path;
+  }
+
+  double                   GetCostToTarget()const
+  {
+    double cost = 0.0;
+
+    for (unsigned int i=0; i<m_Path.size(); ++i) cost += m_Path[i]->Cost();
+
+    return cost;
+  }
+};
+
+
+//------------------------------ EdgeCost_Graph -------------------------------
+//
+//  the default edge cost policy of Graph_SearchDStarLite_TS. The cost is
+//  the one held by the edge
+//-----------------------------------------------------------------------------
+class EdgeCost_Graph
+{
+public:
+
+  template <class edge_type>
+  double Cost(const edge_type& edge)const{return edge.Cost();}
+};
+
+//------------------------- Graph_SearchDStarLite_TS --------------------------
+//
+//  D* Lite. This searches backwards from the target, recording for each node
+//  the cost of the cheapest path from it to the target (G) and that cost as
+//  given by its neighbours' costs (RHS). A node whose two costs differ is
+//  queued to be updated.
+//
+//  Once the search has finished it may be kept. If the source moves or the
+//  cost of an edge changes only the nodes whose costs are affected are
+//  updated by the following cycles, rather than the search starting afresh.
+//
+//  The edge costs are read through the edge_cost policy so they may depend
+//  on the state of the game. (the heuristic must remain a lower bound of the
+//  costs it gives) The graph must be undirected.
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost = EdgeCost_Graph>
+class Graph_SearchDStarLite_TS : public Graph_SearchTimeSliced<typename graph_type::EdgeType>
+{
+private:
+
+  typedef typename graph_type::EdgeType   Edge;
+
+  //the queue is ordered on the first value of the keys, then the second
+  typedef std::pair<double, double>       Key;
+  typedef std::set<std::pair<Key, int> >  Queue;
+
+private:
+
+  const graph_type&              m_Graph;
+
+  heuristic                      m_Heuristic;
+  edge_cost                      m_EdgeCost;
+
+  int                            m_iSource;
+  int                            m_iTarget;
+
+  //the keys of the queued nodes were calculated for an earlier source. The
+  //modifier is the sum of the heuristic costs between the sources so far
+  //and keeps the keys calculated since comparable with those
+  int                            m_iLastSource;
+  double                         m_dKeyModifier;
+
+  //indexed by node
+  std::vector<double>            m_GCosts;
+  std::vector<double>            m_RHSCosts;
+  std::vector<Key>               m_Keys;
+  std::vector<bool>              m_bQueued;
+
+  Queue                          m_Queue;
+
+  Key         CalculateKey(int node)const;
+
+  //recalculates the RHS cost of the node and queues it if its costs differ
+  void        UpdateNode(int node);
+
+  //returns the edge leaving the node on its cheapest path to the target.
+  //(NULL if there is none)
+  const Edge* BestEdge(int node)const;
+
+public:
+
+  Graph_SearchDStarLite_TS(const graph_type& G,
+                           int               source,
+                           int               target,
+                           const heuristic&  h = heuristic(),
+                           const edge_cost&  c = edge_cost());
+
+  //the source may be moved at any time. The search then continues until
+  //the cheapest path from the new source is known
+  void                     SetSource(int source);
+
+  //this must be called for every edge whose cost (as given by the edge
+  //cost policy) has changed. The search then continues until the cheapest
+  //path is known again
+  void                     EdgeCostChanged(int from, int to);
+
+  int                      GetSource()const{return m_iSource;}
+  int                      GetTarget()const{return m_iTarget;}
+
+  int                      CycleOnce();
+
+  //the search does not build a tree from the source so this returns only
+  //the edges of the path
+  std::vector<const Edge*> GetSPT()const;
+
+  std::list<int>           GetPathToTarget()const;
+
+  std::list<PathEdge>      GetPathAsPathEdges()const;
+
+  double                   GetCostToTarget()const{return m_GCosts[m_iSource];}
+};
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::Graph_SearchDStarLite_TS(
+                                               const graph_type& G,
+                                               int               source,
+                                               int               target,
+                                               const heuristic&  h,
+                                               const edge_cost&  c):Graph_SearchTimeSliced<Edge>(Graph_SearchTimeSliced<Edge>::AStar),
+                                                                    m_Graph(G),
+                                                                    m_Heuristic(h),
+                                                                    m_EdgeCost(c),
+                                                                    m_iSource(source),
+                                                                    m_iTarget(target),
+                                                                    m_iLastSource(source),
+                                                                    m_dKeyModifier(0.0),
+                                                                    m_GCosts(G.NumNodes(), MaxDouble),
+                                                                    m_RHSCosts(G.NumNodes(), MaxDouble),
+                                                                    m_Keys(G.NumNodes()),
+                                                                    m_bQueued(G.NumNodes(), false)
+{
+  assert (!G.isDigraph() && "<Graph_SearchDStarLite_TS::ctor>: the graph must be undirected");
+
+  //the search starts from the target
+  m_RHSCosts[m_iTarget] = 0.0;
+
+  m_Keys[m_iTarget] = CalculateKey(m_iTarget);
+
+  m_Queue.insert(std::make_pair(m_Keys[m_iTarget], m_iTarget));
+
+  m_bQueued[m_iTarget] = true;
+}
+
+//---------------------------- CalculateKey -----------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+typename Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::Key
+Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::CalculateKey(int node)const
+{
+  double cost = m_GCosts[node] < m_RHSCosts[node] ? m_GCosts[node] : m_RHSCosts[node];
+
+  if (cost == MaxDouble) return Key(MaxDouble, MaxDouble);
+
+  return Key(cost + m_Heuristic.Calculate(m_Graph, m_iSource, node) + m_dKeyModifier, cost);
+}
+
+//----------------------------- UpdateNode ------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+void Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::UpdateNode(int node)
+{
+  if (node != m_iTarget)
+  {
+    const Edge* pBest = BestEdge(node);
+
+    m_RHSCosts[node] = pBest ? m_EdgeCost.Cost(*pBest) + m_GCosts[pBest->To()] : MaxDouble;
+  }
+
+  if (m_bQueued[node])
+  {
+    m_Queue.erase(std::make_pair(m_Keys[node], node));
+
+    m_bQueued[node] = false;
+  }
+
+  if (m_GCosts[node] != m_RHSCosts[node])
+  {
+    m_Keys[node] = CalculateKey(node);
+
+    m_Queue.insert(std::make_pair(m_Keys[node], node));
+
+    m_bQueued[node] = true;
+  }
+}
+
+//------------------------------ BestEdge -------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+const typename graph_type::EdgeType*
+Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::BestEdge(int node)const
+{
+  const Edge* pBest    = NULL;
+  double      BestCost = MaxDouble;
+
+  typename graph_type::ConstEdgeIterator EdgeItr(m_Graph, node);
+  for (const Edge* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+  {
+    if (m_GCosts[pE->To()] == MaxDouble) continue;
+
+    double cost = m_EdgeCost.Cost(*pE) + m_GCosts[pE->To()];
+
+    if (cost < BestCost)
+    {
+      pBest    = pE;
+      BestCost = cost;
+    }
+  }
+
+  return pBest;
+}
+
+//------------------------------ SetSource ------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+void Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::SetSource(int source)
+{
+  if (source == m_iSource) return;
+
+  m_iSource = source;
+
+  m_dKeyModifier += m_Heuristic.Calculate(m_Graph, m_iLastSource, m_iSource);
+
+  m_iLastSource = m_iSource;
+}
+
+//--------------------------- EdgeCostChanged ---------------------------------
+//
+//  only the RHS cost of the edge's source node depends directly on the cost
+//  of the edge
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+void Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::EdgeCostChanged(int from,
+                                                                                 int to)
+{
+  UpdateNode(from);
+}
+
+//------------------------------ CycleOnce ------------------------------------
+//
+//  updates the node at the front of the queue. The search is complete once
+//  the source's costs agree and no queued node could lower them
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+int Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::CycleOnce()
+{
+  if (m_Queue.empty() ||
+      (!(m_Queue.begin()->first < CalculateKey(m_iSource)) &&
+       m_GCosts[m_iSource] == m_RHSCosts[m_iSource]))
+  {
+    return m_GCosts[m_iSource] == MaxDouble ? target_not_found : target_found;
+  }
+
+  Key OldKey = m_Queue.begin()->first;
+  int node   = m_Queue.begin()->second;
+
+  Key NewKey = CalculateKey(node);
+
+  //the key was calculated for an earlier source
+  if (OldKey < NewKey)
+  {
+    m_Queue.erase(m_Queue.begin());
+
+    m_Keys[node] = NewKey;
+
+    m_Queue.insert(std::make_pair(NewKey, node));
+
+    return search_incomplete;
+  }
+
+  m_Queue.erase(m_Queue.begin());
+
+  m_bQueued[node] = false;
+
+  //the node's cost has fallen. The cost is now known
+  if (m_GCosts[node] > m_RHSCosts[node])
+  {
+    m_GCosts[node] = m_RHSCosts[node];
+  }
+
+  //the node's cost has risen. It must be calculated again
+  else
+  {
+    m_GCosts[node] = MaxDouble;
+
+    UpdateNode(node);
+  }
+
+  //the RHS costs of the nodes leading to this one may have changed
+  typename graph_type::ConstEdgeIterator EdgeItr(m_Graph, node);
+  for (const Edge* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+  {
+    UpdateNode(pE->To());
+  }
+
+  return search_incomplete;
+}
+
+//------------------------------- GetSPT --------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+std::vector<const typename graph_type::EdgeType*>
+Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::GetSPT()const
+{
+  std::vector<const Edge*> spt(m_Graph.NumNodes(), NULL);
+
+  std::list<int> path = GetPathToTarget();
+
+  std::list<int>::const_iterator from = path.begin(), to = path.begin();
+
+  if (to != path.end()) ++to;
+
+  for (; to != path.end(); ++from, ++to)
+  {
+    spt[*to] = &m_Graph.GetEdge(*from, *to);
+  }
+
+  return spt;
+}
+
+//-------------------------- GetPathToTarget ----------------------------------
+//
+//  the path is found by repeatedly taking the cheapest edge toward the target
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+std::list<int> 
+Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::GetPathToTarget()const
+{
+  std::list<int> path;
+
+  if (m_GCosts[m_iSource] == MaxDouble) return path;
+
+  int nd = m_iSource;
+
+  path.push_back(nd);
+
+  while (nd != m_iTarget && (int)path.size() <= m_Graph.NumNodes())
+  {
+    const Edge* pE = BestEdge(nd);
+
+    if (!pE) break;
+
+    nd = pE->To();
+
+    path.push_back(nd);
+  }
+
+  return path;
+}
+
+//-------------------------- GetPathAsPathEdges -------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type, class heuristic, class edge_cost>
+std::list<PathEdge> 
+Graph_SearchDStarLite_TS<graph_type, heuristic, edge_cost>::GetPathAsPathEdges()const
+{
+  std::list<PathEdge> path;
+
+  std::list<int> nodes = GetPathToTarget();
+
+  std::list<int>::const_iterator from = nodes.begin(), to = nodes.begin();
+
+  if (to != nodes.end()) ++to;
+
+  for (; to != nodes.end(); ++from, ++to)
+  {
+    const Edge& edge = m_Graph.GetEdge(*from, *to);
+
+    path.push_back(PathEdge(m_Graph.GetNode(*from).Pos(),
+                            m_Graph.GetNode(*to).Pos(),
+                            edge.Flags(),
+                            edge.IDofIntersectingEntity()));
   }
 
   return path;
@@ -8,9 +8,10 @@
 
 
 ///////////////////////////////////////////////////////////////////////////////
-Trigger_HealthGiver::Trigger_HealthGiver(std::ifstream& datafile):
+Trigger_HealthGiver::Trigger_HealthGiver(std::ifstream& datafile,
+                                         const SimClock* clock):
       
-     Trigger_Respawning<Raven_Bot>(GetValueFromStream<int>(datafile))
+     Trigger_Respawning<Raven_Bot>(GetValueFromStream<int>(datafile), clock)
 {
   Read(datafile);
 }
@@ -56,6 +57,6 @@ void Trigger_HealthGiver::Read(std::ifstream& in)
   //create this trigger's region of fluence
   AddCircularTriggerRegion(Pos(), script->GetDouble("DefaultGiverTriggerRange"));
 
-  SetRespawnDelay((unsigned int)(script->GetDouble("Health_RespawnDelay") * FrameRate));
+  SetRespawnDelay(script->GetDouble("Health_RespawnDelay"));
   SetEntityType(type_health);
 }
@@ -27,7 +27,7 @@ private:
   
 public:
 
-  Trigger_HealthGiver(std::ifstream& datafile);
+  Trigger_HealthGiver(std::ifstream& datafile, const SimClock* clock);
 
   //if triggered, the bot's health will be incremented
   void Try(Raven_Bot* pBot);
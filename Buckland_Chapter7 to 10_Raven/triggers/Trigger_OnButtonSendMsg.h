@@ -11,7 +11,7 @@
 //-----------------------------------------------------------------------------
 #include "Triggers/Trigger.h"
 #include "Messaging/MessageDispatcher.h"
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 
 template <class entity_type>
 class Trigger_OnButtonSendMsg : public Trigger<entity_type>
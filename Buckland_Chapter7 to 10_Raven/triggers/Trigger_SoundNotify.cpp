@@ -6,7 +6,7 @@
 #include "Messaging/MessageDispatcher.h"
 #include "../Raven_Messages.h"
 
-#include "misc/cgdi.h"
+#include "misc/Cgdi.h"
 
 //------------------------------ ctor -----------------------------------------
 //-----------------------------------------------------------------------------
@@ -14,7 +14,7 @@
 //            of 1 update-step
 //
 //-----------------------------------------------------------------------------
-#include "Triggers/Trigger_LimitedLifetime.h"
+#include "Triggers/Trigger_LimitedLifeTime.h"
 #include "../Raven_Bot.h"
 
 
@@ -10,9 +10,10 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
-Trigger_WeaponGiver::Trigger_WeaponGiver(std::ifstream& datafile):
+Trigger_WeaponGiver::Trigger_WeaponGiver(std::ifstream& datafile,
+                                         const SimClock* clock):
       
-          Trigger_Respawning<Raven_Bot>(GetValueFromStream<int>(datafile))
+          Trigger_Respawning<Raven_Bot>(GetValueFromStream<int>(datafile), clock)
 {
   Read(datafile);
 
@@ -62,7 +63,7 @@ void Trigger_WeaponGiver::Read(std::ifstream& in)
   AddCircularTriggerRegion(Pos(), script->GetDouble("DefaultGiverTriggerRange"));
 
 
-  SetRespawnDelay((unsigned int)(script->GetDouble("Weapon_RespawnDelay") * FrameRate));
+  SetRespawnDelay(script->GetDouble("Weapon_RespawnDelay"));
 }
 
 
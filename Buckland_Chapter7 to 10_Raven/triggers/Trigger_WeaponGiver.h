@@ -29,7 +29,7 @@ private:
 public:
 
   //this type of trigger is created when reading a map file
-  Trigger_WeaponGiver(std::ifstream& datafile);
+  Trigger_WeaponGiver(std::ifstream& datafile, const SimClock* clock);
 
   //if triggered, this trigger will call the PickupWeapon method of the
   //bot. PickupWeapon will instantiate a weapon of the appropriate type.
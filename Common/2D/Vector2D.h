@@ -10,7 +10,7 @@
 //
 //------------------------------------------------------------------------
 #include <math.h>
-#include <windows.h>
+#include "misc/Win32Compat.h"
 #include <iosfwd>
 #include <limits>
 #include "misc/utils.h"
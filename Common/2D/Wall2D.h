@@ -12,7 +12,7 @@
 //
 //------------------------------------------------------------------------
 #include "misc/Cgdi.h"
-#include "2d/Vector2D.h"
+#include "2D/Vector2D.h"
 #include <fstream>
 
 
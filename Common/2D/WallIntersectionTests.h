@@ -8,8 +8,8 @@
 //          walls
 //-----------------------------------------------------------------------------
 
-#include "2d/Vector2D.h"
-#include "2d/Wall2d.h"
+#include "2D/Vector2D.h"
+#include "2D/Wall2D.h"
 
 
 //----------------------- doWallsObstructLineSegment --------------------------
@@ -24,7 +24,7 @@ inline bool doWallsObstructLineSegment(Vector2D from,
                                        const ContWall& walls)
 {
   //test against the walls
-  ContWall::const_iterator curWall = walls.begin();
+  typename ContWall::const_iterator curWall = walls.begin();
 
   for (curWall; curWall != walls.end(); ++curWall)
   {
@@ -94,7 +94,7 @@ inline bool FindClosestPointOfIntersectionWithWalls(Vector2D        A,
 {
   distance = MaxDouble;
 
-  ContWall::const_iterator curWall = walls.begin();
+  typename ContWall::const_iterator curWall = walls.begin();
   for (curWall; curWall != walls.end(); ++curWall)
   {
     double dist = 0.0;
@@ -115,6 +115,30 @@ inline bool FindClosestPointOfIntersectionWithWalls(Vector2D        A,
   return false;
 }
 
+//---------------------- doWallsIntersectSweptCircle --------------------------
+//
+//  returns true if any walls intersect the area swept by a circle of radius
+//  r moving from A to B
+//-----------------------------------------------------------------------------
+template <class ContWall>
+inline bool doWallsIntersectSweptCircle(const ContWall& walls,
+                                        Vector2D        A,
+                                        Vector2D        B,
+                                        double          r)
+{
+  typename ContWall::const_iterator curWall = walls.begin();
+
+  for (curWall; curWall != walls.end(); ++curWall)
+  {
+    if (LineSegmentSweptCircleIntersection((*curWall)->From(), (*curWall)->To(), A, B, r))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 //------------------------ doWallsIntersectCircle -----------------------------
 //
 //  returns true if any walls intersect the circle of radius at point p
@@ -123,7 +147,7 @@ template <class ContWall>
 inline bool doWallsIntersectCircle(const ContWall& walls, Vector2D p, double r)
 {
   //test against the walls
-  ContWall::const_iterator curWall = walls.begin();
+  typename ContWall::const_iterator curWall = walls.begin();
 
   for (curWall; curWall != walls.end(); ++curWall)
   {
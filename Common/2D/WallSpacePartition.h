@@ -0,0 +1,671 @@
+#ifndef WALLSPACEPARTITION_H
+#define WALLSPACEPARTITION_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   WallSpacePartition.h
+//
+//  Desc:   divides the area covered by a set of walls into a grid of square
+//          cells, each of which records the walls passing through it. Line
+//          segment queries walk only the cells the segment passes through
+//          (in order, so the closest intersection can be found without
+//          visiting every cell) and circle and box queries examine only the
+//          cells they overlap.
+//
+//          The partition is built once. Walls that may move after it has
+//          been built (such as the walls of a sliding door) must be given
+//          to the constructor as moving walls; these are not partitioned
+//          but are tested by every query.
+//
+//          The functions at the end of this file overload those in
+//          WallIntersectionTests.h so a WallSpacePartition can be passed
+//          wherever a container of walls is expected.
+//
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "2D/Vector2D.h"
+#include "2D/Wall2D.h"
+#include "2D/geometry.h"
+#include "misc/utils.h"
+
+
+class WallSpacePartition
+{
+private:
+
+  typedef std::vector<int> WallIndices;
+
+  //the walls being partitioned. The cells store indices into this vector
+  std::vector<Wall2D*>      m_Walls;
+
+  //the indices of the walls that may move
+  WallIndices               m_MovingWalls;
+
+  //the indices of the static walls passing through each cell
+  std::vector<WallIndices>  m_Cells;
+
+  //the grid covers the bounding box of the static walls. m_vOrigin is its
+  //top left corner
+  Vector2D  m_vOrigin;
+  double    m_dCellSize;
+  int       m_iNumCellsX;
+  int       m_iNumCellsY;
+
+  //walls are added to every cell they pass within this distance of so
+  //that rounding errors can never cause a query to miss one
+  double    m_dPadding;
+
+
+  //given a rectangle this method determines the range of cells (inclusive)
+  //it overlaps. Returns false if it lies outside the grid
+  inline bool CellRange(Vector2D TopLeft, Vector2D BottomRight,
+                        int& x0, int& y0, int& x1, int& y1)const;
+
+  //clips the line segment AB to the box described by TopLeft and
+  //BottomRight. Returns false if the segment misses the box, otherwise
+  //t0 and t1 are set to the portion of AB (as a fraction of its length)
+  //lying inside it
+  static inline bool ClipSegmentToBox(Vector2D A, Vector2D B,
+                                      Vector2D TopLeft, Vector2D BottomRight,
+                                      double& t0, double& t1);
+
+  //visits, in order, each cell a line segment passes through
+  class SegmentWalker
+  {
+  private:
+
+    const WallSpacePartition& m_Space;
+
+    int     m_iX, m_iY;
+    int     m_iStepX, m_iStepY;
+
+    //the fraction of the segment travelled when the next vertical (x) and
+    //horizontal (y) cell edges are crossed, and the fraction between
+    //successive crossings
+    double  m_dNextX, m_dNextY;
+    double  m_dDeltaX, m_dDeltaY;
+
+    //the fraction of the segment travelled when it leaves the grid
+    double  m_dEnd;
+
+    bool    m_bFinished;
+
+    SegmentWalker& operator=(const SegmentWalker&);
+
+  public:
+
+    inline SegmentWalker(const WallSpacePartition& space, Vector2D A, Vector2D B);
+
+    //returns false when there are no more cells. Otherwise sets cell to the
+    //index of the next cell and ExitT to the fraction of the segment
+    //travelled when it leaves that cell
+    inline bool Next(int& cell, double& ExitT);
+  };
+
+  //copy ctor and assignment should be private
+  WallSpacePartition(const WallSpacePartition&);
+  WallSpacePartition& operator=(const WallSpacePartition&);
+
+public:
+
+  inline WallSpacePartition(const std::vector<Wall2D*>& walls,
+                            const std::vector<Wall2D*>& MovingWalls,
+                            double                      CellSize);
+
+  //returns true if the line segment AB intersects any wall
+  inline bool isObstructed(Vector2D A, Vector2D B)const;
+
+  //finds the closest point at which the line segment AB intersects a wall.
+  //The point is stored in ip and its distance from A in distance. Returns
+  //false if there is no intersection
+  inline bool FindClosestIntersection(Vector2D  A,
+                                      Vector2D  B,
+                                      double&   distance,
+                                      Vector2D& ip)const;
+
+  //returns true if any wall intersects the circle of radius r at p
+  inline bool isOverlappingCircle(Vector2D p, double r)const;
+
+  //returns true if any wall intersects the area swept by a circle of
+  //radius r moving from A to B. Each row of cells is only examined between
+  //the left and rightmost points of the swept area within it
+  inline bool isOverlappingSweptCircle(Vector2D A, Vector2D B, double r)const;
+
+  //fills Result with every wall that may pass through the given rectangle.
+  //The walls are in the order they were given to the constructor.
+  //(callers are expected to make their own exact test)
+  inline void QueryBox(Vector2D              TopLeft,
+                       Vector2D              BottomRight,
+                       std::vector<Wall2D*>& Result)const;
+
+  const std::vector<Wall2D*>& GetWalls()const{return m_Walls;}
+};
+
+
+//----------------------------- ctor -------------------------------------
+//------------------------------------------------------------------------
+inline WallSpacePartition::WallSpacePartition(const std::vector<Wall2D*>& walls,
+                                              const std::vector<Wall2D*>& MovingWalls,
+                                              double                      CellSize):
+                                              m_Walls(walls),
+                                              m_dCellSize(CellSize),
+                                              m_iNumCellsX(0),
+                                              m_iNumCellsY(0),
+                                              m_dPadding(CellSize * 0.001)
+{
+  assert (CellSize > 0 && "<WallSpacePartition::WallSpacePartition>: invalid cell size");
+
+  //sort the walls into static and moving and find the bounds of the
+  //static walls
+  WallIndices StaticWalls;
+
+  Vector2D TopLeft(MaxDouble, MaxDouble);
+  Vector2D BottomRight(-MaxDouble, -MaxDouble);
+
+  for (unsigned int w=0; w<m_Walls.size(); ++w)
+  {
+    if (std::find(MovingWalls.begin(), MovingWalls.end(), m_Walls[w]) != MovingWalls.end())
+    {
+      m_MovingWalls.push_back(w);
+
+      continue;
+    }
+
+    StaticWalls.push_back(w);
+
+    Vector2D from = m_Walls[w]->From();
+    Vector2D to   = m_Walls[w]->To();
+
+    TopLeft.x     = MinOf(TopLeft.x,     MinOf(from.x, to.x));
+    TopLeft.y     = MinOf(TopLeft.y,     MinOf(from.y, to.y));
+    BottomRight.x = MaxOf(BottomRight.x, MaxOf(from.x, to.x));
+    BottomRight.y = MaxOf(BottomRight.y, MaxOf(from.y, to.y));
+  }
+
+  if (StaticWalls.empty()) return;
+
+  Vector2D pad(m_dPadding, m_dPadding);
+
+  m_vOrigin    = TopLeft - pad;
+  m_iNumCellsX = MaxOf(1, (int)ceil((BottomRight.x - TopLeft.x + 2*m_dPadding) / CellSize));
+  m_iNumCellsY = MaxOf(1, (int)ceil((BottomRight.y - TopLeft.y + 2*m_dPadding) / CellSize));
+
+  m_Cells.resize(m_iNumCellsX * m_iNumCellsY);
+
+  //add each static wall to every cell it passes through
+  WallIndices::const_iterator curWall = StaticWalls.begin();
+  for (curWall; curWall != StaticWalls.end(); ++curWall)
+  {
+    Vector2D from = m_Walls[*curWall]->From();
+    Vector2D to   = m_Walls[*curWall]->To();
+
+    int x0, y0, x1, y1;
+    CellRange(Vector2D(MinOf(from.x, to.x), MinOf(from.y, to.y)) - pad,
+              Vector2D(MaxOf(from.x, to.x), MaxOf(from.y, to.y)) + pad,
+              x0, y0, x1, y1);
+
+    for (int y=y0; y<=y1; ++y)
+    {
+      for (int x=x0; x<=x1; ++x)
+      {
+        Vector2D CellTopLeft = m_vOrigin + Vector2D(x*CellSize, y*CellSize);
+        double   t0, t1;
+
+        if (ClipSegmentToBox(from, to,
+                             CellTopLeft - pad,
+                             CellTopLeft + Vector2D(CellSize, CellSize) + pad,
+                             t0, t1))
+        {
+          m_Cells[y*m_iNumCellsX + x].push_back(*curWall);
+        }
+      }
+    }
+  }
+}
+
+//--------------------------- CellRange ----------------------------------
+//------------------------------------------------------------------------
+inline bool WallSpacePartition::CellRange(Vector2D TopLeft, Vector2D BottomRight,
+                                          int& x0, int& y0, int& x1, int& y1)const
+{
+  if (m_Cells.empty()) return false;
+
+  double left   = (TopLeft.x     - m_vOrigin.x) / m_dCellSize;
+  double top    = (TopLeft.y     - m_vOrigin.y) / m_dCellSize;
+  double right  = (BottomRight.x - m_vOrigin.x) / m_dCellSize;
+  double bottom = (BottomRight.y - m_vOrigin.y) / m_dCellSize;
+
+  if (right < 0 || bottom < 0 || left >= m_iNumCellsX || top >= m_iNumCellsY)
+  {
+    return false;
+  }
+
+  x0 = MaxOf(0, (int)floor(left));
+  y0 = MaxOf(0, (int)floor(top));
+  x1 = MinOf(m_iNumCellsX-1, (int)floor(right));
+  y1 = MinOf(m_iNumCellsY-1, (int)floor(bottom));
+
+  return true;
+}
+
+//------------------------ ClipSegmentToBox ------------------------------
+//
+//  a slab test: the segment is clipped against each axis in turn
+//------------------------------------------------------------------------
+inline bool WallSpacePartition::ClipSegmentToBox(Vector2D A, Vector2D B,
+                                                 Vector2D TopLeft,
+                                                 Vector2D BottomRight,
+                                                 double& t0, double& t1)
+{
+  t0 = 0.0;
+  t1 = 1.0;
+
+  const double start[2] = {A.x, A.y};
+  const double delta[2] = {B.x - A.x, B.y - A.y};
+  const double lo[2]    = {TopLeft.x, TopLeft.y};
+  const double hi[2]    = {BottomRight.x, BottomRight.y};
+
+  for (int axis=0; axis<2; ++axis)
+  {
+    if (delta[axis] == 0)
+    {
+      if (start[axis] < lo[axis] || start[axis] > hi[axis]) return false;
+
+      continue;
+    }
+
+    double tLo = (lo[axis] - start[axis]) / delta[axis];
+    double tHi = (hi[axis] - start[axis]) / delta[axis];
+
+    if (tLo > tHi) std::swap(tLo, tHi);
+
+    if (tLo > t0) t0 = tLo;
+    if (tHi < t1) t1 = tHi;
+
+    if (t0 > t1) return false;
+  }
+
+  return true;
+}
+
+//------------------------- SegmentWalker --------------------------------
+//
+//  the segment is first clipped to the grid. The walk then steps from cell
+//  to cell, each time crossing whichever cell edge the segment meets first
+//------------------------------------------------------------------------
+inline WallSpacePartition::SegmentWalker::SegmentWalker(const WallSpacePartition& space,
+                                                        Vector2D                  A,
+                                                        Vector2D                  B):
+                                                        m_Space(space),
+                                                        m_bFinished(true)
+{
+  if (space.m_Cells.empty()) return;
+
+  double   size = space.m_dCellSize;
+  Vector2D GridBottomRight = space.m_vOrigin + Vector2D(space.m_iNumCellsX * size,
+                                                        space.m_iNumCellsY * size);
+  double   tStart;
+
+  if (!ClipSegmentToBox(A, B, space.m_vOrigin, GridBottomRight, tStart, m_dEnd))
+  {
+    return;
+  }
+
+  m_bFinished = false;
+
+  Vector2D delta = B - A;
+  Vector2D start = A + delta * tStart - space.m_vOrigin;
+
+  m_iX = MinOf(MaxOf(0, (int)floor(start.x / size)), space.m_iNumCellsX-1);
+  m_iY = MinOf(MaxOf(0, (int)floor(start.y / size)), space.m_iNumCellsY-1);
+
+  //calculate when the segment first crosses a cell edge on each axis
+  if (delta.x > 0)
+  {
+    m_iStepX  = 1;
+    m_dNextX  = (space.m_vOrigin.x + (m_iX+1)*size - A.x) / delta.x;
+    m_dDeltaX = size / delta.x;
+  }
+  else if (delta.x < 0)
+  {
+    m_iStepX  = -1;
+    m_dNextX  = (space.m_vOrigin.x + m_iX*size - A.x) / delta.x;
+    m_dDeltaX = -size / delta.x;
+  }
+  else
+  {
+    m_iStepX  = 0;
+    m_dNextX  = MaxDouble;
+    m_dDeltaX = MaxDouble;
+  }
+
+  if (delta.y > 0)
+  {
+    m_iStepY  = 1;
+    m_dNextY  = (space.m_vOrigin.y + (m_iY+1)*size - A.y) / delta.y;
+    m_dDeltaY = size / delta.y;
+  }
+  else if (delta.y < 0)
+  {
+    m_iStepY  = -1;
+    m_dNextY  = (space.m_vOrigin.y + m_iY*size - A.y) / delta.y;
+    m_dDeltaY = -size / delta.y;
+  }
+  else
+  {
+    m_iStepY  = 0;
+    m_dNextY  = MaxDouble;
+    m_dDeltaY = MaxDouble;
+  }
+}
+
+inline bool WallSpacePartition::SegmentWalker::Next(int& cell, double& ExitT)
+{
+  if (m_bFinished) return false;
+
+  cell  = m_iY * m_Space.m_iNumCellsX + m_iX;
+  ExitT = MinOf(m_dEnd, MinOf(m_dNextX, m_dNextY));
+
+  //the segment ends in this cell
+  if (ExitT >= m_dEnd)
+  {
+    m_bFinished = true;
+
+    return true;
+  }
+
+  if (m_dNextX < m_dNextY)
+  {
+    m_iX     += m_iStepX;
+    m_dNextX += m_dDeltaX;
+  }
+  else
+  {
+    m_iY     += m_iStepY;
+    m_dNextY += m_dDeltaY;
+  }
+
+  if (m_iX < 0 || m_iX >= m_Space.m_iNumCellsX ||
+      m_iY < 0 || m_iY >= m_Space.m_iNumCellsY)
+  {
+    m_bFinished = true;
+  }
+
+  return true;
+}
+
+//--------------------------- isObstructed -------------------------------
+//
+//  returns as soon as any intersection is found
+//------------------------------------------------------------------------
+inline bool WallSpacePartition::isObstructed(Vector2D A, Vector2D B)const
+{
+  WallIndices::const_iterator curWall = m_MovingWalls.begin();
+  for (curWall; curWall != m_MovingWalls.end(); ++curWall)
+  {
+    if (LineIntersection2D(A, B, m_Walls[*curWall]->From(), m_Walls[*curWall]->To()))
+    {
+      return true;
+    }
+  }
+
+  SegmentWalker walk(*this, A, B);
+  int           cell;
+  double        ExitT;
+
+  while (walk.Next(cell, ExitT))
+  {
+    for (curWall = m_Cells[cell].begin(); curWall != m_Cells[cell].end(); ++curWall)
+    {
+      if (LineIntersection2D(A, B, m_Walls[*curWall]->From(), m_Walls[*curWall]->To()))
+      {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+//---------------------- FindClosestIntersection -------------------------
+//
+//  the cells are visited in order along the segment so the search can stop
+//  once an intersection has been found that is closer than the point at
+//  which the segment leaves the current cell
+//------------------------------------------------------------------------
+inline bool WallSpacePartition::FindClosestIntersection(Vector2D  A,
+                                                        Vector2D  B,
+                                                        double&   distance,
+                                                        Vector2D& ip)const
+{
+  distance = MaxDouble;
+
+  double   dist;
+  Vector2D point;
+
+  WallIndices::const_iterator curWall = m_MovingWalls.begin();
+  for (curWall; curWall != m_MovingWalls.end(); ++curWall)
+  {
+    if (LineIntersection2D(A, B, m_Walls[*curWall]->From(), m_Walls[*curWall]->To(), dist, point))
+    {
+      if (dist < distance)
+      {
+        distance = dist;
+        ip = point;
+      }
+    }
+  }
+
+  double        length = Vec2DDistance(A, B);
+  SegmentWalker walk(*this, A, B);
+  int           cell;
+  double        ExitT;
+
+  while (walk.Next(cell, ExitT))
+  {
+    for (curWall = m_Cells[cell].begin(); curWall != m_Cells[cell].end(); ++curWall)
+    {
+      if (LineIntersection2D(A, B, m_Walls[*curWall]->From(), m_Walls[*curWall]->To(), dist, point))
+      {
+        if (dist < distance)
+        {
+          distance = dist;
+          ip = point;
+        }
+      }
+    }
+
+    //no wall in a later cell can be closer
+    if (distance <= ExitT * length) break;
+  }
+
+  if (distance < MaxDouble) return true;
+
+  return false;
+}
+
+//------------------------ isOverlappingCircle ---------------------------
+//------------------------------------------------------------------------
+inline bool WallSpacePartition::isOverlappingCircle(Vector2D p, double r)const
+{
+  WallIndices::const_iterator curWall = m_MovingWalls.begin();
+  for (curWall; curWall != m_MovingWalls.end(); ++curWall)
+  {
+    if (LineSegmentCircleIntersection(m_Walls[*curWall]->From(), m_Walls[*curWall]->To(), p, r))
+    {
+      return true;
+    }
+  }
+
+  int x0, y0, x1, y1;
+  if (!CellRange(p - Vector2D(r, r), p + Vector2D(r, r), x0, y0, x1, y1))
+  {
+    return false;
+  }
+
+  for (int y=y0; y<=y1; ++y)
+  {
+    for (int x=x0; x<=x1; ++x)
+    {
+      const WallIndices& cell = m_Cells[y*m_iNumCellsX + x];
+
+      for (curWall = cell.begin(); curWall != cell.end(); ++curWall)
+      {
+        if (LineSegmentCircleIntersection(m_Walls[*curWall]->From(), m_Walls[*curWall]->To(), p, r))
+        {
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+//----------------------------- QueryBox ---------------------------------
+//
+//  a wall may pass through several of the cells so the indices are sorted
+//  to remove duplicates, which also restores the original order
+//------------------------------------------------------------------------
+inline void WallSpacePartition::QueryBox(Vector2D              TopLeft,
+                                         Vector2D              BottomRight,
+                                         std::vector<Wall2D*>& Result)const
+{
+  Result.clear();
+
+  WallIndices found(m_MovingWalls);
+
+  int x0, y0, x1, y1;
+  if (CellRange(TopLeft, BottomRight, x0, y0, x1, y1))
+  {
+    for (int y=y0; y<=y1; ++y)
+    {
+      for (int x=x0; x<=x1; ++x)
+      {
+        const WallIndices& cell = m_Cells[y*m_iNumCellsX + x];
+
+        found.insert(found.end(), cell.begin(), cell.end());
+      }
+    }
+  }
+
+  std::sort(found.begin(), found.end());
+
+  WallIndices::const_iterator curWall = found.begin();
+  WallIndices::const_iterator end     = std::unique(found.begin(), found.end());
+
+  for (curWall; curWall != end; ++curWall)
+  {
+    Result.push_back(m_Walls[*curWall]);
+  }
+}
+
+//----------------------- isOverlappingSweptCircle -----------------------
+//------------------------------------------------------------------------
+inline bool WallSpacePartition::isOverlappingSweptCircle(Vector2D A, Vector2D B, double r)const
+{
+  WallIndices::const_iterator curWall = m_MovingWalls.begin();
+  for (curWall; curWall != m_MovingWalls.end(); ++curWall)
+  {
+    if (LineSegmentSweptCircleIntersection(m_Walls[*curWall]->From(), m_Walls[*curWall]->To(), A, B, r))
+    {
+      return true;
+    }
+  }
+
+  Vector2D TopLeft(MinOf(A.x, B.x) - r, MinOf(A.y, B.y) - r);
+  Vector2D BottomRight(MaxOf(A.x, B.x) + r, MaxOf(A.y, B.y) + r);
+
+  int x0, y0, x1, y1;
+  if (!CellRange(TopLeft, BottomRight, x0, y0, x1, y1))
+  {
+    return false;
+  }
+
+  for (int y=y0; y<=y1; ++y)
+  {
+    //the part of AB passing within r of the row determines which of the
+    //row's cells the swept area overlaps
+    double RowTop    = m_vOrigin.y + y * m_dCellSize - r;
+    double RowBottom = RowTop + m_dCellSize + 2*r;
+
+    double t0 = 0, t1 = 1;
+
+    if (A.y != B.y)
+    {
+      double tTop    = (RowTop    - A.y) / (B.y - A.y);
+      double tBottom = (RowBottom - A.y) / (B.y - A.y);
+
+      t0 = MaxOf(t0, MinOf(tTop, tBottom));
+      t1 = MinOf(t1, MaxOf(tTop, tBottom));
+
+      if (t0 > t1) continue;
+    }
+    else if (A.y < RowTop || A.y > RowBottom)
+    {
+      continue;
+    }
+
+    double xA = A.x + (B.x - A.x) * t0;
+    double xB = A.x + (B.x - A.x) * t1;
+
+    int left  = MaxOf(x0, (int)floor((MinOf(xA, xB) - r - m_vOrigin.x) / m_dCellSize));
+    int right = MinOf(x1, (int)floor((MaxOf(xA, xB) + r - m_vOrigin.x) / m_dCellSize));
+
+    for (int x=left; x<=right; ++x)
+    {
+      const WallIndices& cell = m_Cells[y*m_iNumCellsX + x];
+
+      for (curWall = cell.begin(); curWall != cell.end(); ++curWall)
+      {
+        if (LineSegmentSweptCircleIntersection(m_Walls[*curWall]->From(), m_Walls[*curWall]->To(), A, B, r))
+        {
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//  overloads of the functions in WallIntersectionTests.h
+///////////////////////////////////////////////////////////////////////////////
+
+inline bool doWallsObstructLineSegment(Vector2D                  from,
+                                       Vector2D                  to,
+                                       const WallSpacePartition& walls)
+{
+  return walls.isObstructed(from, to);
+}
+
+inline bool FindClosestPointOfIntersectionWithWalls(Vector2D                  A,
+                                                    Vector2D                  B,
+                                                    double&                   distance,
+                                                    Vector2D&                 ip,
+                                                    const WallSpacePartition& walls)
+{
+  return walls.FindClosestIntersection(A, B, distance, ip);
+}
+
+inline bool doWallsIntersectCircle(const WallSpacePartition& walls, Vector2D p, double r)
+{
+  return walls.isOverlappingCircle(p, r);
+}
+
+inline bool doWallsIntersectSweptCircle(const WallSpacePartition& walls,
+                                        Vector2D                  A,
+                                        Vector2D                  B,
+                                        double                    r)
+{
+  return walls.isOverlappingSweptCircle(A, B, r);
+}
+
+
+
+#endif
@@ -10,8 +10,8 @@
 //
 //------------------------------------------------------------------------
 #include "misc/utils.h"
-#include "2d/Vector2D.h"
-#include "2d/C2DMatrix.h"
+#include "2D/Vector2D.h"
+#include "2D/C2DMatrix.h"
 #include "Transformations.h"
 
 #include <math.h>
@@ -570,6 +570,29 @@ inline bool   LineSegmentCircleIntersection(Vector2D A,
 
 }
 
+//------------------ LineSegmentSweptCircleIntersection ------------------------
+//
+//  returns true if the line segment AB intersects the area swept by a circle
+//  of radius radius moving from From to To. (true if the distance between
+//  the two line segments is less than the radius)
+//-----------------------------------------------------------------------------
+inline bool LineSegmentSweptCircleIntersection(Vector2D A,
+                                               Vector2D B,
+                                               Vector2D From,
+                                               Vector2D To,
+                                               double   radius)
+{
+  double RadiusSq = radius*radius;
+
+  //if the segments do not cross, the closest points of the two include an
+  //end point of one of them
+  return LineIntersection2D(A, B, From, To)           ||
+         DistToLineSegmentSq(A, B, From) < RadiusSq   ||
+         DistToLineSegmentSq(A, B, To) < RadiusSq     ||
+         DistToLineSegmentSq(From, To, A) < RadiusSq  ||
+         DistToLineSegmentSq(From, To, B) < RadiusSq;
+}
+
 //------------------- GetLineSegmentCircleClosestIntersectionPoint ------------
 //
 //  given a line segment AB and a circle position and radius, this function
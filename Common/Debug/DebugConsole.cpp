@@ -1,4 +1,8 @@
 #include "Debug/DebugConsole.h"
+
+//there is only a console window to manage on Windows
+#ifdef _WIN32
+
 #include <iterator>
 #pragma warning (disable : 4786)
 
@@ -351,4 +355,6 @@ void DebugConsole::WriteAndResetBuffer()
   m_Buffer.clear();
 
   SendMessage(m_hwnd, UM_SETSCROLL, NULL, NULL);
-}
\ No newline at end of file
+}
+
+#endif //_WIN32
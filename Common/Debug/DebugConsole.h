@@ -18,16 +18,18 @@
 //
 //------------------------------------------------------------------------
 #include <vector>
-#include <windows.h>
 #include <iosfwd>
 #include <fstream>
 
 #include "misc/utils.h"
-#include "misc/WindowUtils.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#include "misc/WindowUtils.h"
 
 //need to define a custom message
 const int UM_SETSCROLL = WM_USER + 32;
+#endif
 
 //maximum number of lines shown in console before the buffer is flushed to 
 //a file
@@ -38,7 +40,11 @@ const int DEBUG_WINDOW_WIDTH  = 400;
 const int DEBUG_WINDOW_HEIGHT = 400;
 
 //undefine DEBUG to send all debug messages to hyperspace (a sink - see below)
+//windowless builds (RAVEN_HEADLESS) always use the sink, as does any build
+//off Windows, where there is no console window to open
+#if !defined(RAVEN_HEADLESS) && defined(_WIN32)
 #define DEBUG
+#endif
 #ifdef DEBUG
 #define debug_con *(DebugConsole::Instance())
 #else
@@ -46,8 +52,13 @@ const int DEBUG_WINDOW_HEIGHT = 400;
 #endif
 
 //use these in your code to toggle output to the console on/off
+#ifdef _WIN32
 #define debug_on  DebugConsole::On();
 #define debug_off DebugConsole::Off();
+#else
+#define debug_on
+#define debug_off
+#endif
 
 
 //this little class just acts as a sink for any input. Used in place
@@ -75,6 +86,8 @@ public:
 
 
 
+#ifdef _WIN32
+
 class DebugConsole
 {
 private:
@@ -176,4 +189,6 @@ public:
 
  
 
+#endif //_WIN32
+
 #endif
\ No newline at end of file
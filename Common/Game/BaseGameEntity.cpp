@@ -1,8 +1,7 @@
 #include "BaseGameEntity.h"
+#include "WorldContext.h"
 
 
-int BaseGameEntity::m_iNextValidID = 0;
-
 //------------------------------ ctor -----------------------------------------
 //-----------------------------------------------------------------------------
 BaseGameEntity::BaseGameEntity(int ID):m_dBoundingRadius(0.0),
@@ -23,9 +22,23 @@ BaseGameEntity::BaseGameEntity(int ID):m_dBoundingRadius(0.0),
 void BaseGameEntity::SetID(int val)
 {
   //make sure the val is equal to or greater than the next available ID
-  assert ( (val >= m_iNextValidID) && "<BaseGameEntity::SetID>: invalid ID");
+  assert ( (val >= GetNextValidID()) && "<BaseGameEntity::SetID>: invalid ID");
 
   m_ID = val;
     
-  m_iNextValidID = m_ID + 1;
+  WorldContext::Current()->SetNextValidEntityID(m_ID + 1);
+}
+
+//------------------------- GetNextValidID ------------------------------------
+//-----------------------------------------------------------------------------
+int BaseGameEntity::GetNextValidID()
+{
+  return WorldContext::Current()->GetNextValidEntityID();
+}
+
+//------------------------ ResetNextValidID -----------------------------------
+//-----------------------------------------------------------------------------
+void BaseGameEntity::ResetNextValidID()
+{
+  WorldContext::Current()->SetNextValidEntityID(0);
 }
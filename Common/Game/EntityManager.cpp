@@ -1,16 +1,15 @@
-#include "game/EntityManager.h"
-#include "game/BaseGameEntity.h"
+#include "Game/EntityManager.h"
+#include "Game/BaseGameEntity.h"
+#include "Game/WorldContext.h"
 
 
 //--------------------------- Instance ----------------------------------------
 //
-//   this class is a singleton
+//   returns the instance owned by the current world context
 //-----------------------------------------------------------------------------
 EntityManager* EntityManager::Instance()
 {
-  static EntityManager instance;
-
-  return &instance;
+  return WorldContext::Current()->GetEntityMgr();
 }
 
 //------------------------- GetEntityFromID -----------------------------------
@@ -5,7 +5,9 @@
 //
 //  Name:   EntityManager.h
 //
-//  Desc:   Singleton class to handle the  management of Entities.          
+//  Desc:   class to handle the  management of Entities. Each world
+//          context owns one; EntityMgr refers to the instance belonging to
+//          the context current on the calling thread.
 //
 //  Author: Mat Buckland (fup@ai-junkie.com)
 //
@@ -33,6 +35,8 @@ private:
   //pointers to entities are cross referenced by their identifying number
   EntityMap m_EntityMap;
 
+  friend class WorldContext;
+
   EntityManager(){}
 
   //copy ctor and assignment should be private
@@ -41,6 +45,7 @@ private:
 
 public:
 
+  //returns the entity manager of the current world context
   static EntityManager* Instance();
 
   //this method stores a pointer to the entity in the std::vector
@@ -0,0 +1,47 @@
+#include "Game/WorldContext.h"
+#include "Game/EntityManager.h"
+#include "Messaging/MessageDispatcher.h"
+#include "misc/FrameCounter.h"
+
+
+//the context made current on this thread by the innermost open Scope
+static thread_local WorldContext* g_pCurrentContext = 0;
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+WorldContext::WorldContext():m_pEntityMgr(new EntityManager()),
+                             m_pDispatcher(new MessageDispatcher()),
+                             m_pTickCounter(new FrameCounter()),
+                             m_iNextValidEntityID(0)
+{}
+
+//------------------------------- dtor ----------------------------------------
+//-----------------------------------------------------------------------------
+WorldContext::~WorldContext()
+{
+  delete m_pTickCounter;
+  delete m_pDispatcher;
+  delete m_pEntityMgr;
+}
+
+//------------------------------ Current --------------------------------------
+//-----------------------------------------------------------------------------
+WorldContext* WorldContext::Current()
+{
+  if (g_pCurrentContext) return g_pCurrentContext;
+
+  return GetDefaultWorldContext();
+}
+
+//------------------------------- Scope ---------------------------------------
+//-----------------------------------------------------------------------------
+WorldContext::Scope::Scope(WorldContext* pContext):m_pPrevious(g_pCurrentContext)
+{
+  if (pContext) g_pCurrentContext = pContext;
+}
+
+WorldContext::Scope::~Scope()
+{
+  g_pCurrentContext = m_pPrevious;
+}
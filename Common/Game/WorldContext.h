@@ -0,0 +1,86 @@
+#ifndef WORLD_CONTEXT_H
+#define WORLD_CONTEXT_H
+#pragma warning (disable:4786)
+//------------------------------------------------------------------------
+//
+//  Name:   WorldContext.h
+//
+//  Desc:   bundles together the objects a game world would otherwise share
+//          with every other world in the process: the entity manager, the
+//          message dispatcher, the frame counter and the next valid entity
+//          ID. Each game world owns a context so that any number of worlds
+//          can exist (and be updated on different threads) at once.
+//
+//          The EntityMgr, Dispatcher and TickCounter macros resolve to the
+//          objects of the context that is current on the calling thread.
+//          A context is made current by creating a WorldContext::Scope. If
+//          no scope is open on a thread the default context is used.
+//
+//------------------------------------------------------------------------
+
+class EntityManager;
+class MessageDispatcher;
+class FrameCounter;
+
+
+class WorldContext
+{
+private:
+
+  EntityManager*     m_pEntityMgr;
+  MessageDispatcher* m_pDispatcher;
+  FrameCounter*      m_pTickCounter;
+
+  //the ID given to the next BaseGameEntity created in this world
+  int                m_iNextValidEntityID;
+
+  //copy ctor and assignment should be private
+  WorldContext(const WorldContext&);
+  WorldContext& operator=(const WorldContext&);
+
+public:
+
+  //while an instance of this class exists the given context is current on
+  //the thread that created it. Scopes may be nested; the previously current
+  //context is restored when the scope is destroyed. A NULL context leaves
+  //the current context unchanged.
+  class Scope
+  {
+  private:
+
+    WorldContext* m_pPrevious;
+
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+  public:
+
+    explicit Scope(WorldContext* pContext);
+    ~Scope();
+  };
+
+public:
+
+  WorldContext();
+  virtual ~WorldContext();
+
+  //returns the context current on the calling thread
+  static WorldContext* Current();
+
+  EntityManager*     GetEntityMgr()const{return m_pEntityMgr;}
+  MessageDispatcher* GetDispatcher()const{return m_pDispatcher;}
+  FrameCounter*      GetTickCounter()const{return m_pTickCounter;}
+
+  int                GetNextValidEntityID()const{return m_iNextValidEntityID;}
+  void               SetNextValidEntityID(int id){m_iNextValidEntityID = id;}
+};
+
+
+//this must be defined by the application. It returns the context used by
+//any thread that has no scope open. (this allows the application to use a
+//context type derived from WorldContext)
+WorldContext* GetDefaultWorldContext();
+
+
+
+#endif
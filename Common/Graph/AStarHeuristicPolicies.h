@@ -7,9 +7,14 @@
 //  Author: Mat Buckland (www.ai-junkie.com)
 //
 //  Desc:   class templates defining a heuristic policy for use with the A*
-//          search algorithm
+//          search algorithm.
+//
+//          The searches call Calculate on an instance of the policy so a
+//          policy may carry data of its own, such as Heuristic_Landmarks'
+//          table.
 //-----------------------------------------------------------------------------
 #include "misc/utils.h"
+#include "Graph/GraphLandmarks.h"
 
 //-----------------------------------------------------------------------------
 //the euclidian heuristic (straight-line distance)
@@ -64,6 +69,39 @@ public:
   }
 };
 
+//-----------------------------------------------------------------------------
+//the landmark (or ALT) heuristic. This is the greater of the straight line
+//distance and the lower bound given by a table of the costs from a few
+//landmark nodes (see GraphLandmarks.h). Far fewer nodes are expanded on
+//maps where walls make the straight line a poor estimate. Without a table
+//this is the same as Heuristic_Euclid
+//-----------------------------------------------------------------------------
+class Heuristic_Landmarks
+{
+private:
+
+  const GraphLandmarks* m_pLandmarks;
+
+public:
+
+  Heuristic_Landmarks(const GraphLandmarks* pLandmarks = NULL):m_pLandmarks(pLandmarks){}
+
+  template <class graph_type>
+  double Calculate(const graph_type& G, int nd1, int nd2)const
+  {
+    double h = Heuristic_Euclid::Calculate(G, nd1, nd2);
+
+    if (m_pLandmarks)
+    {
+      double bound = m_pLandmarks->LowerBound(nd1, nd2);
+
+      if (bound > h) h = bound;
+    }
+
+    return h;
+  }
+};
+
 
 
 
@@ -0,0 +1,278 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   CSRGraph.h
+//
+//  Desc:   a read only copy of a SparseGraph using the compressed sparse row
+//          representation. All the edges are held in one contiguous array,
+//          sorted by the node they leave, and each node keeps the offset of
+//          its first edge. Walking the edges of a node is therefore a walk
+//          along consecutive memory rather than along a linked list.
+//
+//          The class provides the same typedefs, accessors and const
+//          iterators as SparseGraph so the search algorithms can be used
+//          with either. The edges of each node keep the order they have in
+//          the source graph, so a search of a CSRGraph visits the nodes in
+//          exactly the same order as a search of the graph it was built from.
+//
+//          Once built the graph cannot be altered. If the source graph
+//          changes the CSRGraph must be rebuilt.
+//
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <cassert>
+
+#include "Graph/SparseGraph.h"
+#include "Graph/NodeTypeEnumerations.h"
+
+
+template <class node_type, class edge_type>
+class CSRGraph
+{
+public:
+
+  //enable easy client access to the edge and node types used in the graph
+  typedef edge_type                EdgeType;
+  typedef node_type                NodeType;
+
+  typedef SparseGraph<node_type, edge_type> SourceGraph;
+
+private:
+
+  //the nodes that comprise this graph (including any that have been
+  //removed from the source graph, so the indices are unchanged)
+  std::vector<node_type>  m_Nodes;
+
+  //every edge in the graph. The edges leaving node n are found at
+  //m_Edges[m_EdgeStart[n]] up to (but not including) m_Edges[m_EdgeStart[n+1]]
+  std::vector<edge_type>  m_Edges;
+  std::vector<int>        m_EdgeStart;
+
+  int                     m_iNumActiveNodes;
+
+  bool                    m_bDigraph;
+
+public:
+
+  //builds the graph from a copy of the given graph's nodes and edges
+  CSRGraph(const SourceGraph& graph);
+
+  //returns the node at the given index
+  const NodeType& GetNode(int idx)const
+  {
+    assert( (idx < (int)m_Nodes.size()) &&
+            (idx >=0)                   &&
+           "<CSRGraph::GetNode>: invalid index");
+
+    return m_Nodes[idx];
+  }
+
+  //returns the edge connecting from and to. The edge must exist
+  const EdgeType& GetEdge(int from, int to)const;
+
+  //returns the number of active + inactive nodes present in the graph
+  int   NumNodes()const{return m_Nodes.size();}
+
+  //returns the number of active nodes present in the graph
+  int   NumActiveNodes()const{return m_iNumActiveNodes;}
+
+  //returns the total number of edges present in the graph
+  int   NumEdges()const{return m_Edges.size();}
+
+  //returns the number of edges leaving the given node
+  int   NumEdges(int node)const{return m_EdgeStart[node+1] - m_EdgeStart[node];}
+
+  //returns true if the graph is directed
+  bool  isDigraph()const{return m_bDigraph;}
+
+  //returns true if the graph contains no nodes
+  bool  isEmpty()const{return m_Nodes.empty();}
+
+  //returns true if a node with the given index is present in the graph
+  bool  isNodePresent(int nd)const
+  {
+    return (nd >= 0) && (nd < (int)m_Nodes.size()) &&
+           (m_Nodes[nd].Index() != invalid_node_index);
+  }
+
+  //returns true if an edge connecting the nodes 'to' and 'from'
+  //is present in the graph
+  bool  isEdgePresent(int from, int to)const;
+
+
+  //const class used to iterate through all the edges connected to a
+  //specific node.
+  class ConstEdgeIterator
+  {
+  private:
+
+    const edge_type*  curEdge;
+    const edge_type*  lastEdge;
+
+  public:
+
+    ConstEdgeIterator(const CSRGraph<node_type, edge_type>& graph,
+                      int                                   node)
+    {
+      assert (node >= 0 && node < graph.NumNodes() &&
+              "<CSRGraph::ConstEdgeIterator>: invalid node index");
+
+      curEdge  = graph.m_Edges.empty() ? NULL : &graph.m_Edges[0] + graph.m_EdgeStart[node];
+      lastEdge = graph.m_Edges.empty() ? NULL : &graph.m_Edges[0] + graph.m_EdgeStart[node+1];
+    }
+
+    const EdgeType* begin()
+    {
+      if (end()) return NULL;
+
+      return curEdge;
+    }
+
+    const EdgeType* next()
+    {
+      ++curEdge;
+
+      if (end()) return NULL;
+
+      return curEdge;
+    }
+
+    //return true if we are at the end of the edge list
+    bool end()
+    {
+      return curEdge == lastEdge;
+    }
+  };
+
+  friend class ConstEdgeIterator;
+
+
+  //const class used to iterate through the nodes in the graph. Inactive
+  //nodes are skipped
+  class ConstNodeIterator
+  {
+  private:
+
+    const CSRGraph<node_type, edge_type>& G;
+
+    int                                   curNode;
+
+    void GetNextValidNode()
+    {
+      while (curNode < G.NumNodes() &&
+             G.m_Nodes[curNode].Index() == invalid_node_index)
+      {
+        ++curNode;
+      }
+    }
+
+  public:
+
+    ConstNodeIterator(const CSRGraph<node_type, edge_type>& graph):G(graph),
+                                                                   curNode(0)
+    {}
+
+    const node_type* begin()
+    {
+      curNode = 0;
+
+      GetNextValidNode();
+
+      if (end()) return NULL;
+
+      return &G.m_Nodes[curNode];
+    }
+
+    const node_type* next()
+    {
+      ++curNode;
+
+      GetNextValidNode();
+
+      if (end()) return NULL;
+
+      return &G.m_Nodes[curNode];
+    }
+
+    bool end()
+    {
+      return curNode >= G.NumNodes();
+    }
+  };
+
+  friend class ConstNodeIterator;
+};
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+template <class node_type, class edge_type>
+CSRGraph<node_type, edge_type>::CSRGraph(const SourceGraph& graph):m_iNumActiveNodes(0),
+                                                                   m_bDigraph(graph.isDigraph())
+{
+  const int NumNodes = graph.NumNodes();
+
+  m_Nodes.reserve(NumNodes);
+  m_Edges.reserve(graph.NumEdges());
+  m_EdgeStart.reserve(NumNodes+1);
+
+  for (int n=0; n<NumNodes; ++n)
+  {
+    m_Nodes.push_back(graph.GetNode(n));
+
+    m_EdgeStart.push_back(m_Edges.size());
+
+    //the edges of removed nodes are culled by SparseGraph so only the
+    //active nodes are given any
+    if (m_Nodes.back().Index() == invalid_node_index) continue;
+
+    ++m_iNumActiveNodes;
+
+    typename SourceGraph::ConstEdgeIterator EdgeItr(graph, n);
+    for (const edge_type* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+    {
+      m_Edges.push_back(*pE);
+    }
+  }
+
+  m_EdgeStart.push_back(m_Edges.size());
+}
+
+//---------------------------- isEdgePresent ----------------------------------
+//-----------------------------------------------------------------------------
+template <class node_type, class edge_type>
+bool CSRGraph<node_type, edge_type>::isEdgePresent(int from, int to)const
+{
+  if (!isNodePresent(from) || !isNodePresent(to)) return false;
+
+  for (int e=m_EdgeStart[from]; e<m_EdgeStart[from+1]; ++e)
+  {
+    if (m_Edges[e].To() == to) return true;
+  }
+
+  return false;
+}
+
+//------------------------------- GetEdge -------------------------------------
+//-----------------------------------------------------------------------------
+template <class node_type, class edge_type>
+const edge_type& CSRGraph<node_type, edge_type>::GetEdge(int from, int to)const
+{
+  assert (isNodePresent(from) && "<CSRGraph::GetEdge>: invalid 'from' index");
+  assert (isNodePresent(to)   && "<CSRGraph::GetEdge>: invalid 'to' index");
+
+  for (int e=m_EdgeStart[from]; e<m_EdgeStart[from+1]; ++e)
+  {
+    if (m_Edges[e].To() == to) return m_Edges[e];
+  }
+
+  assert (0 && "<CSRGraph::GetEdge>: edge does not exist");
+
+  return m_Edges[m_EdgeStart[from]];
+}
+
+
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef COMPRESSEDPATHTABLE_H
+#define COMPRESSEDPATHTABLE_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   CompressedPathTable.h
+//
+//  Desc:   a compressed lookup table of the next node on the shortest path
+//          from every node in a graph to every other. A shortest path is
+//          found by following the next nodes, without any search.
+//
+//          The first move of each path is stored as the position of its
+//          edge among the source node's edges. The nodes are ranked in
+//          depth first order so that nodes close to one another are also
+//          close in rank, and the paths from a source to nodes of
+//          consecutive rank mostly begin with the same move. Each row of
+//          the table therefore holds runs of targets sharing a first move,
+//          and a lookup is a binary search of one row.
+//
+//          The table is filled in a row at a time with SetRow (see
+//          CreateCompressedPathTable in HandyGraphFunctions.h). Different
+//          rows may be set from different threads at once.
+//
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "Graph/NodeTypeEnumerations.h"
+
+
+class CompressedPathTable
+{
+private:
+
+  //a run is held in one int. The rank of its first target is in the top 24
+  //bits and the move in the bottom 8
+  enum {move_bits = 8, no_move = 0xFF};
+
+  int                                       m_iNumNodes;
+
+  //a copy of the graph's edges. The move of an edge is its position in its
+  //source node's list
+  std::vector<int>                          m_NeighbourStart;
+  std::vector<int>                          m_Neighbours;
+
+  //the rank of each node (-1 if the node is not present) and the node of
+  //each rank
+  std::vector<int>                          m_Rank;
+  std::vector<int>                          m_Order;
+
+  //the runs of each source node, in rank order
+  std::vector<std::vector<unsigned int> >   m_Runs;
+
+public:
+
+  CompressedPathTable():m_iNumNodes(0){}
+
+  //discards any rows and sizes the table for the graph. The graph's edges
+  //are copied and its nodes ranked
+  template <class graph_type>
+  void        Reset(const graph_type& G);
+
+  //sets the paths from the given node to every other. NextNodes holds the
+  //next node on the path to each target or invalid_node_index if there is
+  //no path
+  inline void SetRow(int from, const std::vector<int>& NextNodes);
+
+  //returns the next node on the shortest path from one node to another.
+  //Returns invalid_node_index if there is no path
+  inline int  GetNextNode(int from, int to)const;
+
+  int         NumNodes()const{return m_iNumNodes;}
+
+  //returns the number of bytes used to hold the rows
+  inline size_t GetMemoryUsed()const;
+};
+
+
+//------------------------------- Reset -----------------------------------
+//-------------------------------------------------------------------------
+template <class graph_type>
+void CompressedPathTable::Reset(const graph_type& G)
+{
+  m_iNumNodes = G.NumNodes();
+
+  assert (m_iNumNodes < (1 << (32 - move_bits)) &&
+          "<CompressedPathTable::Reset>: too many nodes");
+
+  m_NeighbourStart.assign(1, 0);
+  m_Neighbours.clear();
+
+  for (int n=0; n<m_iNumNodes; ++n)
+  {
+    if (G.isNodePresent(n))
+    {
+      typename graph_type::ConstEdgeIterator EdgeItr(G, n);
+      for (const typename graph_type::EdgeType* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+      {
+        m_Neighbours.push_back(pE->To());
+      }
+    }
+
+    assert (m_Neighbours.size() - m_NeighbourStart.back() < no_move &&
+            "<CompressedPathTable::Reset>: a node has too many edges");
+
+    m_NeighbourStart.push_back(m_Neighbours.size());
+  }
+
+  //rank the nodes in depth first order, starting a new search from each
+  //node not yet reached
+  m_Rank.assign(m_iNumNodes, -1);
+  m_Order.clear();
+
+  std::vector<int> stack;
+
+  for (int root=0; root<m_iNumNodes; ++root)
+  {
+    if (!G.isNodePresent(root) || m_Rank[root] != -1) continue;
+
+    stack.push_back(root);
+
+    while (!stack.empty())
+    {
+      int nd = stack.back(); stack.pop_back();
+
+      if (m_Rank[nd] != -1) continue;
+
+      m_Rank[nd] = m_Order.size();
+      m_Order.push_back(nd);
+
+      //push the neighbours in reverse so the first is visited first
+      for (int i=m_NeighbourStart[nd+1]-1; i>=m_NeighbourStart[nd]; --i)
+      {
+        if (m_Rank[m_Neighbours[i]] == -1) stack.push_back(m_Neighbours[i]);
+      }
+    }
+  }
+
+  //swap with an empty vector to release the memory
+  std::vector<std::vector<unsigned int> >(m_iNumNodes).swap(m_Runs);
+}
+
+//------------------------------- SetRow ----------------------------------
+//-------------------------------------------------------------------------
+inline void CompressedPathTable::SetRow(int from, const std::vector<int>& NextNodes)
+{
+  assert (from >= 0 && from < m_iNumNodes && (int)NextNodes.size() == m_iNumNodes &&
+          "<CompressedPathTable::SetRow>: invalid row");
+
+  std::vector<unsigned int> runs;
+
+  unsigned int CurMove = no_move + 1;
+
+  for (unsigned int rank=0; rank<m_Order.size(); ++rank)
+  {
+    int target = m_Order[rank];
+
+    //the path from a node to itself is never looked up so it joins
+    //whichever run it falls in
+    if (target == from) continue;
+
+    unsigned int move = no_move;
+
+    if (NextNodes[target] != invalid_node_index)
+    {
+      move = 0;
+
+      while (m_Neighbours[m_NeighbourStart[from] + move] != NextNodes[target]) ++move;
+    }
+
+    if (move != CurMove)
+    {
+      //the first run always starts at rank zero
+      unsigned int start = runs.empty() ? 0 : rank;
+
+      runs.push_back((start << move_bits) | move);
+
+      CurMove = move;
+    }
+  }
+
+  m_Runs[from].swap(runs);
+}
+
+//---------------------------- GetNextNode --------------------------------
+//-------------------------------------------------------------------------
+inline int CompressedPathTable::GetNextNode(int from, int to)const
+{
+  assert (m_Rank[from] != -1 && m_Rank[to] != -1 &&
+          "<CompressedPathTable::GetNextNode>: invalid node");
+
+  if (from == to) return to;
+
+  const std::vector<unsigned int>& runs = m_Runs[from];
+
+  //find the last run starting at or before the target's rank
+  unsigned int key = ((unsigned int)m_Rank[to] << move_bits) | no_move;
+
+  std::vector<unsigned int>::const_iterator run = std::upper_bound(runs.begin(),
+                                                                   runs.end(),
+                                                                   key);
+  --run;
+
+  unsigned int move = *run & no_move;
+
+  if (move == no_move) return invalid_node_index;
+
+  return m_Neighbours[m_NeighbourStart[from] + move];
+}
+
+//--------------------------- GetMemoryUsed -------------------------------
+//-------------------------------------------------------------------------
+inline size_t CompressedPathTable::GetMemoryUsed()const
+{
+  size_t bytes = 0;
+
+  for (unsigned int r=0; r<m_Runs.size(); ++r)
+  {
+    bytes += m_Runs[r].size() * sizeof(unsigned int);
+  }
+
+  return bytes;
+}
+
+
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   DistanceField.h
+//
+//  Desc:   records, for every node of a graph, the cost of the cheapest path
+//          to the closest of a set of 'source' nodes and the next node along
+//          that path. Once built, the cost from any node to the closest
+//          source is a lookup and the path to it is found by following the
+//          next nodes.
+//
+//          Sources may be added and removed at any time. Adding a source
+//          only revisits the nodes that are now closer to it than to any
+//          other. Removing one only revisits the nodes that were closest to
+//          it.
+//
+//          The graph must be undirected (the paths are found by searching
+//          outwards from the sources) and must not change once the field
+//          has been built.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <cassert>
+
+#include "misc/utils.h"
+#include "misc/PriorityQueue.h"
+
+
+template <class graph_type>
+class DistanceField
+{
+public:
+
+  typedef typename graph_type::EdgeType  EdgeType;
+
+private:
+
+  const graph_type&             m_Graph;
+
+  //indexed by node. The cost to the closest source (MaxDouble if no source
+  //can be reached), the next node on the path to it (-1 at a source) and
+  //the source itself (-1 if none)
+  std::vector<double>           m_Costs;
+  std::vector<int>              m_NextNode;
+  std::vector<int>              m_ClosestSource;
+
+  std::vector<bool>             m_bSource;
+
+  //the nodes whose costs have been lowered but whose neighbours have not
+  //yet been updated. Keyed on m_Costs
+  IndexedPriorityQLow<double>*  m_pPQ;
+  std::vector<bool>             m_bQueued;
+
+  int                           m_iNumSources;
+
+  //lowers the cost of a node if the given cost is cheaper
+  void Relax(int node, double cost, int NextNode, int source);
+
+  //updates the nodes around those queued until the queue is empty
+  void Propagate();
+
+  DistanceField(const DistanceField&);
+  DistanceField& operator=(const DistanceField&);
+
+public:
+
+  DistanceField(const graph_type& G);
+
+  ~DistanceField(){delete m_pPQ;}
+
+  void    AddSource(int node);
+  void    RemoveSource(int node);
+
+  bool    isSource(int node)const{return m_bSource[node];}
+  int     NumSources()const{return m_iNumSources;}
+
+  //returns the cost of the cheapest path from the node to the closest
+  //source or MaxDouble if there is no path to any source
+  double  Cost(int node)const{return m_Costs[node];}
+
+  //returns the next node on the path to the closest source. (-1 at a source
+  //or if there is no path)
+  int     NextNode(int node)const{return m_NextNode[node];}
+
+  int     ClosestSource(int node)const{return m_ClosestSource[node];}
+
+  //fills path with the edges from the node to the closest source. Returns
+  //false if there is no path to any source
+  bool    GetPathToClosestSource(int node, std::vector<const EdgeType*>& path)const;
+};
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+DistanceField<graph_type>::DistanceField(const graph_type& G):m_Graph(G),
+                                                              m_Costs(G.NumNodes(), MaxDouble),
+                                                              m_NextNode(G.NumNodes(), -1),
+                                                              m_ClosestSource(G.NumNodes(), -1),
+                                                              m_bSource(G.NumNodes(), false),
+                                                              m_bQueued(G.NumNodes(), false),
+                                                              m_iNumSources(0)
+{
+  assert (!G.isDigraph() && "<DistanceField::ctor>: the graph must be undirected");
+
+  m_pPQ = new IndexedPriorityQLow<double>(m_Costs, G.NumNodes());
+}
+
+//-------------------------------- Relax --------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void DistanceField<graph_type>::Relax(int node, double cost, int NextNode, int source)
+{
+  if (cost >= m_Costs[node]) return;
+
+  m_Costs[node]         = cost;
+  m_NextNode[node]      = NextNode;
+  m_ClosestSource[node] = source;
+
+  if (m_bQueued[node])
+  {
+    m_pPQ->ChangePriority(node);
+  }
+  else
+  {
+    m_bQueued[node] = true;
+
+    m_pPQ->insert(node);
+  }
+}
+
+//------------------------------ Propagate ------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void DistanceField<graph_type>::Propagate()
+{
+  while (!m_pPQ->empty())
+  {
+    int node = m_pPQ->Pop();
+
+    m_bQueued[node] = false;
+
+    typename graph_type::ConstEdgeIterator EdgeItr(m_Graph, node);
+    for (const EdgeType* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+    {
+      Relax(pE->To(), m_Costs[node] + pE->Cost(), node, m_ClosestSource[node]);
+    }
+  }
+}
+
+//------------------------------ AddSource ------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void DistanceField<graph_type>::AddSource(int node)
+{
+  if (m_bSource[node]) return;
+
+  m_bSource[node] = true;
+
+  ++m_iNumSources;
+
+  //a node may already be closest to itself at zero cost if it shares its
+  //position with a source
+  m_Costs[node] = MaxDouble;
+
+  Relax(node, 0.0, -1, node);
+
+  Propagate();
+}
+
+//----------------------------- RemoveSource ----------------------------------
+//
+//  the nodes that were closest to the source are reset and then given the
+//  cheapest cost offered by any neighbour that was not. The costs are then
+//  propagated from those nodes as usual
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void DistanceField<graph_type>::RemoveSource(int source)
+{
+  if (!m_bSource[source]) return;
+
+  m_bSource[source] = false;
+
+  --m_iNumSources;
+
+  std::vector<int> orphans;
+
+  for (unsigned int n=0; n<m_ClosestSource.size(); ++n)
+  {
+    if (m_ClosestSource[n] != source) continue;
+
+    orphans.push_back(n);
+
+    m_Costs[n]         = MaxDouble;
+    m_NextNode[n]      = -1;
+    m_ClosestSource[n] = -1;
+  }
+
+  for (unsigned int i=0; i<orphans.size(); ++i)
+  {
+    int node = orphans[i];
+
+    typename graph_type::ConstEdgeIterator EdgeItr(m_Graph, node);
+    for (const EdgeType* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+    {
+      int neighbour = pE->To();
+
+      if (m_ClosestSource[neighbour] == -1) continue;
+
+      Relax(node, m_Costs[neighbour] + pE->Cost(), neighbour, m_ClosestSource[neighbour]);
+    }
+  }
+
+  Propagate();
+}
+
+//------------------------ GetPathToClosestSource -----------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+bool DistanceField<graph_type>::GetPathToClosestSource(int                           node,
+                                                       std::vector<const EdgeType*>& path)const
+{
+  path.clear();
+
+  if (m_ClosestSource[node] == -1) return false;
+
+  for (; m_NextNode[node] != -1; node = m_NextNode[node])
+  {
+    path.push_back(&m_Graph.GetEdge(node, m_NextNode[node]));
+  }
+
+  return true;
+}
+
+
+
+
+#endif
@@ -21,7 +21,7 @@
 #include <queue>
 #include <stack>
 
-#include "graph/SparseGraph.h"
+#include "Graph/SparseGraph.h"
 #include "misc/PriorityQueue.h"
 
 
@@ -142,7 +142,7 @@ bool Graph_SearchDFS<graph_type>::Search()
     //push the edges leading from the node this edge points to onto
     //the stack (provided the edge does not point to a previously 
     //visited node)
-    graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, Next->To());
+    typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, Next->To());
 
     for (const Edge* pE=ConstEdgeItr.begin();
         !ConstEdgeItr.end();
@@ -297,7 +297,7 @@ bool Graph_SearchBFS<graph_type>::Search()
 
     //push the edges leading from the node at the end of this edge 
     //onto the queue
-    graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, Next->To());
+    typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, Next->To());
 
     for (const Edge* pE=ConstEdgeItr.begin();
         !ConstEdgeItr.end();
@@ -453,7 +453,7 @@ void Graph_SearchDijkstra<graph_type>::Search()
     if (NextClosestNode == m_iTarget) return;
 
     //now to relax the edges.
-    graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
+    typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
 
     //for each edge connected to the next closest node
     for (const Edge* pE=ConstEdgeItr.begin();
@@ -552,6 +552,8 @@ private:
   int                            m_iSource;
   int                            m_iTarget;
 
+  heuristic                      m_Heuristic;
+
   //the A* search algorithm
   void Search();
 
@@ -559,13 +561,15 @@ public:
 
   Graph_SearchAStar(graph_type &graph,
                     int   source,
-                    int   target):m_Graph(graph),
+                    int   target,
+                    const heuristic& h = heuristic()):m_Graph(graph),
                                   m_ShortestPathTree(graph.NumNodes()),                              
                                   m_SearchFrontier(graph.NumNodes()),
                                   m_GCosts(graph.NumNodes(), 0.0),
                                   m_FCosts(graph.NumNodes(), 0.0),
                                   m_iSource(source),
-                                  m_iTarget(target)
+                                  m_iTarget(target),
+                                  m_Heuristic(h)
   {
     Search();   
   }
@@ -605,14 +609,14 @@ void Graph_SearchAStar<graph_type, heuristic>::Search()
     if (NextClosestNode == m_iTarget) return;
 
     //now to test all the edges attached to this node
-    graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
+    typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, NextClosestNode);
 
     for (const Edge* pE=ConstEdgeItr.begin();
         !ConstEdgeItr.end(); 
          pE=ConstEdgeItr.next())
     {
       //calculate the heuristic cost from this node to the target (H)                       
-      double HCost = heuristic::Calculate(m_Graph, m_iTarget, pE->To()); 
+      double HCost = m_Heuristic.Calculate(m_Graph, m_iTarget, pE->To()); 
 
       //calculate the 'real' cost to this node from the source (G)
       double GCost = m_GCosts[NextClosestNode] + pE->Cost();
@@ -711,7 +715,7 @@ private:
       m_SpanningTree[best] = m_Fringe[best];
 
       //now to test the edges attached to this node
-      graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, best);
+      typename graph_type::ConstEdgeIterator ConstEdgeItr(m_Graph, best);
 
       for (const Edge* pE=ConstEdgeItr.beg(); !ConstEdgeItr.end(); pE=ConstEdgeItr.nxt())
       {
@@ -0,0 +1,154 @@
+#ifndef GRAPHLANDMARKS_H
+#define GRAPHLANDMARKS_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   GraphLandmarks.h
+//
+//  Desc:   a table of the costs from a few 'landmark' nodes to every node
+//          of a graph. By the triangle inequality the cost of the cheapest
+//          path between any two nodes is at least the difference of their
+//          costs from a landmark, which makes a far tighter lower bound than
+//          the straight line distance on maps with long walls (see
+//          Heuristic_Landmarks in AStarHeuristicPolicies.h).
+//
+//          The landmarks are chosen to be spread out. Each is the node
+//          furthest from those already chosen, nodes that cannot reach any
+//          of them first.
+//
+//          The graph must be undirected and must not change once the table
+//          has been created.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <cassert>
+
+#include "misc/utils.h"
+#include "Graph/DistanceField.h"
+#include "Graph/NodeTypeEnumerations.h"
+
+
+class GraphLandmarks
+{
+private:
+
+  int                  m_iNumNodes;
+
+  std::vector<int>     m_Landmarks;
+
+  //the cost from each landmark to each node, indexed by node first so the
+  //costs of a node are adjacent. (MaxDouble if the node cannot be reached)
+  std::vector<double>  m_Costs;
+
+  int                  m_iNumLandmarks;
+
+public:
+
+  template <class graph_type>
+  GraphLandmarks(const graph_type& G, int NumLandmarks);
+
+  int    NumLandmarks()const{return m_iNumLandmarks;}
+  int    Landmark(int i)const{return m_Landmarks[i];}
+
+  double Cost(int landmark, int node)const
+  {
+    return m_Costs[node*m_iNumLandmarks + landmark];
+  }
+
+  //returns a lower bound on the cost of the cheapest path between the two
+  //nodes
+  double LowerBound(int nd1, int nd2)const
+  {
+    const double* c1 = &m_Costs[nd1*m_iNumLandmarks];
+    const double* c2 = &m_Costs[nd2*m_iNumLandmarks];
+
+    double bound = 0;
+
+    for (int l=0; l<m_iNumLandmarks; ++l)
+    {
+      //skip landmarks that cannot reach both nodes
+      if (c1[l] == MaxDouble || c2[l] == MaxDouble) continue;
+
+      double diff = c1[l] > c2[l] ? c1[l] - c2[l] : c2[l] - c1[l];
+
+      if (diff > bound) bound = diff;
+    }
+
+    return bound;
+  }
+};
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+GraphLandmarks::GraphLandmarks(const graph_type& G,
+                               int               NumLandmarks):m_iNumNodes(G.NumNodes()),
+                                                               m_iNumLandmarks(0)
+{
+  assert (!G.isDigraph() && "<GraphLandmarks::ctor>: the graph must be undirected");
+
+  //the costs from the landmarks chosen so far to their closest node
+  DistanceField<graph_type> chosen(G);
+
+  //the search for the first landmark starts from the first node
+  int start = invalid_node_index;
+
+  for (int n=0; n<m_iNumNodes && start == invalid_node_index; ++n)
+  {
+    if (G.isNodePresent(n)) start = n;
+  }
+
+  if (start == invalid_node_index) return;
+
+  chosen.AddSource(start);
+
+  std::vector<int> landmarks;
+
+  while ((int)landmarks.size() < NumLandmarks)
+  {
+    //find the node furthest from the chosen landmarks. Unreachable nodes
+    //have a cost of MaxDouble so they are chosen first
+    int    furthest = invalid_node_index;
+    double cost     = 0;
+
+    for (int n=0; n<m_iNumNodes; ++n)
+    {
+      if (G.isNodePresent(n) && chosen.Cost(n) > cost)
+      {
+        furthest = n;
+        cost     = chosen.Cost(n);
+      }
+    }
+
+    //every node is a landmark
+    if (furthest == invalid_node_index) break;
+
+    //the start node only served to find the first landmark
+    if (landmarks.empty()) chosen.RemoveSource(start);
+
+    chosen.AddSource(furthest);
+
+    landmarks.push_back(furthest);
+  }
+
+  m_Landmarks     = landmarks;
+  m_iNumLandmarks = landmarks.size();
+
+  m_Costs.assign(m_iNumNodes * m_iNumLandmarks, MaxDouble);
+
+  for (int l=0; l<m_iNumLandmarks; ++l)
+  {
+    DistanceField<graph_type> field(G);
+
+    field.AddSource(m_Landmarks[l]);
+
+    for (int n=0; n<m_iNumNodes; ++n)
+    {
+      m_Costs[n*m_iNumLandmarks + l] = field.Cost(n);
+    }
+  }
+}
+
+
+
+#endif
@@ -12,7 +12,7 @@
 #include <ostream>
 #include <fstream>
 #include "2D/Vector2D.h"
-#include "graph/NodeTypeEnumerations.h"
+#include "Graph/NodeTypeEnumerations.h"
 
 
 
@@ -94,6 +94,10 @@ public:
   Vector2D   Pos()const{return m_vPosition;}
   void       SetPos(Vector2D NewPosition){m_vPosition = NewPosition;}
 
+  //a node is a point, so has no bounding radius (lets nodes be kept in a
+  //CellSpacePartition)
+  double     BRadius()const{return 0.0;}
+
   extra_info ExtraInfo()const{return m_ExtraInfo;}
   void       SetExtraInfo(extra_info info){m_ExtraInfo = info;}
 
@@ -13,12 +13,16 @@
 //          with the SparseGraph class
 //-----------------------------------------------------------------------------
 #include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 #include "misc/Cgdi.h"
 #include "misc/utils.h"
 #include "misc/Stream_Utility_Functions.h"
 #include "Graph/GraphAlgorithms.h"
 #include "Graph/AStarHeuristicPolicies.h"
+#include "Graph/CompressedPathTable.h"
 
 
 
@@ -65,7 +69,7 @@ void GraphHelper_AddAllNeighboursToGridNode(graph_type& graph,
         double dist = PosNode.Distance(PosNeighbour);
 
         //this neighbour is okay so it can be added
-        graph_type::EdgeType NewEdge(row*NumCellsX+col,
+        typename graph_type::EdgeType NewEdge(row*NumCellsX+col,
                                      nodeY*NumCellsX+nodeX,
                                      dist);
         graph.AddEdge(NewEdge);
@@ -74,7 +78,7 @@ void GraphHelper_AddAllNeighboursToGridNode(graph_type& graph,
         //in the other direction
         if (!graph.isDigraph())
         {
-          graph_type::EdgeType NewEdge(nodeY*NumCellsX+nodeX,
+          typename graph_type::EdgeType NewEdge(nodeY*NumCellsX+nodeX,
                                        row*NumCellsX+col,
                                        dist);
           graph.AddEdge(NewEdge);
@@ -144,8 +148,8 @@ void GraphHelper_DrawUsingGDI(const graph_type& graph, int color, bool DrawNodeI
   gdi->SetPenColor(color);
 
   //draw the nodes 
-  graph_type::ConstNodeIterator NodeItr(graph);
-  for (const graph_type::NodeType* pN=NodeItr.begin();
+  typename graph_type::ConstNodeIterator NodeItr(graph);
+  for (const typename graph_type::NodeType* pN=NodeItr.begin();
       !NodeItr.end();
        pN=NodeItr.next())
   {
@@ -157,8 +161,8 @@ void GraphHelper_DrawUsingGDI(const graph_type& graph, int color, bool DrawNodeI
       gdi->TextAtPos((int)pN->Pos().x+5, (int)pN->Pos().y-5, ttos(pN->Index()));
     }
 
-    graph_type::ConstEdgeIterator EdgeItr(graph, pN->Index());
-    for (const graph_type::EdgeType* pE=EdgeItr.begin();
+    typename graph_type::ConstEdgeIterator EdgeItr(graph, pN->Index());
+    for (const typename graph_type::EdgeType* pE=EdgeItr.begin();
         !EdgeItr.end();
         pE=EdgeItr.next())
     {
@@ -181,8 +185,8 @@ void WeightNavGraphNodeEdges(graph_type& graph, int node, double weight)
   assert(node < graph.NumNodes());
 
   //set the cost for each edge
-  graph_type::ConstEdgeIterator ConstEdgeItr(graph, node);
-  for (const graph_type::EdgeType* pE=ConstEdgeItr.begin();
+  typename graph_type::ConstEdgeIterator ConstEdgeItr(graph, node);
+  for (const typename graph_type::EdgeType* pE=ConstEdgeItr.begin();
        !ConstEdgeItr.end();
        pE=ConstEdgeItr.next())
   {
@@ -221,7 +225,7 @@ std::vector<std::vector<int> > CreateAllPairsTable(const graph_type& G)
     //calculate the SPT for this node
     Graph_SearchDijkstra<graph_type> search(G, source);
 
-    std::vector<const graph_type::EdgeType*> spt = search.GetSPT();
+    std::vector<const typename graph_type::EdgeType*> spt = search.GetSPT();
 
     //now we have the SPT it's easy to work backwards through it to find
     //the shortest paths from each node to this source node
@@ -251,6 +255,31 @@ std::vector<std::vector<int> > CreateAllPairsTable(const graph_type& G)
 }
 
 
+//------------------------- FillAllPairsCostsRow -----------------------------
+//
+//  fills in the row of the all pairs costs table for the given source node
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void FillAllPairsCostsRow(const graph_type& G, int source, std::vector<double>& row)
+{
+  //do the search
+  Graph_SearchDijkstra<graph_type> search(G, source);
+
+  //iterate through every node in the graph and grab the cost to travel to
+  //that node
+  for (int target = 0; target<G.NumNodes(); ++target)
+  {
+    if (source != target)
+    {
+      row[target]= search.GetCostToNode(target);
+    }
+    else
+    {
+      row[target] = 0.0;
+    }
+  }//next target node
+}
+
 //----------------------- CreateAllPairsCostsTable -------------------------------
 //
 //  creates a lookup table of the cost associated from traveling from one
@@ -265,24 +294,219 @@ std::vector<std::vector<double> > CreateAllPairsCostsTable(const graph_type& G)
 
   for (int source=0; source<G.NumNodes(); ++source)
   {
-    //do the search
-    Graph_SearchDijkstra<graph_type> search(G, source);
-
-    //iterate through every node in the graph and grab the cost to travel to
-    //that node
-    for (int target = 0; target<G.NumNodes(); ++target)
-    {
-      if (source != target)
-      {
-        PathCosts[source][target]= search.GetCostToNode(target);
-      }
-    }//next target node
+    FillAllPairsCostsRow(G, source, PathCosts[source]);
     
   }//next source node
 
   return PathCosts;
 }
 
+//------------------------ AllPairsCostsWorker --------------------------------
+//
+//  used by the multithreaded version of CreateAllPairsCostsTable. Each worker
+//  repeatedly takes the next source node that has not been searched from and
+//  fills in its row of the table until there are none left
+//-----------------------------------------------------------------------------
+template <class graph_type, class table_type>
+void AllPairsCostsWorker(const graph_type*  G,
+                         table_type*        PathCosts,
+                         std::atomic<int>*  NextSource)
+{
+  std::vector<double> row(G->NumNodes(), 0.0);
+
+  for (int source = (*NextSource)++; source < G->NumNodes(); source = (*NextSource)++)
+  {
+    FillAllPairsCostsRow(*G, source, row);
+
+    PathCosts->SetRow(source, row);
+  }
+}
+
+//----------------------- CreateAllPairsCostsTable -------------------------------
+//
+//  as above but the table is filled in a row at a time by calling its SetRow
+//  method (see PathCostTable.h) and the searches are shared between
+//  NumThreads threads. (each search only reads the graph and sets its own row
+//  of the table)
+//-----------------------------------------------------------------------------
+template <class graph_type, class table_type>
+void CreateAllPairsCostsTable(const graph_type& G,
+                              table_type&       PathCosts,
+                              int               NumThreads)
+{
+  std::atomic<int> NextSource(0);
+
+  //the calling thread does its share of the work too
+  std::vector<std::thread> workers;
+
+  for (int t=1; t<NumThreads; ++t)
+  {
+    workers.push_back(std::thread(AllPairsCostsWorker<graph_type, table_type>,
+                                  &G, &PathCosts, &NextSource));
+  }
+
+  AllPairsCostsWorker(&G, &PathCosts, &NextSource);
+
+  for (unsigned int t=0; t<workers.size(); ++t)
+  {
+    workers[t].join();
+  }
+}
+
+//--------------------------- FillNextNodesRow -------------------------------
+//
+//  fills in the next node on the shortest path from the given source node
+//  to every other (invalid_node_index if there is no path)
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void FillNextNodesRow(const graph_type& G, int source, std::vector<int>& row)
+{
+  const int unknown = invalid_node_index - 1;
+
+  Graph_SearchDijkstra<graph_type> search(G, source);
+
+  std::vector<const typename graph_type::EdgeType*> spt = search.GetSPT();
+
+  row.assign(G.NumNodes(), unknown);
+
+  row[source] = source;
+
+  std::vector<int> chain;
+
+  for (int target=0; target<G.NumNodes(); ++target)
+  {
+    //work back through the SPT until a node whose next node is known, or
+    //the node reached directly from the source, is found
+    int nd = target;
+
+    chain.clear();
+
+    while (row[nd] == unknown && spt[nd] && spt[nd]->From() != source)
+    {
+      chain.push_back(nd);
+
+      nd = spt[nd]->From();
+    }
+
+    if (row[nd] == unknown)
+    {
+      row[nd] = spt[nd] ? nd : invalid_node_index;
+    }
+
+    //every node on the way shares the same next node
+    for (unsigned int i=0; i<chain.size(); ++i)
+    {
+      row[chain[i]] = row[nd];
+    }
+  }//next target node
+}
+
+//------------------------ CompressedPathTableWorker --------------------------
+//
+//  used by CreateCompressedPathTable. Each worker repeatedly takes the next
+//  source node that has not been searched from and sets its row of the table
+//  until there are none left
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void CompressedPathTableWorker(const graph_type*     G,
+                               CompressedPathTable*  table,
+                               std::atomic<int>*     NextSource)
+{
+  std::vector<int> row;
+
+  for (int source = (*NextSource)++; source < G->NumNodes(); source = (*NextSource)++)
+  {
+    if (!G->isNodePresent(source)) continue;
+
+    FillNextNodesRow(*G, source, row);
+
+    table->SetRow(source, row);
+  }
+}
+
+//----------------------- CreateCompressedPathTable ---------------------------
+//
+//  creates the compressed lookup table of the next node on the shortest path
+//  from each node to every other (see CompressedPathTable.h). The searches
+//  are shared between NumThreads threads
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void CreateCompressedPathTable(const graph_type&    G,
+                               CompressedPathTable& table,
+                               int                  NumThreads)
+{
+  table.Reset(G);
+
+  std::atomic<int> NextSource(0);
+
+  //the calling thread does its share of the work too
+  std::vector<std::thread> workers;
+
+  for (int t=1; t<NumThreads; ++t)
+  {
+    workers.push_back(std::thread(CompressedPathTableWorker<graph_type>,
+                                  &G, &table, &NextSource));
+  }
+
+  CompressedPathTableWorker(&G, &table, &NextSource);
+
+  for (unsigned int t=0; t<workers.size(); ++t)
+  {
+    workers[t].join();
+  }
+}
+
+//--------------------------- CalculateGraphHash ------------------------------
+//
+//  returns a 64 bit FNV-1a hash of the graph's nodes (index and position)
+//  and edges (end points and cost). Any change to the graph that could alter
+//  the cost of a path will, in all likelihood, change the hash
+//-----------------------------------------------------------------------------
+inline void HashBytes(unsigned long long& hash, const void* data, unsigned int size)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+  for (unsigned int b=0; b<size; ++b)
+  {
+    hash ^= bytes[b];
+    hash *= 1099511628211ULL;
+  }
+}
+
+template <class graph_type>
+unsigned long long CalculateGraphHash(const graph_type& G)
+{
+  unsigned long long hash = 14695981039346656037ULL;
+
+  int NumNodes = G.NumNodes();
+  HashBytes(hash, &NumNodes, sizeof(NumNodes));
+
+  typename graph_type::ConstNodeIterator NodeItr(G);
+  for (const typename graph_type::NodeType* pN = NodeItr.begin(); !NodeItr.end(); pN=NodeItr.next())
+  {
+    int      index = pN->Index();
+    Vector2D pos   = pN->Pos();
+
+    HashBytes(hash, &index, sizeof(index));
+    HashBytes(hash, &pos.x, sizeof(pos.x));
+    HashBytes(hash, &pos.y, sizeof(pos.y));
+
+    typename graph_type::ConstEdgeIterator EdgeItr(G, pN->Index());
+    for (const typename graph_type::EdgeType* pE = EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+    {
+      int    from = pE->From();
+      int    to   = pE->To();
+      double cost = pE->Cost();
+
+      HashBytes(hash, &from, sizeof(from));
+      HashBytes(hash, &to,   sizeof(to));
+      HashBytes(hash, &cost, sizeof(cost));
+    }
+  }
+
+  return hash;
+}
+
 //---------------------- CalculateAverageGraphEdgeLength ----------------------
 //
 //  determines the average length of the edges in a navgraph (using the 
@@ -296,12 +520,12 @@ double CalculateAverageGraphEdgeLength(const graph_type& G)
   double TotalLength = 0;
   int NumEdgesCounted = 0;
 
-  graph_type::ConstNodeIterator NodeItr(G);
-  const graph_type::NodeType* pN;
+  typename graph_type::ConstNodeIterator NodeItr(G);
+  const typename graph_type::NodeType* pN;
   for (pN = NodeItr.begin(); !NodeItr.end(); pN=NodeItr.next())
   {
-    graph_type::ConstEdgeIterator EdgeItr(G, pN->Index());
-    for (const graph_type::EdgeType* pE = EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+    typename graph_type::ConstEdgeIterator EdgeItr(G, pN->Index());
+    for (const typename graph_type::EdgeType* pE = EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
     {
       //increment edge counter
       ++NumEdgesCounted;
@@ -323,12 +547,12 @@ double GetCostliestGraphEdge(const graph_type& G)
 {
   double greatest = MinDouble;
 
-  graph_type::ConstNodeIterator NodeItr(G);
-  const graph_type::NodeType* pN;
+  typename graph_type::ConstNodeIterator NodeItr(G);
+  const typename graph_type::NodeType* pN;
   for (pN = NodeItr.begin(); !NodeItr.end(); pN=NodeItr.next())
   {
-    graph_type::ConstEdgeIterator EdgeItr(G, pN->Index());
-    for (const graph_type::EdgeType* pE = EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+    typename graph_type::ConstEdgeIterator EdgeItr(G, pN->Index());
+    for (const typename graph_type::EdgeType* pE = EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
     {
       if (pE->Cost() > greatest)greatest = pE->Cost();
     }
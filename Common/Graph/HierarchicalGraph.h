@@ -0,0 +1,402 @@
+#ifndef HIERARCHICALGRAPH_H
+#define HIERARCHICALGRAPH_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   HierarchicalGraph.h
+//
+//  Desc:   a two level abstraction of a navigation graph for hierarchical
+//          path planning (HPA*).
+//
+//          The nodes of the graph are grouped into clusters by laying a grid
+//          of square cells over them. Any node with an edge to a node in
+//          another cluster is an 'entrance'. The entrances are the nodes of
+//          the abstract graph, which has two kinds of edge:
+//
+//            - the edges of the source graph joining entrances in different
+//              clusters
+//
+//            - an edge between each pair of entrances in the same cluster
+//              that can reach one another without leaving it, costed with
+//              the shortest such path
+//
+//          A search of the abstract graph is then a search over a few
+//          entrances per cluster rather than over every node, and the
+//          resulting coarse path can be turned into a path through the
+//          source graph one cluster at a time with FindPathInCluster.
+//
+//          The graph must be undirected and must not change once the
+//          hierarchy has been built.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "misc/utils.h"
+#include "misc/PriorityQueue.h"
+#include "2D/Vector2D.h"
+
+
+template <class graph_type>
+class HierarchicalGraph
+{
+public:
+
+  typedef typename graph_type::EdgeType  EdgeType;
+
+  //an edge of the abstract graph
+  struct AbstractEdge
+  {
+    //the entrance it leads to
+    int     iTo;
+
+    double  dCost;
+  };
+
+private:
+
+  const graph_type&          m_Graph;
+
+  //the clusters are the cells of a grid with its origin at the top left
+  //of the nodes' bounding box
+  double                     m_dClusterSize;
+  Vector2D                   m_vOrigin;
+  int                        m_iNumClustersX;
+  int                        m_iNumClustersY;
+
+  //indexed by node. The cluster the node is in (-1 for removed nodes) and
+  //its position in the cluster's node list
+  std::vector<int>           m_NodeCluster;
+  std::vector<int>           m_LocalIndex;
+
+  //the nodes of cluster c are m_ClusterNodes[m_ClusterStart[c]] up to (but
+  //not including) m_ClusterNodes[m_ClusterStart[c+1]]
+  std::vector<int>           m_ClusterStart;
+  std::vector<int>           m_ClusterNodes;
+
+  //the entrances are numbered cluster by cluster, so the entrances of
+  //cluster c are numbered m_EntranceStart[c] to m_EntranceStart[c+1]-1
+  std::vector<int>           m_EntranceStart;
+  std::vector<int>           m_EntranceNode;
+
+  //indexed by node. The node's entrance number or -1
+  std::vector<int>           m_EntranceIndex;
+
+  //the abstract graph's edges, stored like those of a CSRGraph
+  std::vector<int>           m_AbstractEdgeStart;
+  std::vector<AbstractEdge>  m_AbstractEdges;
+
+  int  CalculateCluster(Vector2D pos)const;
+
+  HierarchicalGraph(const HierarchicalGraph&);
+  HierarchicalGraph& operator=(const HierarchicalGraph&);
+
+public:
+
+  HierarchicalGraph(const graph_type& G, double ClusterSize);
+
+  const graph_type&    GetGraph()const{return m_Graph;}
+
+  int                  NumClusters()const{return m_ClusterStart.size() - 1;}
+
+  //returns the cluster the node is in
+  int                  Cluster(int node)const{return m_NodeCluster[node];}
+
+  int                  NumNodesInCluster(int cluster)const
+  {
+    return m_ClusterStart[cluster+1] - m_ClusterStart[cluster];
+  }
+
+  int                  NumEntrances()const{return m_EntranceNode.size();}
+
+  //the entrances of a cluster are numbered consecutively from FirstEntrance
+  int                  FirstEntrance(int cluster)const{return m_EntranceStart[cluster];}
+  int                  NumEntrances(int cluster)const
+  {
+    return m_EntranceStart[cluster+1] - m_EntranceStart[cluster];
+  }
+
+  //converts between entrance numbers and node indices. EntranceIndex
+  //returns -1 if the node is not an entrance
+  int                  EntranceNode(int entrance)const{return m_EntranceNode[entrance];}
+  int                  EntranceIndex(int node)const{return m_EntranceIndex[node];}
+
+  int                  NumAbstractEdges()const{return m_AbstractEdges.size();}
+
+  //the abstract edges leaving an entrance lie between these two pointers
+  const AbstractEdge*  AbstractEdgesBegin(int entrance)const
+  {
+    return &m_AbstractEdges[0] + m_AbstractEdgeStart[entrance];
+  }
+
+  const AbstractEdge*  AbstractEdgesEnd(int entrance)const
+  {
+    return &m_AbstractEdges[0] + m_AbstractEdgeStart[entrance+1];
+  }
+
+  //runs Dijkstra's algorithm from source over the nodes of its cluster only,
+  //stopping early if target (if not -1) is reached. On return Costs and SPT
+  //hold the cost of the cheapest path to, and the last edge of that path
+  //to, each node of the cluster, indexed by the node's position in the
+  //cluster (see GetClusterCost). Unreached nodes cost MaxDouble
+  void  SearchCluster(int                           source,
+                      int                           target,
+                      std::vector<double>&          Costs,
+                      std::vector<const EdgeType*>& SPT)const;
+
+  //looks up a node's entry in the results of SearchCluster
+  double GetClusterCost(const std::vector<double>& Costs, int node)const
+  {
+    return Costs[m_LocalIndex[node]];
+  }
+
+  //fills path with the edges of the cheapest path from 'from' to 'to' that
+  //stays within their cluster. Returns false if there is no such path
+  bool  FindPathInCluster(int from, int to, std::vector<const EdgeType*>& path)const;
+};
+
+
+//------------------------------- ctor ----------------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+HierarchicalGraph<graph_type>::HierarchicalGraph(const graph_type& G,
+                                                 double            ClusterSize):m_Graph(G),
+                                                                                m_dClusterSize(ClusterSize),
+                                                                                m_iNumClustersX(1),
+                                                                                m_iNumClustersY(1)
+{
+  assert (!G.isDigraph() && "<HierarchicalGraph::ctor>: the graph must be undirected");
+  assert (ClusterSize > 0 && "<HierarchicalGraph::ctor>: invalid cluster size");
+
+  const int NumNodes = G.NumNodes();
+
+  //find the bounding box of the nodes
+  Vector2D BottomRight(-MaxDouble, -MaxDouble);
+  m_vOrigin = Vector2D(MaxDouble, MaxDouble);
+
+  typename graph_type::ConstNodeIterator NodeItr(G);
+  for (const typename graph_type::NodeType* pN=NodeItr.begin(); !NodeItr.end(); pN=NodeItr.next())
+  {
+    if (pN->Pos().x < m_vOrigin.x) m_vOrigin.x = pN->Pos().x;
+    if (pN->Pos().y < m_vOrigin.y) m_vOrigin.y = pN->Pos().y;
+
+    if (pN->Pos().x > BottomRight.x) BottomRight.x = pN->Pos().x;
+    if (pN->Pos().y > BottomRight.y) BottomRight.y = pN->Pos().y;
+  }
+
+  if (G.NumActiveNodes() > 0)
+  {
+    m_iNumClustersX = (int)((BottomRight.x - m_vOrigin.x) / m_dClusterSize) + 1;
+    m_iNumClustersY = (int)((BottomRight.y - m_vOrigin.y) / m_dClusterSize) + 1;
+  }
+
+  const int NumClusters = m_iNumClustersX * m_iNumClustersY;
+
+  //assign each node to a cluster and sort the nodes by cluster
+  m_NodeCluster.assign(NumNodes, -1);
+  m_LocalIndex.assign(NumNodes, -1);
+  m_ClusterStart.assign(NumClusters+1, 0);
+
+  for (int n=0; n<NumNodes; ++n)
+  {
+    if (!G.isNodePresent(n)) continue;
+
+    m_NodeCluster[n] = CalculateCluster(G.GetNode(n).Pos());
+
+    ++m_ClusterStart[m_NodeCluster[n]+1];
+  }
+
+  for (int c=0; c<NumClusters; ++c) m_ClusterStart[c+1] += m_ClusterStart[c];
+
+  m_ClusterNodes.resize(m_ClusterStart[NumClusters]);
+
+  std::vector<int> NumPlaced(NumClusters, 0);
+
+  for (int n=0; n<NumNodes; ++n)
+  {
+    int c = m_NodeCluster[n];
+
+    if (c < 0) continue;
+
+    m_LocalIndex[n] = NumPlaced[c]++;
+
+    m_ClusterNodes[m_ClusterStart[c] + m_LocalIndex[n]] = n;
+  }
+
+  //find the entrances, cluster by cluster
+  m_EntranceIndex.assign(NumNodes, -1);
+  m_EntranceStart.assign(NumClusters+1, 0);
+
+  for (int c=0; c<NumClusters; ++c)
+  {
+    m_EntranceStart[c] = m_EntranceNode.size();
+
+    for (int i=m_ClusterStart[c]; i<m_ClusterStart[c+1]; ++i)
+    {
+      int n = m_ClusterNodes[i];
+
+      typename graph_type::ConstEdgeIterator EdgeItr(G, n);
+      for (const EdgeType* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+      {
+        if (m_NodeCluster[pE->To()] != c)
+        {
+          m_EntranceIndex[n] = m_EntranceNode.size();
+          m_EntranceNode.push_back(n);
+
+          break;
+        }
+      }
+    }
+  }
+
+  m_EntranceStart[NumClusters] = m_EntranceNode.size();
+
+  //and join them up
+  std::vector<double>          Costs;
+  std::vector<const EdgeType*> SPT;
+
+  m_AbstractEdgeStart.reserve(NumEntrances()+1);
+
+  for (int c=0; c<NumClusters; ++c)
+  {
+    for (int e=FirstEntrance(c); e<FirstEntrance(c+1); ++e)
+    {
+      m_AbstractEdgeStart.push_back(m_AbstractEdges.size());
+
+      int n = m_EntranceNode[e];
+
+      AbstractEdge edge;
+
+      //the entrances of the same cluster reachable from this one
+      SearchCluster(n, -1, Costs, SPT);
+
+      for (int f=FirstEntrance(c); f<FirstEntrance(c+1); ++f)
+      {
+        double cost = GetClusterCost(Costs, m_EntranceNode[f]);
+
+        if (f == e || cost == MaxDouble) continue;
+
+        edge.iTo   = f;
+        edge.dCost = cost;
+
+        m_AbstractEdges.push_back(edge);
+      }
+
+      //and the entrances of the neighbouring clusters
+      typename graph_type::ConstEdgeIterator EdgeItr(G, n);
+      for (const EdgeType* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+      {
+        if (m_NodeCluster[pE->To()] == c) continue;
+
+        edge.iTo   = m_EntranceIndex[pE->To()];
+        edge.dCost = pE->Cost();
+
+        m_AbstractEdges.push_back(edge);
+      }
+    }
+  }
+
+  m_AbstractEdgeStart.push_back(m_AbstractEdges.size());
+}
+
+//--------------------------- CalculateCluster --------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+int HierarchicalGraph<graph_type>::CalculateCluster(Vector2D pos)const
+{
+  int x = (int)((pos.x - m_vOrigin.x) / m_dClusterSize);
+  int y = (int)((pos.y - m_vOrigin.y) / m_dClusterSize);
+
+  //make sure the position is within range
+  if (x < 0) x = 0; else if (x >= m_iNumClustersX) x = m_iNumClustersX-1;
+  if (y < 0) y = 0; else if (y >= m_iNumClustersY) y = m_iNumClustersY-1;
+
+  return x + y*m_iNumClustersX;
+}
+
+//----------------------------- SearchCluster ---------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+void HierarchicalGraph<graph_type>::SearchCluster(int                           source,
+                                                  int                           target,
+                                                  std::vector<double>&          Costs,
+                                                  std::vector<const EdgeType*>& SPT)const
+{
+  const int cluster = m_NodeCluster[source];
+  const int first   = m_ClusterStart[cluster];
+  const int size    = NumNodesInCluster(cluster);
+
+  Costs.assign(size, MaxDouble);
+  SPT.assign(size, NULL);
+
+  //nodes whose cheapest path has been found
+  std::vector<bool> done(size, false);
+
+  IndexedPriorityQLow<double> pq(Costs, size);
+
+  Costs[m_LocalIndex[source]] = 0;
+  pq.insert(m_LocalIndex[source]);
+
+  while (!pq.empty())
+  {
+    int local = pq.Pop();
+    int node  = m_ClusterNodes[first + local];
+
+    done[local] = true;
+
+    if (node == target) break;
+
+    typename graph_type::ConstEdgeIterator EdgeItr(m_Graph, node);
+    for (const EdgeType* pE=EdgeItr.begin(); !EdgeItr.end(); pE=EdgeItr.next())
+    {
+      if (m_NodeCluster[pE->To()] != cluster) continue;
+
+      int    to   = m_LocalIndex[pE->To()];
+      double cost = Costs[local] + pE->Cost();
+
+      if (done[to] || cost >= Costs[to]) continue;
+
+      bool bQueued = Costs[to] != MaxDouble;
+
+      Costs[to] = cost;
+      SPT[to]   = pE;
+
+      if (bQueued) pq.ChangePriority(to);
+      else         pq.insert(to);
+    }
+  }
+}
+
+//--------------------------- FindPathInCluster -------------------------------
+//-----------------------------------------------------------------------------
+template <class graph_type>
+bool HierarchicalGraph<graph_type>::FindPathInCluster(int                           from,
+                                                      int                           to,
+                                                      std::vector<const EdgeType*>& path)const
+{
+  assert (m_NodeCluster[from] == m_NodeCluster[to] &&
+          "<HierarchicalGraph::FindPathInCluster>: nodes are in different clusters");
+
+  path.clear();
+
+  std::vector<double>          Costs;
+  std::vector<const EdgeType*> SPT;
+
+  SearchCluster(from, to, Costs, SPT);
+
+  if (GetClusterCost(Costs, to) == MaxDouble) return false;
+
+  for (int nd=to; nd != from; nd = SPT[m_LocalIndex[nd]]->From())
+  {
+    path.push_back(SPT[m_LocalIndex[nd]]);
+  }
+
+  std::reverse(path.begin(), path.end());
+
+  return true;
+}
+
+
+
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef PATHCOSTTABLE_H
+#define PATHCOSTTABLE_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   PathCostTable.h
+//
+//  Desc:   a compact lookup table of the cost of the shortest path between
+//          every pair of nodes in a graph. The costs are held in a single
+//          flat array. If the graph is undirected the cost from A to B is
+//          the same as from B to A so only the upper triangle of the table
+//          is stored.
+//
+//          The costs may be stored as doubles (exact), floats or 16 bit
+//          fixed point numbers. In fixed point each row of the table is
+//          scaled by its own largest cost, so the error in any entry is no
+//          more than 1/131070th of the largest cost in its row.
+//
+//          The table is filled in a row at a time with SetRow (see
+//          CreateAllPairsCostsTable in HandyGraphFunctions.h). Different
+//          rows may be set from different threads at once.
+//
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+
+
+class PathCostTable
+{
+public:
+
+  enum storage_type
+  {
+    exact,
+    single_precision,
+    fixed_point
+  };
+
+private:
+
+  storage_type                 m_Storage;
+
+  int                          m_iNumNodes;
+
+  //true if only the upper triangle is stored
+  bool                         m_bSymmetric;
+
+  //only the vector matching the storage type is used
+  std::vector<double>          m_Exact;
+  std::vector<float>           m_Single;
+  std::vector<unsigned short>  m_Fixed;
+
+  //the size of one unit of each row's fixed point costs
+  std::vector<double>          m_RowScale;
+
+
+  //returns the index into the flat array of the cost from one node to
+  //another. If the table is symmetric from must be less than to
+  inline size_t Index(int from, int to)const
+  {
+    if (m_bSymmetric)
+    {
+      return (size_t)from * m_iNumNodes - (size_t)from * (from+1) / 2 + (to - from - 1);
+    }
+
+    return (size_t)from * m_iNumNodes + to;
+  }
+
+  //the number of costs stored
+  inline size_t Size()const
+  {
+    if (m_bSymmetric) return (size_t)m_iNumNodes * (m_iNumNodes-1) / 2;
+
+    return (size_t)m_iNumNodes * m_iNumNodes;
+  }
+
+public:
+
+  PathCostTable():m_Storage(exact), m_iNumNodes(0), m_bSymmetric(false){}
+
+  //discards any costs and sizes the table for a graph of NumNodes nodes.
+  //Set bSymmetric if the graph is undirected
+  inline void Reset(int NumNodes, bool bSymmetric, storage_type storage);
+
+  //sets the costs from the given node to every other. (if the table is
+  //symmetric only the costs to higher numbered nodes are used)
+  inline void SetRow(int from, const std::vector<double>& costs);
+
+  //returns the cost of the shortest path from one node to another
+  inline double GetCost(int from, int to)const;
+
+  int          NumNodes()const{return m_iNumNodes;}
+  bool         isSymmetric()const{return m_bSymmetric;}
+  storage_type GetStorageType()const{return m_Storage;}
+
+  //returns the number of bytes used to hold the costs
+  inline size_t GetMemoryUsed()const;
+
+  //writes the costs as raw binary data. Read expects a table written with
+  //the same size, symmetry and storage type as this one (as set by Reset)
+  //and returns false if the stream ends early
+  inline void Write(std::ostream& os)const;
+  inline bool Read(std::istream& is);
+};
+
+
+//------------------------------- Reset -----------------------------------
+//-------------------------------------------------------------------------
+inline void PathCostTable::Reset(int NumNodes, bool bSymmetric, storage_type storage)
+{
+  m_iNumNodes  = NumNodes;
+  m_bSymmetric = bSymmetric;
+  m_Storage    = storage;
+
+  //swap with empty vectors to release the memory
+  std::vector<double>().swap(m_Exact);
+  std::vector<float>().swap(m_Single);
+  std::vector<unsigned short>().swap(m_Fixed);
+  std::vector<double>().swap(m_RowScale);
+
+  switch(m_Storage)
+  {
+  case exact:            m_Exact.resize(Size(), 0.0);  break;
+
+  case single_precision: m_Single.resize(Size(), 0.0f); break;
+
+  case fixed_point:
+
+    m_Fixed.resize(Size(), 0);
+    m_RowScale.resize(m_iNumNodes, 0.0);
+
+    break;
+  }
+}
+
+//------------------------------- SetRow ----------------------------------
+//-------------------------------------------------------------------------
+inline void PathCostTable::SetRow(int from, const std::vector<double>& costs)
+{
+  assert (from >= 0 && from < m_iNumNodes && (int)costs.size() == m_iNumNodes &&
+          "<PathCostTable::SetRow>: invalid row");
+
+  int first = m_bSymmetric ? from+1 : 0;
+
+  if (first >= m_iNumNodes) return;
+
+  size_t start = Index(from, first);
+  int    count = m_iNumNodes - first;
+
+  switch(m_Storage)
+  {
+  case exact:
+
+    for (int to=0; to<count; ++to) m_Exact[start+to] = costs[first+to];
+
+    break;
+
+  case single_precision:
+
+    for (int to=0; to<count; ++to) m_Single[start+to] = (float)costs[first+to];
+
+    break;
+
+  case fixed_point:
+    {
+      double MaxCost = 0.0;
+
+      for (int to=0; to<count; ++to)
+      {
+        if (costs[first+to] > MaxCost) MaxCost = costs[first+to];
+      }
+
+      double scale = MaxCost / 65535.0;
+
+      m_RowScale[from] = scale;
+
+      for (int to=0; to<count; ++to)
+      {
+        m_Fixed[start+to] = scale > 0 ? (unsigned short)(costs[first+to] / scale + 0.5) : 0;
+      }
+    }
+
+    break;
+  }
+}
+
+//------------------------------- GetCost ---------------------------------
+//-------------------------------------------------------------------------
+inline double PathCostTable::GetCost(int from, int to)const
+{
+  if (m_bSymmetric)
+  {
+    if (from == to) return 0.0;
+
+    if (from > to) std::swap(from, to);
+  }
+
+  size_t idx = Index(from, to);
+
+  switch(m_Storage)
+  {
+  case single_precision: return m_Single[idx];
+
+  case fixed_point:      return m_Fixed[idx] * m_RowScale[from];
+
+  default:               return m_Exact[idx];
+  }
+}
+
+//---------------------------- GetMemoryUsed ------------------------------
+//-------------------------------------------------------------------------
+inline size_t PathCostTable::GetMemoryUsed()const
+{
+  return m_Exact.size()    * sizeof(double) +
+         m_Single.size()   * sizeof(float)  +
+         m_Fixed.size()    * sizeof(unsigned short) +
+         m_RowScale.size() * sizeof(double);
+}
+
+//----------------------------- Write / Read ------------------------------
+//-------------------------------------------------------------------------
+inline void PathCostTable::Write(std::ostream& os)const
+{
+  if (!m_Exact.empty())    os.write((const char*)&m_Exact[0],    m_Exact.size()    * sizeof(double));
+  if (!m_Single.empty())   os.write((const char*)&m_Single[0],   m_Single.size()   * sizeof(float));
+  if (!m_Fixed.empty())    os.write((const char*)&m_Fixed[0],    m_Fixed.size()    * sizeof(unsigned short));
+  if (!m_RowScale.empty()) os.write((const char*)&m_RowScale[0], m_RowScale.size() * sizeof(double));
+}
+
+inline bool PathCostTable::Read(std::istream& is)
+{
+  if (!m_Exact.empty())    is.read((char*)&m_Exact[0],    m_Exact.size()    * sizeof(double));
+  if (!m_Single.empty())   is.read((char*)&m_Single[0],   m_Single.size()   * sizeof(float));
+  if (!m_Fixed.empty())    is.read((char*)&m_Fixed[0],    m_Fixed.size()    * sizeof(unsigned short));
+  if (!m_RowScale.empty()) is.read((char*)&m_RowScale[0], m_RowScale.size() * sizeof(double));
+
+  return !is.fail();
+}
+
+
+
+#endif
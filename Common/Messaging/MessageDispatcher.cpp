@@ -1,7 +1,8 @@
 #include "MessageDispatcher.h"
 #include "Game/BaseGameEntity.h"
 #include "misc/FrameCounter.h"
-#include "game/EntityManager.h"
+#include "Game/EntityManager.h"
+#include "Game/WorldContext.h"
 #include "Debug/DebugConsole.h"
 
 using std::set;
@@ -11,13 +12,11 @@ using std::set;
 
 //--------------------------- Instance ----------------------------------------
 //
-//   this class is a singleton
+//   returns the instance owned by the current world context
 //-----------------------------------------------------------------------------
 MessageDispatcher* MessageDispatcher::Instance()
 {
-  static MessageDispatcher instance; 
-  
-  return &instance;
+  return WorldContext::Current()->GetDispatcher();
 }
 
 //----------------------------- Dispatch ---------------------------------
@@ -6,7 +6,8 @@
 //  Name:   MessageDispatcher.h
 //
 //  Desc:   A message dispatcher. Manages messages of the type Telegram.
-//          Instantiated as a singleton.
+//          Each world context owns one; Dispatcher refers to the instance
+//          belonging to the context current on the calling thread.
 //
 //  Author: Mat Buckland (fup@ai-junkie.com)
 //
@@ -44,6 +45,8 @@ private:
   //entity, pReceiver, with the newly created telegram
   void Discharge(BaseGameEntity* pReceiver, const Telegram& msg);
 
+  friend class WorldContext;
+
   MessageDispatcher(){}
 
   //copy ctor and assignment should be private
@@ -52,6 +55,7 @@ private:
 
 public:
 
+  //returns the dispatcher of the current world context
   static MessageDispatcher* Instance();
 
   //send a message to another agent. Receiving agent is referenced by ID.
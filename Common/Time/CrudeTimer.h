@@ -13,7 +13,7 @@
 //this library must be included
 #pragma comment(lib, "winmm.lib")
 
-#include <windows.h>
+#include "misc/Win32Compat.h"
 
 
 
@@ -9,13 +9,15 @@
 //          section to flow (like 10 times per second) and then only allow 
 //          the program flow to continue if Ready() returns true
 //
+//          The regulator is timed against a SimClock rather than the system
+//          time so that regulated code runs at the same rate per simulated
+//          second however fast the simulation is being stepped.
+//
 //  Author: Mat Buckland 2003 (fup@ai-junkie.com)
 //
 //------------------------------------------------------------------------
-#pragma comment(lib,"winmm.lib") //if you don't use MSVC make sure this library is included in your project
-#include "mmsystem.h" 
-
 #include "misc/utils.h"
+#include "Time/SimClock.h"
 
 
 
@@ -24,23 +26,27 @@ class Regulator
 {
 private:
 
-  //the time period between updates 
+  //the clock this regulator is timed against
+  const SimClock* m_pClock;
+
+  //the time period between updates (in seconds)
   double m_dUpdatePeriod;
 
   //the next time the regulator allows code flow
-  DWORD m_dwNextUpdateTime;
+  double m_dNextUpdateTime;
 
 
 public:
 
   
-  Regulator(double NumUpdatesPerSecondRqd)
+  Regulator(const SimClock* pClock,
+            double          NumUpdatesPerSecondRqd):m_pClock(pClock)
   {
-    m_dwNextUpdateTime = (DWORD)(timeGetTime()+RandFloat()*1000);
+    m_dNextUpdateTime = m_pClock->GetCurrentTime() + RandFloat();
 
     if (NumUpdatesPerSecondRqd > 0)
     {
-      m_dUpdatePeriod = 1000.0 / NumUpdatesPerSecondRqd; 
+      m_dUpdatePeriod = 1.0 / NumUpdatesPerSecondRqd; 
     }
 
     else if (isEqual(0.0, NumUpdatesPerSecondRqd))
@@ -55,7 +61,7 @@ public:
   }
 
 
-  //returns true if the current time exceeds m_dwNextUpdateTime
+  //returns true if the current time exceeds m_dNextUpdateTime
   bool isReady()
   {
     //if a regulator is instantiated with a zero freq then it goes into
@@ -66,16 +72,16 @@ public:
     //never allow the code to flow
     if (m_dUpdatePeriod < 0) return false;
 
-    DWORD CurrentTime = timeGetTime();
+    double CurrentTime = m_pClock->GetCurrentTime();
 
-    //the number of milliseconds the update period can vary per required
+    //the number of seconds the update period can vary per required
     //update-step. This is here to make sure any multiple clients of this class
     //have their updates spread evenly
-    static const double UpdatePeriodVariator = 10.0;
+    static const double UpdatePeriodVariator = 0.01;
 
-    if (CurrentTime >= m_dwNextUpdateTime)
+    if (CurrentTime >= m_dNextUpdateTime)
     {
-      m_dwNextUpdateTime = (DWORD)(CurrentTime + m_dUpdatePeriod + RandInRange(-UpdatePeriodVariator, UpdatePeriodVariator));
+      m_dNextUpdateTime = CurrentTime + m_dUpdatePeriod + RandInRange(-UpdatePeriodVariator, UpdatePeriodVariator);
 
       return true;
     }
@@ -0,0 +1,51 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+//------------------------------------------------------------------------
+//
+//  Name:   SimClock.h
+//
+//  Desc:   measures simulated time in seconds. Unlike CrudeTimer this
+//          class never reads the system time: it is advanced one fixed
+//          time step at a time by whoever owns the simulation. Anything
+//          timed against a SimClock therefore behaves identically whether
+//          the simulation is stepped in real time or many times faster.
+//
+//------------------------------------------------------------------------
+#include <cassert>
+
+
+class SimClock
+{
+private:
+
+  //the amount of simulated time each update-step represents
+  double m_dTimeStep;
+
+  //the number of update-steps taken since the clock was started or reset
+  long   m_lNumSteps;
+
+public:
+
+  SimClock(double TimeStep):m_dTimeStep(TimeStep),
+                            m_lNumSteps(0)
+  {
+    assert (TimeStep > 0 && "<SimClock::SimClock>: time step must be positive");
+  }
+
+  //advances the clock by one update-step
+  void   Tick(){++m_lNumSteps;}
+
+  //sets the clock back to zero
+  void   Reset(){m_lNumSteps = 0;}
+
+  //returns how much simulated time has elapsed since the clock was started.
+  //(calculated from the step count so no rounding error accumulates)
+  double GetCurrentTime()const{return m_lNumSteps * m_dTimeStep;}
+
+  double GetTimeStep()const{return m_dTimeStep;}
+  long   GetNumSteps()const{return m_lNumSteps;}
+};
+
+
+
+#endif
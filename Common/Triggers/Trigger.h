@@ -10,7 +10,7 @@
 //          activated when an entity moves within its region of influence.
 //
 //-----------------------------------------------------------------------------
-#include "game/BaseGameEntity.h"
+#include "Game/BaseGameEntity.h"
 #include "TriggerRegion.h"
 
 struct Telegram;
@@ -76,6 +76,9 @@ public:
   virtual void  Update() = 0;
 
   int  GraphNodeIndex()const{return m_iGraphNodeIndex;}
+
+  //returns the trigger's region of influence (NULL if it has none)
+  const TriggerRegion* GetRegion()const{return m_pRegionOfInfluence;}
   bool isToBeRemoved()const{return m_bRemoveFromGame;}
   bool isActive(){return m_bActive;}
 };
@@ -10,8 +10,8 @@
 //          TriggerRegion has one method, isTouching, which returns true if
 //          a given position is inside the region
 //-----------------------------------------------------------------------------
-#include "2d/Vector2d.h"
-#include "2d/InvertedAABBox2D.h"
+#include "2D/Vector2D.h"
+#include "2D/InvertedAABBox2D.h"
 
 class TriggerRegion
 {
@@ -22,6 +22,9 @@ public:
   //returns true if an entity of the given size and position is intersecting
   //the trigger region.
   virtual bool isTouching(Vector2D EntityPos, double EntityRadius)const = 0;
+
+  //returns a box enclosing the region
+  virtual InvertedAABBox2D GetBoundingBox()const = 0;
 };
 
 
@@ -50,6 +53,12 @@ public:
   {
     return Vec2DDistanceSq(m_vPos, pos) < (EntityRadius + m_dRadius)*(EntityRadius + m_dRadius);
   }
+
+  InvertedAABBox2D GetBoundingBox()const
+  {
+    return InvertedAABBox2D(m_vPos - Vector2D(m_dRadius, m_dRadius),
+                            m_vPos + Vector2D(m_dRadius, m_dRadius));
+  }
 };
 
 
@@ -83,6 +92,8 @@ public:
 
     return Box.isOverlappedWith(*m_pTrigger);
   }
+
+  InvertedAABBox2D GetBoundingBox()const{return *m_pTrigger;}
 };
 
 
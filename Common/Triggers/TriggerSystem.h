@@ -11,7 +11,21 @@
 //           takes care of updating those triggers and of removing them from
 //           the system if their lifetime has expired.
 //
+//           If a spatial index of the entities is available it may be
+//           passed to Update so that each trigger is only tried against
+//           the entities near its region. The index must provide a
+//           QueryBox method like the one in CellSpacePartition.
+//
+//           The system keeps a count of the times the set of active
+//           triggers has changed so that anything that depends on it (such
+//           as a cache of searches for active triggers) can tell when it is
+//           out of date.
+//
 //-----------------------------------------------------------------------------
+#include <vector>
+#include <algorithm>
+
+
 template <class trigger_type>
 class TriggerSystem
 {
@@ -23,6 +37,37 @@ private:
 
   TriggerList   m_Triggers; 
 
+  //incremented whenever a trigger is activated, deactivated, added or
+  //removed. m_ActiveStates records the state of each trigger when it was
+  //last checked
+  unsigned int       m_iActivationVersion;
+  std::vector<bool>  m_ActiveStates;
+
+  //compares the triggers' states to those recorded at the last check
+  void UpdateActivationVersion()
+  {
+    bool bChanged = m_ActiveStates.size() != m_Triggers.size();
+
+    m_ActiveStates.resize(m_Triggers.size());
+
+    int i = 0;
+
+    typename TriggerList::iterator curTrg;
+    for (curTrg = m_Triggers.begin(); curTrg != m_Triggers.end(); ++curTrg, ++i)
+    {
+      bool bActive = (*curTrg)->isActive();
+
+      if (m_ActiveStates[i] != bActive)
+      {
+        m_ActiveStates[i] = bActive;
+
+        bChanged = true;
+      }
+    }
+
+    if (bChanged) ++m_iActivationVersion;
+  }
+
 
   //this method iterates through all the triggers present in the system and
   //calls their Update method in order that their internal state can be
@@ -30,7 +75,7 @@ private:
   //have their m_bRemoveFromGame field set to true.
   void UpdateTriggers()
   {
-    TriggerList::iterator curTrg = m_Triggers.begin();
+    typename TriggerList::iterator curTrg = m_Triggers.begin();
     while (curTrg != m_Triggers.end())
     {
       //remove trigger if dead
@@ -57,14 +102,14 @@ private:
   void TryTriggers(ContainerOfEntities& entities)
   {
     //test each entity against the triggers
-    ContainerOfEntities::iterator curEnt = entities.begin();
+    typename ContainerOfEntities::iterator curEnt = entities.begin();
     for (curEnt; curEnt != entities.end(); ++curEnt)
     {
       //an entity must be ready for its next trigger update and it must be 
       //alive before it is tested against each trigger.
       if ((*curEnt)->isReadyForTriggerUpdate() && (*curEnt)->isAlive())
       {
-        TriggerList::const_iterator curTrg;
+        typename TriggerList::const_iterator curTrg;
         for (curTrg = m_Triggers.begin(); curTrg != m_Triggers.end(); ++curTrg)
         {
           (*curTrg)->Try(*curEnt);
@@ -72,10 +117,59 @@ private:
       }
     }
   }
+
+  //as above but each trigger is only tried against the entities the
+  //spatial index reports as overlapping the trigger's region
+  template <class ContainerOfEntities, class SpatialIndex>
+  void TryTriggers(ContainerOfEntities& entities, const SpatialIndex& index)
+  {
+    typedef typename ContainerOfEntities::value_type EntityPtr;
+
+    //determine which entities are eligible. This must be done up front
+    //because isReadyForTriggerUpdate may only be queried once per update
+    std::vector<EntityPtr> eligible;
+
+    typename ContainerOfEntities::iterator curEnt = entities.begin();
+    for (curEnt; curEnt != entities.end(); ++curEnt)
+    {
+      if ((*curEnt)->isReadyForTriggerUpdate() && (*curEnt)->isAlive())
+      {
+        eligible.push_back(*curEnt);
+      }
+    }
+
+    if (eligible.empty()) return;
+
+    std::sort(eligible.begin(), eligible.end());
+
+    std::vector<EntityPtr> nearby;
+
+    typename TriggerList::const_iterator curTrg;
+    for (curTrg = m_Triggers.begin(); curTrg != m_Triggers.end(); ++curTrg)
+    {
+      //a trigger without a region can never be touched
+      if (!(*curTrg)->GetRegion()) continue;
+
+      InvertedAABBox2D box = (*curTrg)->GetRegion()->GetBoundingBox();
+
+      index.QueryBox(box.TopLeft(), box.BottomRight(), nearby);
+
+      typename std::vector<EntityPtr>::const_iterator it = nearby.begin();
+      for (it; it != nearby.end(); ++it)
+      {
+        if (std::binary_search(eligible.begin(), eligible.end(), *it))
+        {
+          (*curTrg)->Try(*it);
+        }
+      }
+    }
+  }
   
 
 public:
 
+  TriggerSystem():m_iActivationVersion(0){}
+
   ~TriggerSystem()
   {
     Clear();
@@ -84,13 +178,15 @@ public:
   //this deletes any current triggers and empties the trigger list
   void Clear()
   {
-    TriggerList::iterator curTrg;
+    typename TriggerList::iterator curTrg;
     for (curTrg = m_Triggers.begin(); curTrg != m_Triggers.end(); ++curTrg)
     {
       delete *curTrg;
     }
 
     m_Triggers.clear();
+
+    ++m_iActivationVersion;
   }
 
   //This method should be called each update-step of the game. It will first
@@ -101,6 +197,17 @@ public:
   {
     UpdateTriggers();
     TryTriggers(entities);
+    UpdateActivationVersion();
+  }
+
+  //as above, using a spatial index of the entities to avoid trying every
+  //entity against every trigger
+  template <class ContainerOfEntities, class SpatialIndex>
+  void Update(ContainerOfEntities& entities, const SpatialIndex& index)
+  {
+    UpdateTriggers();
+    TryTriggers(entities, index);
+    UpdateActivationVersion();
   }
 
   //this is used to register triggers with the TriggerSystem (the TriggerSystem
@@ -108,12 +215,14 @@ public:
   void Register(trigger_type* trigger)
   {
     m_Triggers.push_back(trigger);
+
+    ++m_iActivationVersion;
   }
 
   //some triggers are required to be rendered (like giver-triggers for example)
   void Render()
   {
-    TriggerList::iterator curTrg;
+    typename TriggerList::iterator curTrg;
     for (curTrg = m_Triggers.begin(); curTrg != m_Triggers.end(); ++curTrg)
     {
       (*curTrg)->Render();
@@ -122,6 +231,8 @@ public:
 
   const TriggerList& GetTriggers()const{return m_Triggers;}
 
+  unsigned int       GetActivationVersion()const{return m_iActivationVersion;}
+
 };
 
 
@@ -8,10 +8,12 @@
 //  Author:   Mat Buckland
 //
 //  Desc:     base class to create a trigger that is capable of respawning
-//            after a period of inactivity
+//            after a period of inactivity. The period is measured in
+//            seconds of simulated time read from a SimClock.
 //
 //-----------------------------------------------------------------------------
 #include "Trigger.h"
+#include "Time/SimClock.h"
 #include <iosfwd>
 #include <cassert>
 
@@ -21,26 +23,29 @@ class Trigger_Respawning : public Trigger<entity_type>
 {
 protected:
 
+  //the clock the respawn delay is measured against
+  const SimClock* m_pClock;
+
   //When a bot comes within this trigger's area of influence it is triggered
   //but then becomes inactive for a specified amount of time. These values
   //control the amount of time required to pass before the trigger becomes 
   //active once more.
-  int   m_iNumUpdatesBetweenRespawns;
-  int   m_iNumUpdatesRemainingUntilRespawn;
+  double m_dTimeBetweenRespawns;
+  double m_dTimeOfRespawn;
 
-  //sets the trigger to be inactive for m_iNumUpdatesBetweenRespawns 
-  //update-steps
+  //sets the trigger to be inactive for m_dTimeBetweenRespawns seconds
   void Deactivate()
   {
     SetInactive();
-    m_iNumUpdatesRemainingUntilRespawn = m_iNumUpdatesBetweenRespawns;
+    m_dTimeOfRespawn = m_pClock->GetCurrentTime() + m_dTimeBetweenRespawns;
   }
 
 public:
 
-  Trigger_Respawning(int id):Trigger<entity_type>(id),
-                             m_iNumUpdatesBetweenRespawns(0),
-                             m_iNumUpdatesRemainingUntilRespawn(0)
+  Trigger_Respawning(int id, const SimClock* clock):Trigger<entity_type>(id),
+                                                    m_pClock(clock),
+                                                    m_dTimeBetweenRespawns(0),
+                                                    m_dTimeOfRespawn(0)
   {}
 
   virtual ~Trigger_Respawning(){}
@@ -51,14 +56,14 @@ public:
   //this is called each game-tick to update the trigger's internal state
   virtual void Update()
   {
-    if ( (--m_iNumUpdatesRemainingUntilRespawn <= 0) && !isActive())
+    if (!isActive() && (m_pClock->GetCurrentTime() >= m_dTimeOfRespawn))
     {
       SetActive();
     }
   }
   
-  void SetRespawnDelay(unsigned int numTicks)
-  {m_iNumUpdatesBetweenRespawns = numTicks;}
+  void SetRespawnDelay(double seconds)
+  {m_dTimeBetweenRespawns = seconds;}
 };
 
 
@@ -0,0 +1,106 @@
+#pragma warning (disable:4786)
+#include "fuzzy/CompiledFuzzyModule.h"
+
+
+
+//------------------------------- Compile -------------------------------------
+//
+//  the sets of each variable are numbered in the order the FuzzyVariable
+//  visits them so the sums in DeFuzzify are made in the same order
+//-----------------------------------------------------------------------------
+void CompiledFuzzyModule::Compile(const FuzzyModule& module)
+{
+  m_Sets.clear();
+  m_Variables.clear();
+
+  m_Program = FuzzyProgram();
+
+  FuzzyModule::VarMap::const_iterator curVar = module.m_Variables.begin();
+  for (curVar; curVar != module.m_Variables.end(); ++curVar)
+  {
+    const FuzzyVariable* flv = curVar->second;
+
+    Variable var;
+
+    var.name     = curVar->first;
+    var.FirstSet = m_Sets.size();
+    var.MinRange = flv->m_dMinRange;
+    var.MaxRange = flv->m_dMaxRange;
+
+    FuzzyVariable::MemberSets::const_iterator curSet = flv->m_MemberSets.begin();
+    for (curSet; curSet != flv->m_MemberSets.end(); ++curSet)
+    {
+      Set set;
+
+      set.shape             = curSet->second->GetShape(set.peak,
+                                                       set.LeftOffset,
+                                                       set.RightOffset);
+      set.RepresentativeVal = curSet->second->GetRepresentativeVal();
+
+      m_Program.SetIndex(*curSet->second, m_Sets.size());
+
+      m_Sets.push_back(set);
+    }
+
+    var.LastSet = m_Sets.size();
+
+    m_Variables.push_back(var);
+  }
+
+  std::vector<FuzzyRule*>::const_iterator curRule = module.m_Rules.begin();
+  for (curRule; curRule != module.m_Rules.end(); ++curRule)
+  {
+    (*curRule)->m_pAntecedent->CompileAntecedent(m_Program);
+    (*curRule)->m_pConsequence->CompileConsequent(m_Program);
+
+    m_Program.EndRule();
+  }
+
+  m_Program.Finish();
+}
+
+//----------------------------- GetVariable -----------------------------------
+//-----------------------------------------------------------------------------
+int CompiledFuzzyModule::GetVariable(const std::string& NameOfFLV)const
+{
+  for (unsigned int v=0; v<m_Variables.size(); ++v)
+  {
+    if (m_Variables[v].name == NameOfFLV) return v;
+  }
+
+  assert (0 && "<CompiledFuzzyModule::GetVariable>: key not found");
+
+  return -1;
+}
+
+//---------------------------- GetActiveRange ---------------------------------
+//
+//  the outer edge of a shoulder is usually an edge of the variable's range,
+//  in which case its DOM is constant from its peak to that edge
+//-----------------------------------------------------------------------------
+void CompiledFuzzyModule::GetActiveRange(int FLV, double& lo, double& hi)const
+{
+  const Variable& var = m_Variables[FLV];
+
+  lo = var.MaxRange;
+  hi = var.MinRange;
+
+  for (int s=var.FirstSet; s<var.LastSet; ++s)
+  {
+    const Set& set = m_Sets[s];
+
+    double first = set.peak - set.LeftOffset;
+    double last  = set.peak + set.RightOffset;
+
+    if (set.shape == FuzzySet::left_shoulder  && first <= var.MinRange) first = set.peak;
+    if (set.shape == FuzzySet::right_shoulder && last  >= var.MaxRange) last  = set.peak;
+
+    if (first < lo) lo = first;
+    if (last  > hi) hi = last;
+  }
+
+  if (lo < var.MinRange) lo = var.MinRange;
+  if (hi > var.MaxRange) hi = var.MaxRange;
+
+  if (hi < lo) {lo = var.MinRange; hi = var.MaxRange;}
+}
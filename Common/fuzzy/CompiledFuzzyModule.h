@@ -0,0 +1,249 @@
+#ifndef COMPILED_FUZZY_MODULE_H
+#define COMPILED_FUZZY_MODULE_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   CompiledFuzzyModule.h
+//
+//  Desc:   a fuzzy module compiled for fast inference. Once a FuzzyModule's
+//          variables and rules are in place it can be compiled to flat
+//          arrays of set parameters and a linear rule program (see
+//          FuzzyProgram.h). Variables are referred to by integer handles
+//          found once with GetVariable, and inference needs no string
+//          lookups, virtual calls or allocation.
+//
+//          The compiled module is never changed by inference. The DOMs of
+//          the sets are held in a separate array passed to Fuzzify and
+//          DeFuzzify, so a module may be shared by any number of users,
+//          each with its own DOMs.
+//
+//          The results are identical to those of the FuzzyModule it was
+//          compiled from.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <string>
+#include <cassert>
+
+#include "fuzzy/FuzzyModule.h"
+#include "fuzzy/FuzzyProgram.h"
+
+
+class CompiledFuzzyModule
+{
+public:
+
+  //the DOM of each set of the module
+  typedef std::vector<double> DOMs;
+
+private:
+
+  struct Set
+  {
+    FuzzySet::shape_type  shape;
+
+    double                peak;
+    double                LeftOffset;
+    double                RightOffset;
+
+    double                RepresentativeVal;
+  };
+
+  struct Variable
+  {
+    std::string  name;
+
+    //the variable's sets are m_Sets[FirstSet] to m_Sets[LastSet-1]
+    int          FirstSet;
+    int          LastSet;
+
+    double       MinRange;
+    double       MaxRange;
+  };
+
+  std::vector<Set>       m_Sets;
+  std::vector<Variable>  m_Variables;
+
+  FuzzyProgram           m_Program;
+
+  //calculates the DOM of the value in the set exactly as the FuzzySet
+  //classes do
+  static inline double CalculateDOM(const Set& set, double val);
+
+public:
+
+  CompiledFuzzyModule(){}
+
+  explicit CompiledFuzzyModule(const FuzzyModule& module){Compile(module);}
+
+  //replaces the contents of this module with a compiled copy of the given
+  //module
+  void    Compile(const FuzzyModule& module);
+
+  //returns the handle of the named variable
+  int     GetVariable(const std::string& NameOfFLV)const;
+
+  double  GetMinRange(int FLV)const{return m_Variables[FLV].MinRange;}
+  double  GetMaxRange(int FLV)const{return m_Variables[FLV].MaxRange;}
+
+  //finds the part of the variable's range where the DOMs of its sets vary.
+  //Below and above it the DOMs of every set are constant
+  void    GetActiveRange(int FLV, double& lo, double& hi)const;
+
+  //sizes an array of DOMs for the module
+  void    InitDOMs(DOMs& doms)const{doms.assign(m_Sets.size(), 0.0);}
+
+  //calculates the DOM of the value in each of the variable's sets
+  inline void   Fuzzify(DOMs& doms, int FLV, double val)const;
+
+  //runs the rules and returns the crisp value of the given variable
+  inline double DeFuzzify(DOMs&                        doms,
+                          int                          FLV,
+                          FuzzyModule::DefuzzifyMethod method = FuzzyModule::max_av)const;
+};
+
+
+//---------------------------- CalculateDOM -----------------------------------
+//-----------------------------------------------------------------------------
+inline double CompiledFuzzyModule::CalculateDOM(const Set& set, double val)
+{
+  const double peak = set.peak;
+  const double lft  = set.LeftOffset;
+  const double rgt  = set.RightOffset;
+
+  if (set.shape == FuzzySet::singleton)
+  {
+    return (val >= peak-lft) && (val <= peak+rgt) ? 1.0 : 0.0;
+  }
+
+  //test for the case where the left or right offsets are zero
+  //(to prevent divide by zero errors below)
+  if ( (isEqual(rgt, 0.0) && (isEqual(peak, val))) ||
+       (isEqual(lft, 0.0) && (isEqual(peak, val))) )
+  {
+    return 1.0;
+  }
+
+  switch (set.shape)
+  {
+  case FuzzySet::triangle:
+
+    if ( (val <= peak) && (val >= (peak - lft)) )
+    {
+      return (1.0 / lft) * (val - (peak - lft));
+    }
+
+    if ( (val > peak) && (val < (peak + rgt)) )
+    {
+      return (1.0 / -rgt) * (val - peak) + 1.0;
+    }
+
+    return 0.0;
+
+  case FuzzySet::left_shoulder:
+
+    if ( (val >= peak) && (val < (peak + rgt)) )
+    {
+      return (1.0 / -rgt) * (val - peak) + 1.0;
+    }
+
+    if ( (val < peak) && (val >= peak-lft) )
+    {
+      return 1.0;
+    }
+
+    return 0.0;
+
+  case FuzzySet::right_shoulder:
+
+    if ( (val <= peak) && (val > (peak - lft)) )
+    {
+      return (1.0 / lft) * (val - (peak - lft));
+    }
+
+    if ( (val > peak) && (val <= peak+rgt) )
+    {
+      return 1.0;
+    }
+
+    return 0.0;
+  }
+
+  return 0.0;
+}
+
+//------------------------------- Fuzzify -------------------------------------
+//-----------------------------------------------------------------------------
+inline void CompiledFuzzyModule::Fuzzify(DOMs& doms, int FLV, double val)const
+{
+  const Variable& var = m_Variables[FLV];
+
+  //make sure the value is within the bounds of this variable
+  assert ( (val >= var.MinRange) && (val <= var.MaxRange) &&
+           "<CompiledFuzzyModule::Fuzzify>: value out of range");
+
+  for (int s=var.FirstSet; s<var.LastSet; ++s)
+  {
+    doms[s] = CalculateDOM(m_Sets[s], val);
+  }
+}
+
+//------------------------------ DeFuzzify ------------------------------------
+//-----------------------------------------------------------------------------
+inline double CompiledFuzzyModule::DeFuzzify(DOMs&                        doms,
+                                             int                          FLV,
+                                             FuzzyModule::DefuzzifyMethod method)const
+{
+  //clear the DOMs of all the consequents and process the rules
+  m_Program.ClearConsequents(&doms[0]);
+  m_Program.Run(&doms[0]);
+
+  const Variable& var = m_Variables[FLV];
+
+  if (method == FuzzyModule::max_av)
+  {
+    double bottom = 0.0;
+    double top    = 0.0;
+
+    for (int s=var.FirstSet; s<var.LastSet; ++s)
+    {
+      bottom += doms[s];
+      top    += m_Sets[s].RepresentativeVal * doms[s];
+    }
+
+    //make sure bottom is not equal to zero
+    if (isEqual(0, bottom)) return 0.0;
+
+    return top / bottom;
+  }
+
+  //the centroid is found by sampling the range as
+  //FuzzyVariable::DeFuzzifyCentroid does
+  const int NumSamples = FuzzyModule::NumSamples;
+
+  double StepSize = (var.MaxRange - var.MinRange)/(double)NumSamples;
+
+  double TotalArea    = 0.0;
+  double SumOfMoments = 0.0;
+
+  for (int samp=1; samp<=NumSamples; ++samp)
+  {
+    for (int s=var.FirstSet; s<var.LastSet; ++s)
+    {
+      double contribution =
+          MinOf(CalculateDOM(m_Sets[s], var.MinRange + samp * StepSize), doms[s]);
+
+      TotalArea += contribution;
+
+      SumOfMoments += (var.MinRange + samp * StepSize)  * contribution;
+    }
+  }
+
+  //make sure total area is not equal to zero
+  if (isEqual(0, TotalArea)) return 0.0;
+
+  return (SumOfMoments / TotalArea);
+}
+
+
+
+#endif
@@ -10,6 +10,7 @@
 //-----------------------------------------------------------------------------
 #include "FuzzySet.h"
 #include "FuzzyTerm.h"
+#include "FuzzyProgram.h"
 #include <math.h>
 
 class FzVery : public FuzzyTerm
@@ -36,6 +37,16 @@ public:
 
   void ClearDOM(){m_Set.ClearDOM();}
   void ORwithDOM(double val){m_Set.ORwithDOM(val * val);}
+
+  void CompileAntecedent(FuzzyProgram& program)const
+  {
+    program.PushDOM(m_Set, FuzzyProgram::very);
+  }
+
+  void CompileConsequent(FuzzyProgram& program)const
+  {
+    program.ORwithDOM(m_Set, FuzzyProgram::very);
+  }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -62,6 +73,16 @@ public:
 
   void ClearDOM(){m_Set.ClearDOM();}
   void ORwithDOM(double val){m_Set.ORwithDOM(sqrt(val));}
+
+  void CompileAntecedent(FuzzyProgram& program)const
+  {
+    program.PushDOM(m_Set, FuzzyProgram::fairly);
+  }
+
+  void CompileConsequent(FuzzyProgram& program)const
+  {
+    program.ORwithDOM(m_Set, FuzzyProgram::fairly);
+  }
 };
 
 
@@ -0,0 +1,129 @@
+#pragma warning (disable:4786)
+#include "fuzzy/FuzzyLookupTable.h"
+#include "misc/utils.h"
+
+
+
+//------------------------------- AddInput ------------------------------------
+//-----------------------------------------------------------------------------
+void FuzzyLookupTable::AddInput(int FLV)
+{
+  assert (m_Axes.size() < max_inputs && "<FuzzyLookupTable::AddInput>: too many inputs");
+
+  Axis axis;
+
+  axis.FLV    = FLV;
+  axis.MinVal = 0.0;
+  axis.MaxVal = 0.0;
+  axis.Scale  = 0.0;
+  axis.stride = 0;
+
+  m_Axes.push_back(axis);
+
+  m_Values.clear();
+}
+
+//------------------------------ GridValue ------------------------------------
+//
+//  returns the value of the input i grid points along the axis. Rounding
+//  never takes it past the end of the axis
+//-----------------------------------------------------------------------------
+double FuzzyLookupTable::GridValue(const Axis& axis, double i)
+{
+  if (axis.Scale == 0.0) return axis.MinVal;
+
+  return MinOf(axis.MinVal + i / axis.Scale, axis.MaxVal);
+}
+
+//-------------------------------- Infer --------------------------------------
+//-----------------------------------------------------------------------------
+double FuzzyLookupTable::Infer(const CompiledFuzzyModule&    module,
+                               CompiledFuzzyModule::DOMs&    doms,
+                               const std::vector<Axis>&      axes,
+                               const double*                 vals,
+                               int                           OutputFLV,
+                               FuzzyModule::DefuzzifyMethod  method)
+{
+  for (unsigned int a=0; a<axes.size(); ++a)
+  {
+    module.Fuzzify(doms, axes[a].FLV, vals[a]);
+  }
+
+  return module.DeFuzzify(doms, OutputFLV, method);
+}
+
+//--------------------------------- Bake --------------------------------------
+//-----------------------------------------------------------------------------
+void FuzzyLookupTable::Bake(const CompiledFuzzyModule&    module,
+                            int                           OutputFLV,
+                            int                           Resolution,
+                            FuzzyModule::DefuzzifyMethod  method)
+{
+  assert (!m_Axes.empty() && "<FuzzyLookupTable::Bake>: no inputs");
+  assert (Resolution >= 2 && "<FuzzyLookupTable::Bake>: resolution too low");
+
+  m_iResolution = Resolution;
+
+  const int NumAxes = m_Axes.size();
+
+  int NumPoints = 1;
+
+  for (int a=0; a<NumAxes; ++a)
+  {
+    Axis& axis = m_Axes[a];
+
+    module.GetActiveRange(axis.FLV, axis.MinVal, axis.MaxVal);
+
+    //an input whose sets never vary is sampled at one value only
+    axis.Scale  = axis.MaxVal > axis.MinVal ? (Resolution-1) / (axis.MaxVal - axis.MinVal) : 0.0;
+    axis.stride = NumPoints;
+
+    NumPoints *= Resolution;
+  }
+
+  CompiledFuzzyModule::DOMs doms;
+  module.InitDOMs(doms);
+
+  //infer the output at each grid point
+  m_Values.resize(NumPoints);
+
+  double vals[max_inputs];
+
+  for (int p=0; p<NumPoints; ++p)
+  {
+    for (int a=0; a<NumAxes; ++a)
+    {
+      const Axis& axis = m_Axes[a];
+
+      vals[a] = GridValue(axis, (p / axis.stride) % Resolution);
+    }
+
+    m_Values[p] = Infer(module, doms, m_Axes, vals, OutputFLV, method);
+  }
+
+  //measure the error at the centre of each cell, where it is usually
+  //greatest
+  m_dMaxError = 0.0;
+
+  int NumCells = 1;
+  for (int a=0; a<NumAxes; ++a) NumCells *= Resolution-1;
+
+  for (int c=0; c<NumCells; ++c)
+  {
+    int rest = c;
+
+    for (int a=0; a<NumAxes; ++a)
+    {
+      const Axis& axis = m_Axes[a];
+
+      int i = rest % (Resolution-1);
+      rest /= Resolution-1;
+
+      vals[a] = GridValue(axis, i + 0.5);
+    }
+
+    double error = fabs(Lookup(vals) - Infer(module, doms, m_Axes, vals, OutputFLV, method));
+
+    if (error > m_dMaxError) m_dMaxError = error;
+  }
+}
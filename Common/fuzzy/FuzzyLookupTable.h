@@ -0,0 +1,160 @@
+#ifndef FUZZY_LOOKUP_TABLE_H
+#define FUZZY_LOOKUP_TABLE_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   FuzzyLookupTable.h
+//
+//  Desc:   a fuzzy module's output baked into a table over a few of its
+//          inputs. The output is inferred at a grid of points over the
+//          inputs and values between the points are interpolated from the
+//          corners of the cell they fall in, so a lookup costs a few
+//          multiply-adds whatever the size of the rule base.
+//
+//          Each input is sampled over the part of its range where the DOMs
+//          of its sets vary (see CompiledFuzzyModule::GetActiveRange). The
+//          output is constant beyond it so values there are clamped to it
+//          without error.
+//
+//          Interpolation is exact at the grid points only. The greatest
+//          difference from exact inference found at the centres of the
+//          cells is measured when the table is baked (see GetMaxError).
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <cassert>
+
+#include "fuzzy/CompiledFuzzyModule.h"
+
+
+class FuzzyLookupTable
+{
+public:
+
+  enum {max_inputs = 4};
+
+private:
+
+  struct Axis
+  {
+    int     FLV;
+
+    double  MinVal;
+    double  MaxVal;
+
+    //the number of grid points per unit of the input
+    double  Scale;
+
+    //the distance between neighbouring grid points along this axis in
+    //m_Values
+    int     stride;
+  };
+
+  std::vector<Axis>    m_Axes;
+
+  //the output at each grid point. The first axis varies fastest
+  std::vector<double>  m_Values;
+
+  //the number of grid points along each axis
+  int                  m_iResolution;
+
+  double               m_dMaxError;
+
+  static double  GridValue(const Axis& axis, double i);
+
+  //infers the output at the given input values
+  static double  Infer(const CompiledFuzzyModule&    module,
+                       CompiledFuzzyModule::DOMs&    doms,
+                       const std::vector<Axis>&      axes,
+                       const double*                 vals,
+                       int                           OutputFLV,
+                       FuzzyModule::DefuzzifyMethod  method);
+
+public:
+
+  FuzzyLookupTable():m_iResolution(0), m_dMaxError(0.0){}
+
+  //adds an input of the module to the table. The inputs are passed to
+  //Lookup in the order they are added
+  void    AddInput(int FLV);
+
+  //infers the output variable at Resolution points along each input and
+  //measures the table's error. The module's other inputs are left at zero
+  void    Bake(const CompiledFuzzyModule&    module,
+               int                           OutputFLV,
+               int                           Resolution,
+               FuzzyModule::DefuzzifyMethod  method = FuzzyModule::max_av);
+
+  bool    isBaked()const{return !m_Values.empty();}
+
+  //returns the interpolated output at the given input values
+  inline double Lookup(const double* vals)const;
+
+  //returns the greatest difference between the table and exact inference
+  //found when it was baked
+  double  GetMaxError()const{return m_dMaxError;}
+
+  int     GetResolution()const{return m_iResolution;}
+  int     NumInputs()const{return m_Axes.size();}
+};
+
+
+//------------------------------- Lookup --------------------------------------
+//-----------------------------------------------------------------------------
+inline double FuzzyLookupTable::Lookup(const double* vals)const
+{
+  assert (isBaked() && "<FuzzyLookupTable::Lookup>: table not baked");
+
+  const int NumAxes = m_Axes.size();
+
+  //find the cell the values fall in and how far across it they lie
+  double frac[max_inputs];
+  int    cell = 0;
+
+  for (int a=0; a<NumAxes; ++a)
+  {
+    const Axis& axis = m_Axes[a];
+
+    double val = vals[a];
+
+    if (val < axis.MinVal) val = axis.MinVal;
+    if (val > axis.MaxVal) val = axis.MaxVal;
+
+    double t = (val - axis.MinVal) * axis.Scale;
+    int    i = (int)t;
+
+    if (i > m_iResolution-2) i = m_iResolution-2;
+
+    frac[a] = t - i;
+    cell   += i * axis.stride;
+  }
+
+  //blend the values at the corners of the cell
+  double result = 0.0;
+
+  for (int corner=0; corner < (1<<NumAxes); ++corner)
+  {
+    double weight = 1.0;
+    int    index  = cell;
+
+    for (int a=0; a<NumAxes; ++a)
+    {
+      if (corner & (1<<a))
+      {
+        weight *= frac[a];
+        index  += m_Axes[a].stride;
+      }
+      else
+      {
+        weight *= 1.0 - frac[a];
+      }
+    }
+
+    result += weight * m_Values[index];
+  }
+
+  return result;
+}
+
+
+
+#endif
@@ -50,6 +50,9 @@ private:
   std::vector<FuzzyRule*>   m_Rules;
  
 
+  //the compiled module reads the variables and rules directly
+  friend class CompiledFuzzyModule;
+
   //zeros the DOMs of the consequents of each rule. Used by Defuzzify()
   inline void SetConfidencesOfConsequentsToZero();
 
@@ -62,7 +65,7 @@ public:
   FuzzyVariable&  CreateFLV(const std::string& VarName);
   
   //adds a rule to the module
-  void            AddRule(FuzzyTerm& antecedent, FuzzyTerm& consequence);
+  void            AddRule(const FuzzyTerm& antecedent, const FuzzyTerm& consequence);
 
   //this method calls the Fuzzify method of the named FLV 
   inline void     Fuzzify(const std::string& NameOfFLV, double val);
@@ -37,9 +37,9 @@ public:
   FzAND(const FzAND& fa);
    
   //ctors accepting fuzzy terms.
-  FzAND(FuzzyTerm& op1, FuzzyTerm& op2);
-  FzAND(FuzzyTerm& op1, FuzzyTerm& op2, FuzzyTerm& op3);
-  FzAND(FuzzyTerm& op1, FuzzyTerm& op2, FuzzyTerm& op3, FuzzyTerm& op4);
+  FzAND(const FuzzyTerm& op1, const FuzzyTerm& op2);
+  FzAND(const FuzzyTerm& op1, const FuzzyTerm& op2, const FuzzyTerm& op3);
+  FzAND(const FuzzyTerm& op1, const FuzzyTerm& op2, const FuzzyTerm& op3, const FuzzyTerm& op4);
 
   //virtual ctor
   FuzzyTerm* Clone()const{return new FzAND(*this);}
@@ -47,6 +47,9 @@ public:
   double GetDOM()const;
   void  ClearDOM();
   void  ORwithDOM(double val);
+
+  void  CompileAntecedent(FuzzyProgram& program)const;
+  void  CompileConsequent(FuzzyProgram& program)const;
 };
 
 
@@ -73,9 +76,9 @@ public:
   FzOR(const FzOR& fa);
    
   //ctors accepting fuzzy terms.
-  FzOR(FuzzyTerm& op1, FuzzyTerm& op2);
-  FzOR(FuzzyTerm& op1, FuzzyTerm& op2, FuzzyTerm& op3);
-  FzOR(FuzzyTerm& op1, FuzzyTerm& op2, FuzzyTerm& op3, FuzzyTerm& op4);
+  FzOR(const FuzzyTerm& op1, const FuzzyTerm& op2);
+  FzOR(const FuzzyTerm& op1, const FuzzyTerm& op2, const FuzzyTerm& op3);
+  FzOR(const FuzzyTerm& op1, const FuzzyTerm& op2, const FuzzyTerm& op3, const FuzzyTerm& op4);
 
   //virtual ctor
   FuzzyTerm* Clone()const{return new FzOR(*this);}
@@ -85,6 +88,9 @@ public:
   //unused
   void ClearDOM(){assert(0 && "<FzOR::ClearDOM>: invalid context");}
   void ORwithDOM(double val){assert(0 && "<FzOR::ORwithDOM>: invalid context");}
+
+  void CompileAntecedent(FuzzyProgram& program)const;
+  void CompileConsequent(FuzzyProgram& program)const{assert(0 && "<FzOR::CompileConsequent>: invalid context");}
 };
 
 
@@ -0,0 +1,233 @@
+#ifndef FUZZY_PROGRAM_H
+#define FUZZY_PROGRAM_H
+#pragma warning (disable:4786)
+//-----------------------------------------------------------------------------
+//
+//  Name:   FuzzyProgram.h
+//
+//  Desc:   a fuzzy module's rule base compiled to a flat list of
+//          instructions (see CompiledFuzzyModule.h). The fuzzy sets are
+//          numbered and their DOMs held in an array, so the rules are run
+//          without any virtual calls or allocation.
+//
+//          Each rule is a short stack program. The antecedent's terms push
+//          their DOMs and the operators replace the DOMs of their terms with
+//          the smallest (AND) or largest (OR) of them. The consequent's sets
+//          are then ORed with the DOM left on the stack, and it is popped.
+//
+//          The FuzzyTerms add their own instructions (see
+//          FuzzyTerm::CompileAntecedent and CompileConsequent).
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cassert>
+#include <math.h>
+
+#include "fuzzy/FuzzySet.h"
+#include "misc/utils.h"
+
+
+class FuzzyProgram
+{
+public:
+
+  //the hedges that may be applied to a set
+  enum hedge_type{no_hedge, very, fairly};
+
+  //the deepest the stack may grow, for antecedents nested this far
+  enum {max_stack_depth = 16};
+
+private:
+
+  enum op_type
+  {
+    push_dom,      //push the DOM of set arg (hedged)
+    and_terms,     //replace the top arg DOMs with their minimum
+    or_terms,      //replace the top arg DOMs with their maximum
+    or_with_dom,   //OR set arg with the DOM on top of the stack (hedged)
+    end_rule       //pop the antecedent's DOM
+  };
+
+  struct Instruction
+  {
+    unsigned char  op;
+    unsigned char  hedge;
+    int            arg;
+
+    Instruction(op_type o, int a, hedge_type h = no_hedge):op((unsigned char)o),
+                                                          hedge((unsigned char)h),
+                                                          arg(a)
+    {}
+  };
+
+  std::vector<Instruction>        m_Instructions;
+
+  //the sets appearing in the consequents. Their DOMs are zeroed before the
+  //rules are run
+  std::vector<int>                m_Consequents;
+
+  //the number of each set. Only used while the program is compiled
+  std::map<const FuzzySet*, int>  m_SetIndices;
+
+  //the depth of the stack after the instructions added so far
+  int                             m_iDepth;
+
+  int                             GetIndex(const FuzzySet& set)const
+  {
+    std::map<const FuzzySet*, int>::const_iterator it = m_SetIndices.find(&set);
+
+    assert (it != m_SetIndices.end() && "<FuzzyProgram::GetIndex>: set not in module");
+
+    return it->second;
+  }
+
+public:
+
+  FuzzyProgram():m_iDepth(0){}
+
+  //numbers a set. The sets must all be numbered before any instructions
+  //are added
+  void SetIndex(const FuzzySet& set, int index){m_SetIndices[&set] = index;}
+
+  //called by the FuzzyTerms to add their instructions
+  void PushDOM(const FuzzySet& set, hedge_type hedge = no_hedge)
+  {
+    m_Instructions.push_back(Instruction(push_dom, GetIndex(set), hedge));
+
+    ++m_iDepth;
+
+    assert (m_iDepth <= max_stack_depth && "<FuzzyProgram::PushDOM>: antecedent too deep");
+  }
+
+  void AND(int NumTerms)
+  {
+    m_Instructions.push_back(Instruction(and_terms, NumTerms));
+
+    m_iDepth -= NumTerms - 1;
+  }
+
+  void OR(int NumTerms)
+  {
+    m_Instructions.push_back(Instruction(or_terms, NumTerms));
+
+    m_iDepth -= NumTerms - 1;
+  }
+
+  void ORwithDOM(const FuzzySet& set, hedge_type hedge = no_hedge)
+  {
+    m_Instructions.push_back(Instruction(or_with_dom, GetIndex(set), hedge));
+
+    if (std::find(m_Consequents.begin(), m_Consequents.end(), GetIndex(set)) == m_Consequents.end())
+    {
+      m_Consequents.push_back(GetIndex(set));
+    }
+  }
+
+  //called by the module after each rule's consequent
+  void EndRule()
+  {
+    assert (m_iDepth == 1 && "<FuzzyProgram::EndRule>: invalid antecedent");
+
+    m_Instructions.push_back(Instruction(end_rule, 0));
+
+    m_iDepth = 0;
+  }
+
+  //called once the program is complete
+  void Finish(){m_SetIndices.clear();}
+
+  //zeros the DOMs of the consequents' sets
+  void ClearConsequents(double* DOMs)const
+  {
+    for (unsigned int c=0; c<m_Consequents.size(); ++c) DOMs[m_Consequents[c]] = 0.0;
+  }
+
+  //runs the rules, updating the DOMs of the consequents' sets
+  inline void Run(double* DOMs)const;
+};
+
+
+//--------------------------------- Run ---------------------------------------
+//
+//  the operators and hedges calculate exactly as FzAND, FzOR, FzVery and
+//  FzFairly do, so the results are identical to those of the FuzzyModule
+//-----------------------------------------------------------------------------
+inline void FuzzyProgram::Run(double* DOMs)const
+{
+  double stack[max_stack_depth];
+  int    top = -1;
+
+  std::vector<Instruction>::const_iterator it = m_Instructions.begin();
+  for (it; it != m_Instructions.end(); ++it)
+  {
+    switch (it->op)
+    {
+    case push_dom:
+      {
+        double dom = DOMs[it->arg];
+
+        if      (it->hedge == very)   dom = dom * dom;
+        else if (it->hedge == fairly) dom = sqrt(dom);
+
+        stack[++top] = dom;
+      }
+
+      break;
+
+    case and_terms:
+      {
+        double smallest = MaxDouble;
+
+        for (int t=top-it->arg+1; t<=top; ++t)
+        {
+          if (stack[t] < smallest) smallest = stack[t];
+        }
+
+        top -= it->arg - 1;
+
+        stack[top] = smallest;
+      }
+
+      break;
+
+    case or_terms:
+      {
+        double largest = MinFloat;
+
+        for (int t=top-it->arg+1; t<=top; ++t)
+        {
+          if (stack[t] > largest) largest = stack[t];
+        }
+
+        top -= it->arg - 1;
+
+        stack[top] = largest;
+      }
+
+      break;
+
+    case or_with_dom:
+      {
+        double val = stack[top];
+
+        if      (it->hedge == very)   val = val * val;
+        else if (it->hedge == fairly) val = sqrt(val);
+
+        if (val > DOMs[it->arg]) DOMs[it->arg] = val;
+      }
+
+      break;
+
+    case end_rule:
+
+      --top;
+
+      break;
+    }
+  }
+}
+
+
+
+#endif
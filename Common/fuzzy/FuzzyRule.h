@@ -13,7 +13,7 @@
 //          
 //-----------------------------------------------------------------------------
 #include <vector>
-#include "Fuzzy/FuzzySet.h"
+#include "fuzzy/FuzzySet.h"
 #include "fuzzy/FuzzyOperators.h"
 #include "misc/utils.h"
 
@@ -28,6 +28,9 @@ private:
   //consequence (usually a single fuzzy set, but can be several ANDed together)
   FuzzyTerm*        m_pConsequence;
 
+  //the compiled module compiles the terms directly
+  friend class CompiledFuzzyModule;
+
   //it doesn't make sense to allow clients to copy rules
   FuzzyRule(const FuzzyRule&);
   FuzzyRule& operator=(const FuzzyRule&);
@@ -14,6 +14,12 @@
 
 class FuzzySet
 {
+public:
+
+  //the shapes of set. Used when a module is compiled (see
+  //CompiledFuzzyModule.h)
+  enum shape_type{triangle, left_shoulder, right_shoulder, singleton};
+
 protected:
   
   //this will hold the degree of membership of a given value in this set 
@@ -36,6 +42,10 @@ public:
   //to determine the DOMs of the values it uses as its sample points.
   virtual double      CalculateDOM(double val)const = 0;
 
+  //returns the shape of the set's membership function and the values that
+  //define it
+  virtual shape_type  GetShape(double& peak, double& LeftOffset, double& RightOffset)const = 0;
+
   //if this fuzzy set is part of a consequent FLV, and it is fired by a rule 
   //then this method sets the DOM (in this context, the DOM represents a
   //confidence level)to the maximum of the parameter value or the set's 
@@ -36,6 +36,13 @@ public:
 
   //this method calculates the degree of membership for a particular value
   double CalculateDOM(double val)const;
+
+  shape_type GetShape(double& peak, double& LeftOffset, double& RightOffset)const
+  {
+    peak = m_dPeakPoint; LeftOffset = m_dLeftOffset; RightOffset = m_dRightOffset;
+
+    return triangle;
+  }
 };
 
 
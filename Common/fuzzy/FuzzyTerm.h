@@ -10,6 +10,9 @@
 //          used as terms in a fuzzy if-then rule base.
 //-----------------------------------------------------------------------------
 
+class FuzzyProgram;
+
+
 class FuzzyTerm
 {  
 public:
@@ -28,6 +31,11 @@ public:
   //method for updating the DOM of a consequent when a rule fires
   virtual void       ORwithDOM(double val)=0;
 
+  //add the instructions that do the same as GetDOM and ORwithDOM to a
+  //compiled rule base (see FuzzyProgram.h)
+  virtual void       CompileAntecedent(FuzzyProgram& program)const=0;
+  virtual void       CompileConsequent(FuzzyProgram& program)const=0;
+
    
 };
 
@@ -55,6 +55,9 @@ private:
 
   friend class FuzzyModule;
 
+  //the compiled module reads the sets and range directly
+  friend class CompiledFuzzyModule;
+
 
 public:
 
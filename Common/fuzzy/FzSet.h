@@ -11,6 +11,7 @@
 //-----------------------------------------------------------------------------
 #include "FuzzyTerm.h"
 #include "FuzzySet.h"
+#include "FuzzyProgram.h"
 
 class FzAND;
 
@@ -35,6 +36,9 @@ public:
   double     GetDOM()const {return m_Set.GetDOM();}
   void       ClearDOM(){m_Set.ClearDOM();}
   void       ORwithDOM(double val){m_Set.ORwithDOM(val);}
+
+  void       CompileAntecedent(FuzzyProgram& program)const{program.PushDOM(m_Set);}
+  void       CompileConsequent(FuzzyProgram& program)const{program.ORwithDOM(m_Set);}
 };
 
 
@@ -15,15 +15,23 @@
 //          between cells, the Update method should be called each update-cycle
 //          to sychronize the entity and the cell space it occupies
 //
+//          The Query methods are an alternative to CalculateNeighbors that
+//          write their results into a vector supplied by the caller. They
+//          may therefore be nested or called while iterating through the
+//          results of another query. Only the cells overlapping the query
+//          region are examined.
+//
 //-----------------------------------------------------------------------------
 #pragma warning (disable:4786)
 
 #include <vector>
 #include <list>
+#include <algorithm>
 #include <cassert>
 
-#include "2d/Vector2D.h"
-#include "2d/InvertedAABBox2D.h"
+#include "2D/Vector2D.h"
+#include "2D/InvertedAABBox2D.h"
+#include "2D/geometry.h"
 #include "misc/utils.h"
 
 
@@ -78,11 +86,26 @@ private:
   double  m_dCellSizeX;
   double  m_dCellSizeY;
 
+  //the largest bounding radius of any entity added to the space. Queries
+  //are widened by this amount so that entities overlapping the query region
+  //from a neighboring cell are found
+  double  m_dMaxEntityRadius;
+
 
   //given a position in the game space this method determines the           
   //relevant cell's index
   inline int  PositionToIndex(const Vector2D& pos)const;
 
+  //given a rectangle in the game space this method determines the range of
+  //cells (inclusive) it overlaps
+  inline void CellRange(Vector2D TopLeft, Vector2D BottomRight,
+                        int& x0, int& y0, int& x1, int& y1)const;
+
+  //returns true if the line segment AB passes through the box described
+  //by TopLeft and BottomRight
+  static inline bool SegmentOverlapsBox(Vector2D A, Vector2D B,
+                                        Vector2D TopLeft, Vector2D BottomRight);
+
 public:
 
   CellSpacePartition(double width,        //width of the environment
@@ -97,6 +120,10 @@ public:
   //update an entity's cell by calling this from your entity's Update method 
   inline void UpdateEntity(const entity& ent, Vector2D OldPos);
 
+  //removes an entity from the space. The entity must be at the position it
+  //was at when it was last added or updated
+  inline void RemoveEntity(const entity& ent);
+
   //this method calculates all a target's neighbors and stores them in
   //the neighbor vector. After you have called this method use the begin, 
   //next and end methods to iterate through the vector.
@@ -114,6 +141,33 @@ public:
   //empties the cells of entities
   void        EmptyCells();
 
+  //fills Result with every entity whose bounding circle overlaps the circle
+  //of the given radius centered on pos. (a radius of zero finds the
+  //entities whose bounding circle contains pos)
+  inline void QueryRadius(Vector2D                pos,
+                          double                  radius,
+                          std::vector<entity>&    Result)const;
+
+  //fills Result with every entity whose bounding box overlaps the given
+  //rectangle. (callers are expected to make their own exact test)
+  inline void QueryBox(Vector2D                   TopLeft,
+                       Vector2D                   BottomRight,
+                       std::vector<entity>&       Result)const;
+
+  //fills Result with every entity whose bounding circle the line segment
+  //AB passes through
+  inline void QuerySegment(Vector2D               A,
+                           Vector2D               B,
+                           std::vector<entity>&   Result)const;
+
+  //fills Result with every entity whose position is within the field of
+  //view (in radians) of an observer at pos facing in the direction facing.
+  //The view is not limited in range.
+  inline void QueryCone(Vector2D                  pos,
+                        Vector2D                  facing,
+                        double                    fov,
+                        std::vector<entity>&      Result)const;
+
   //call this to use the gdi to render the cell edges
   inline void RenderCells()const;
 };
@@ -132,6 +186,7 @@ CellSpacePartition<entity>::CellSpacePartition(double  width,        //width of
                   m_dSpaceHeight(height),
                   m_iNumCellsX(cellsX),
                   m_iNumCellsY(cellsY),
+                  m_dMaxEntityRadius(0.0),
                   m_Neighbors(MaxEntitys, entity())
 {
   //calculate bounds of each cell
@@ -167,27 +222,27 @@ void CellSpacePartition<entity>::CalculateNeighbors(Vector2D TargetPos,
                                                     double   QueryRadius)
 {
   //create an iterator and set it to the beginning of the neighbor vector
-  std::vector<entity>::iterator curNbor = m_Neighbors.begin();
+  typename std::vector<entity>::iterator curNbor = m_Neighbors.begin();
   
   //create the query box that is the bounding box of the target's query
   //area
   InvertedAABBox2D QueryBox(TargetPos - Vector2D(QueryRadius, QueryRadius),
                             TargetPos + Vector2D(QueryRadius, QueryRadius));
 
-  //iterate through each cell and test to see if its bounding box overlaps
-  //with the query box. If it does and it also contains entities then
-  //make further proximity tests.
-  std::vector<Cell<entity> >::iterator curCell; 
-  for (curCell=m_Cells.begin(); curCell!=m_Cells.end(); ++curCell)
+  //iterate through each cell the query box overlaps. If it contains
+  //entities then make further proximity tests.
+  int x0, y0, x1, y1;
+  CellRange(QueryBox.TopLeft(), QueryBox.BottomRight(), x0, y0, x1, y1);
+
+  for (int y=y0; y<=y1; ++y)
   {
-    //test to see if this cell contains members and if it overlaps the
-    //query box
-    if (curCell->BBox.isOverlappedWith(QueryBox) &&
-       !curCell->Members.empty())
+    for (int x=x0; x<=x1; ++x)
     {
+      Cell<entity>& curCell = m_Cells[y*m_iNumCellsX + x];
+
       //add any entities found within query radius to the neighbor list
-      std::list<entity>::iterator it = curCell->Members.begin();
-      for (it; it!=curCell->Members.end(); ++it)
+      typename std::list<entity>::iterator it = curCell.Members.begin();
+      for (it; it!=curCell.Members.end(); ++it)
       {     
         if (Vec2DDistanceSq((*it)->Pos(), TargetPos) <
             QueryRadius*QueryRadius)
@@ -210,7 +265,7 @@ void CellSpacePartition<entity>::CalculateNeighbors(Vector2D TargetPos,
 template<class entity>
 void CellSpacePartition<entity>::EmptyCells()
 {
-  std::vector<Cell<entity> >::iterator it = m_Cells.begin();
+  typename std::vector<Cell<entity> >::iterator it = m_Cells.begin();
 
   for (it; it!=m_Cells.end(); ++it)
   {
@@ -226,14 +281,35 @@ void CellSpacePartition<entity>::EmptyCells()
 template<class entity>
 inline int CellSpacePartition<entity>::PositionToIndex(const Vector2D& pos)const
 {
-  int idx = (int)(m_iNumCellsX * pos.x / m_dSpaceWidth) + 
-            ((int)((m_iNumCellsY) * pos.y / m_dSpaceHeight) * m_iNumCellsX);
+  int x0, y0, x1, y1;
+  CellRange(pos, pos, x0, y0, x1, y1);
 
-  //if the entity's position is equal to vector2d(m_dSpaceWidth, m_dSpaceHeight)
-  //then the index will overshoot. We need to check for this and adjust
-  if (idx > (int)m_Cells.size()-1) idx = (int)m_Cells.size()-1;
+  return y0*m_iNumCellsX + x0;
+}
 
-  return idx;
+//------------------------- CellRange ------------------------------------
+//
+//  calculates the range of cells overlapped by the given rectangle. Any
+//  part of the rectangle lying outside the space is clamped to the cells
+//  on its border (so an entity that strays off the edge of the space
+//  is kept in the nearest cell)
+//------------------------------------------------------------------------
+template<class entity>
+inline void CellSpacePartition<entity>::CellRange(Vector2D TopLeft,
+                                                  Vector2D BottomRight,
+                                                  int& x0, int& y0,
+                                                  int& x1, int& y1)const
+{
+  x0 = (int)(TopLeft.x     / m_dCellSizeX);
+  y0 = (int)(TopLeft.y     / m_dCellSizeY);
+  x1 = (int)(BottomRight.x / m_dCellSizeX);
+  y1 = (int)(BottomRight.y / m_dCellSizeY);
+
+  //positions equal to (m_dSpaceWidth, m_dSpaceHeight) would overshoot
+  if (x0 < 0) x0 = 0; if (x0 > m_iNumCellsX-1) x0 = m_iNumCellsX-1;
+  if (x1 < 0) x1 = 0; if (x1 > m_iNumCellsX-1) x1 = m_iNumCellsX-1;
+  if (y0 < 0) y0 = 0; if (y0 > m_iNumCellsY-1) y0 = m_iNumCellsY-1;
+  if (y1 < 0) y1 = 0; if (y1 > m_iNumCellsY-1) y1 = m_iNumCellsY-1;
 }
 
 //----------------------- AddEntity --------------------------------------
@@ -249,6 +325,8 @@ inline void CellSpacePartition<entity>::AddEntity(const entity& ent)
   int idx = PositionToIndex(ent->Pos());
   
   m_Cells[idx].Members.push_back(ent);
+
+  m_dMaxEntityRadius = MaxOf(m_dMaxEntityRadius, ent->BRadius());
 }
 
 //----------------------- UpdateEntity -----------------------------------
@@ -273,12 +351,238 @@ inline void CellSpacePartition<entity>::UpdateEntity(const entity&  ent,
   m_Cells[NewIdx].Members.push_back(ent);
 }
 
+//----------------------- RemoveEntity -----------------------------------
+//------------------------------------------------------------------------
+template<class entity>
+inline void CellSpacePartition<entity>::RemoveEntity(const entity& ent)
+{
+  m_Cells[PositionToIndex(ent->Pos())].Members.remove(ent);
+}
+
+//------------------------ QueryRadius -----------------------------------
+//------------------------------------------------------------------------
+template<class entity>
+inline void CellSpacePartition<entity>::QueryRadius(Vector2D             pos,
+                                                    double               radius,
+                                                    std::vector<entity>& Result)const
+{
+  Result.clear();
+
+  double reach = radius + m_dMaxEntityRadius;
+
+  int x0, y0, x1, y1;
+  CellRange(pos - Vector2D(reach, reach), pos + Vector2D(reach, reach),
+            x0, y0, x1, y1);
+
+  for (int y=y0; y<=y1; ++y)
+  {
+    for (int x=x0; x<=x1; ++x)
+    {
+      const Cell<entity>& curCell = m_Cells[y*m_iNumCellsX + x];
+
+      typename std::list<entity>::const_iterator it = curCell.Members.begin();
+      for (it; it!=curCell.Members.end(); ++it)
+      {
+        double range = radius + (*it)->BRadius();
+
+        if (Vec2DDistanceSq((*it)->Pos(), pos) < range*range)
+        {
+          Result.push_back(*it);
+        }
+      }
+    }
+  }
+}
+
+//-------------------------- QueryBox ------------------------------------
+//------------------------------------------------------------------------
+template<class entity>
+inline void CellSpacePartition<entity>::QueryBox(Vector2D             TopLeft,
+                                                 Vector2D             BottomRight,
+                                                 std::vector<entity>& Result)const
+{
+  Result.clear();
+
+  Vector2D pad(m_dMaxEntityRadius, m_dMaxEntityRadius);
+
+  int x0, y0, x1, y1;
+  CellRange(TopLeft - pad, BottomRight + pad, x0, y0, x1, y1);
+
+  InvertedAABBox2D QueryBox(TopLeft, BottomRight);
+
+  for (int y=y0; y<=y1; ++y)
+  {
+    for (int x=x0; x<=x1; ++x)
+    {
+      const Cell<entity>& curCell = m_Cells[y*m_iNumCellsX + x];
+
+      typename std::list<entity>::const_iterator it = curCell.Members.begin();
+      for (it; it!=curCell.Members.end(); ++it)
+      {
+        Vector2D r((*it)->BRadius(), (*it)->BRadius());
+
+        if (QueryBox.isOverlappedWith(InvertedAABBox2D((*it)->Pos() - r,
+                                                       (*it)->Pos() + r)))
+        {
+          Result.push_back(*it);
+        }
+      }
+    }
+  }
+}
+
+//------------------------- QuerySegment ---------------------------------
+//
+//  only the cells within m_dMaxEntityRadius of the segment are examined
+//------------------------------------------------------------------------
+template<class entity>
+inline void CellSpacePartition<entity>::QuerySegment(Vector2D             A,
+                                                     Vector2D             B,
+                                                     std::vector<entity>& Result)const
+{
+  Result.clear();
+
+  Vector2D pad(m_dMaxEntityRadius, m_dMaxEntityRadius);
+
+  int x0, y0, x1, y1;
+  CellRange(Vector2D(MinOf(A.x, B.x), MinOf(A.y, B.y)) - pad,
+            Vector2D(MaxOf(A.x, B.x), MaxOf(A.y, B.y)) + pad,
+            x0, y0, x1, y1);
+
+  for (int y=y0; y<=y1; ++y)
+  {
+    for (int x=x0; x<=x1; ++x)
+    {
+      const Cell<entity>& curCell = m_Cells[y*m_iNumCellsX + x];
+
+      if (curCell.Members.empty() ||
+          !SegmentOverlapsBox(A, B, curCell.BBox.TopLeft() - pad,
+                                    curCell.BBox.BottomRight() + pad))
+      {
+        continue;
+      }
+
+      typename std::list<entity>::const_iterator it = curCell.Members.begin();
+      for (it; it!=curCell.Members.end(); ++it)
+      {
+        if (DistToLineSegment(A, B, (*it)->Pos()) < (*it)->BRadius())
+        {
+          Result.push_back(*it);
+        }
+      }
+    }
+  }
+}
+
+//-------------------------- QueryCone -----------------------------------
+//
+//  when the field of view is no wider than 180 degrees the view cone is
+//  the intersection of two half planes, one bounded by each edge of the
+//  cone. Any cell lying entirely outside either half plane is skipped.
+//------------------------------------------------------------------------
+template<class entity>
+inline void CellSpacePartition<entity>::QueryCone(Vector2D             pos,
+                                                  Vector2D             facing,
+                                                  double               fov,
+                                                  std::vector<entity>& Result)const
+{
+  Result.clear();
+
+  bool     bCull = fov <= Pi;
+  Vector2D LeftNormal, RightNormal;
+
+  if (bCull)
+  {
+    //the inward pointing normals of the cone's edges
+    double HalfFOV = fov/2.0;
+
+    LeftNormal  = facing*sin(HalfFOV) - facing.Perp()*cos(HalfFOV);
+    RightNormal = facing*sin(HalfFOV) + facing.Perp()*cos(HalfFOV);
+  }
+
+  typename std::vector<Cell<entity> >::const_iterator curCell;
+  for (curCell=m_Cells.begin(); curCell!=m_Cells.end(); ++curCell)
+  {
+    if (curCell->Members.empty()) continue;
+
+    if (bCull)
+    {
+      const InvertedAABBox2D& box = curCell->BBox;
+
+      const Vector2D corners[4] = {box.TopLeft()     - pos,
+                                   box.BottomRight() - pos,
+                                   Vector2D(box.Left(),  box.Bottom()) - pos,
+                                   Vector2D(box.Right(), box.Top())    - pos};
+
+      bool bOutsideLeft = true, bOutsideRight = true;
+
+      for (int c=0; c<4; ++c)
+      {
+        if (corners[c].Dot(LeftNormal)  >= 0) bOutsideLeft  = false;
+        if (corners[c].Dot(RightNormal) >= 0) bOutsideRight = false;
+      }
+
+      if (bOutsideLeft || bOutsideRight) continue;
+    }
+
+    typename std::list<entity>::const_iterator it = curCell->Members.begin();
+    for (it; it!=curCell->Members.end(); ++it)
+    {
+      if (isSecondInFOVOfFirst(pos, facing, (*it)->Pos(), fov))
+      {
+        Result.push_back(*it);
+      }
+    }
+  }
+}
+
+//---------------------- SegmentOverlapsBox ------------------------------
+//
+//  clips the segment against each pair of box edges in turn (slab test)
+//------------------------------------------------------------------------
+template<class entity>
+inline bool CellSpacePartition<entity>::SegmentOverlapsBox(Vector2D A,
+                                                           Vector2D B,
+                                                           Vector2D TopLeft,
+                                                           Vector2D BottomRight)
+{
+  double tmin = 0.0;
+  double tmax = 1.0;
+
+  const double start[2] = {A.x, A.y};
+  const double delta[2] = {B.x - A.x, B.y - A.y};
+  const double lo[2]    = {TopLeft.x, TopLeft.y};
+  const double hi[2]    = {BottomRight.x, BottomRight.y};
+
+  for (int axis=0; axis<2; ++axis)
+  {
+    if (isEqual(delta[axis], 0.0))
+    {
+      if (start[axis] < lo[axis] || start[axis] > hi[axis]) return false;
+
+      continue;
+    }
+
+    double t1 = (lo[axis] - start[axis]) / delta[axis];
+    double t2 = (hi[axis] - start[axis]) / delta[axis];
+
+    if (t1 > t2) std::swap(t1, t2);
+
+    if (t1 > tmin) tmin = t1;
+    if (t2 < tmax) tmax = t2;
+
+    if (tmin > tmax) return false;
+  }
+
+  return true;
+}
+
 //-------------------------- RenderCells -----------------------------------
 //--------------------------------------------------------------------------
 template<class entity>
 inline void CellSpacePartition<entity>::RenderCells()const
 {
-  std::vector<Cell<entity> >::const_iterator curCell;
+  typename std::vector<Cell<entity> >::const_iterator curCell;
   for (curCell=m_Cells.begin(); curCell!=m_Cells.end(); ++curCell)
   {
     curCell->BBox.Render(false);
@@ -13,7 +13,7 @@
 //  Author: Mat Buckland 2001 (fup@ai-junkie.com)
 //
 //------------------------------------------------------------------------
-#include <windows.h>
+#include "misc/Win32Compat.h"
 #include <string>
 #include <vector>
 #include <cassert>
@@ -1,9 +1,8 @@
-#include "framecounter.h"
+#include "FrameCounter.h"
+#include "Game/WorldContext.h"
 
 
 FrameCounter* FrameCounter::Instance()
 {
-  static FrameCounter instance;
-
-  return &instance;
+  return WorldContext::Current()->GetTickCounter();
 }
\ No newline at end of file
@@ -12,6 +12,8 @@ private:
 
   int  m_iFramesElapsed;
 
+  friend class WorldContext;
+
   FrameCounter():m_lCount(0), m_iFramesElapsed(0){}
 
   //copy ctor and assignment should be private
@@ -20,6 +22,7 @@ private:
 
 public:
 
+  //returns the frame counter of the current world context
   static FrameCounter* Instance();
 
   void Update(){++m_lCount; ++m_iFramesElapsed;}
@@ -361,6 +361,16 @@ public:
 
   bool empty()const{return (m_iSize==0);}
 
+  int  size()const{return m_iSize;}
+
+  //returns the index of the min item without removing it. The queue must
+  //not be empty
+  int  Peek()const{assert (m_iSize > 0); return m_Heap[1];}
+
+  //empties the queue. The heap arrays are left as they are; only the
+  //elements that are subsequently inserted are ever read.
+  void clear(){m_iSize = 0;}
+
   //to insert an item into the queue it gets added to the end of the heap
   //and then the heap is reordered from the bottom up.
   void insert(const int idx)
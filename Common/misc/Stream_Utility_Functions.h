@@ -11,6 +11,8 @@
 #include <sstream>
 #include <string>
 #include <iomanip>
+#include <fstream>
+#include <stdexcept>
 
 
 //------------------------------ ttos -----------------------------------------
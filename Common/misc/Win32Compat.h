@@ -0,0 +1,116 @@
+#ifndef WIN32_COMPAT_H
+#define WIN32_COMPAT_H
+//------------------------------------------------------------------------
+//
+//  Name:   Win32Compat.h
+//
+//  Desc:   include this in place of <windows.h> in code that is also built
+//          off Windows (the windowless runner, see RavenHeadless in
+//          CMakeLists.txt). On Windows it is just <windows.h>. Elsewhere it
+//          declares the handful of Win32 types and calls such code makes:
+//          the GDI calls are no-ops, since there is nothing to draw on,
+//          and the timer calls are made with std::chrono.
+//
+//------------------------------------------------------------------------
+#ifdef _WIN32
+
+#include <windows.h>
+
+#else
+
+#include <chrono>
+#include <cstddef>
+
+
+typedef int            BOOL;
+typedef unsigned char  BYTE;
+typedef unsigned short WORD;
+typedef unsigned int   DWORD;
+typedef unsigned int   UINT;
+typedef long long      LONGLONG;
+typedef DWORD          COLORREF;
+
+typedef void*          HANDLE;
+typedef HANDLE         HWND;
+typedef HANDLE         HDC;
+typedef HANDLE         HGDIOBJ;
+typedef HANDLE         HPEN;
+typedef HANDLE         HBRUSH;
+
+union LARGE_INTEGER
+{
+  LONGLONG QuadPart;
+};
+
+struct POINT
+{
+  long x;
+  long y;
+};
+
+struct POINTS
+{
+  short x;
+  short y;
+};
+
+struct RECT
+{
+  long left;
+  long top;
+  long right;
+  long bottom;
+};
+
+#ifndef TRUE
+#define TRUE  1
+#define FALSE 0
+#endif
+
+#define RGB(r,g,b) ((COLORREF)(((BYTE)(r)|((WORD)((BYTE)(g))<<8))|(((DWORD)(BYTE)(b))<<16)))
+
+enum {PS_SOLID, TRANSPARENT, OPAQUE, WINDING, BLACK_BRUSH, WHITE_BRUSH, HOLLOW_BRUSH};
+
+
+//------------------------------- timers
+inline BOOL QueryPerformanceFrequency(LARGE_INTEGER* freq)
+{
+  freq->QuadPart = std::chrono::steady_clock::period::den /
+                   std::chrono::steady_clock::period::num;
+  return TRUE;
+}
+
+inline BOOL QueryPerformanceCounter(LARGE_INTEGER* count)
+{
+  count->QuadPart = std::chrono::steady_clock::now().time_since_epoch().count();
+  return TRUE;
+}
+
+inline DWORD timeGetTime()
+{
+  return (DWORD)std::chrono::duration_cast<std::chrono::milliseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+//------------------------------- GDI (no-ops)
+inline HPEN    CreatePen(int, int, COLORREF){return NULL;}
+inline HBRUSH  CreateSolidBrush(COLORREF){return NULL;}
+inline HGDIOBJ GetStockObject(int){return NULL;}
+inline HGDIOBJ SelectObject(HDC, HGDIOBJ){return NULL;}
+inline BOOL    DeleteObject(HGDIOBJ){return TRUE;}
+
+inline BOOL     TextOut(HDC, int, int, const char*, int){return TRUE;}
+inline int      SetBkMode(HDC, int){return 0;}
+inline COLORREF SetTextColor(HDC, COLORREF){return 0;}
+inline COLORREF SetPixel(HDC, int, int, COLORREF){return 0;}
+inline BOOL     MoveToEx(HDC, int, int, POINT*){return TRUE;}
+inline BOOL     LineTo(HDC, int, int){return TRUE;}
+inline int      SetPolyFillMode(HDC, int){return 0;}
+inline BOOL     Polygon(HDC, const POINT*, int){return TRUE;}
+inline BOOL     Rectangle(HDC, int, int, int, int){return TRUE;}
+inline BOOL     Ellipse(HDC, int, int, int, int){return TRUE;}
+
+#endif
+
+#endif
@@ -1,6 +1,6 @@
 #include "misc/WindowUtils.h"
-#include <windows.h>
-#include "2d/Vector2D.h"
+#include <iostream>
+#include "2D/Vector2D.h"
 #include "misc/utils.h"
 #include "misc/Stream_Utility_Functions.h"
 
@@ -11,6 +11,7 @@
 //  Changes the state of a menu item given the item identifier, the 
 //  desired state and the HWND of the menu owner
 //------------------------------------------------------------------------
+#ifdef _WIN32
 void ChangeMenuState(HWND hwnd, UINT MenuItem, UINT state)
 {
   MENUITEMINFO mi;
@@ -40,6 +41,8 @@ void CheckMenuItemAppropriately(HWND hwnd, UINT MenuItem, bool b)
 }
 
 
+#endif
+
 //--------------------- CheckBufferLength --------------------------------
 //
 //  this is a replacement for the StringCchLength function found in the 
@@ -62,17 +65,28 @@ bool CheckBufferLength(char* buff, int MaxLength, int& BufferLength)
 
 void ErrorBox(std::string& msg)
 {
+#ifdef _WIN32
   MessageBox(NULL, msg.c_str(), "Error", MB_OK);
+#else
+  std::cerr << "Error: " << msg << std::endl;
+#endif
 }
 
 void ErrorBox(char* msg)
 {
+#ifdef _WIN32
   MessageBox(NULL, msg, "Error", MB_OK);
+#else
+  std::cerr << "Error: " << msg << std::endl;
+#endif
 }
 
 //gets the coordinates of the cursor relative to an active window 
 Vector2D GetClientCursorPosition()
 {
+#ifndef _WIN32
+  return Vector2D();
+#else
   POINT MousePos;
 
   GetCursorPos(&MousePos);
@@ -80,9 +94,10 @@ Vector2D GetClientCursorPosition()
   ScreenToClient(GetActiveWindow(), &MousePos);
 
   return POINTtoVector(MousePos);
+#endif
 }
 
- 
+#ifdef _WIN32
 Vector2D GetClientCursorPosition(HWND hwnd)
 {
   POINT MousePos;
@@ -232,4 +247,5 @@ int  GetWindowWidth(HWND hwnd)
   GetWindowRect(hwnd, &windowRect);
 
   return windowRect.right - windowRect.left;
-}
\ No newline at end of file
+}
+#endif //_WIN32
@@ -2,11 +2,13 @@
 #define WINDOW_UTILS_H
 #pragma warning (disable:4786)
 
-#include <windows.h>
 #include <string>
 
 struct Vector2D;
 
+#ifdef _WIN32
+#include <windows.h>
+
 //macro to detect keypresses
 #define KEYDOWN(vk_code) ((GetAsyncKeyState(vk_code) & 0x8000) ? 1 : 0)
 
@@ -35,6 +37,16 @@ void ChangeMenuState(HWND hwnd, UINT MenuItem, UINT state);
 //if b is true MenuItem is checked, otherwise it is unchecked
 void CheckMenuItemAppropriately(HWND hwnd, UINT MenuItem, bool b);
 
+#else
+
+//there is no keyboard to read off Windows
+#define KEYDOWN(vk_code) 0
+
+#define WAS_KEY_PRESSED(vk_code) false
+#define IS_KEY_PRESSED(vk_code) false
+
+#endif
+
 
 //this is a replacement for the StringCchLength function found in the 
 //platform SDK. See MSDN for details. Only ever used for checking toolbar
@@ -44,9 +56,12 @@ bool CheckBufferLength(char* buff, int MaxLength, unsigned int& BufferLength);
 void ErrorBox(std::string& msg);
 void ErrorBox(char* msg);
 
-//gets the coordinates of the cursor relative to an active window 
+//gets the coordinates of the cursor relative to an active window. Off
+//Windows there is neither, and this returns the origin
 Vector2D GetClientCursorPosition();
 
+#ifdef _WIN32
+
 //gets the coordinates of the cursor relative to an active window 
 Vector2D GetClientCursorPosition(HWND hwnd);
 
@@ -75,6 +90,7 @@ void ResizeWindow(HWND hwnd, int cx, int cy);
 
 int  GetWindowHeight(HWND hwnd);
 int  GetWindowWidth(HWND hwnd);
+#endif
 
 
 
@@ -19,7 +19,7 @@ extern "C"
 #pragma comment(lib, "lua5.1.lib")
 //#pragma comment(lib, "lualib.lib")
 
-#include "LuaHelperFunctions.h"
+#include "luahelperfunctions.h"
 
 
 